@@ -56,6 +56,72 @@ g_max_try = 99999.9
 hosts_path_g = ""
 hosts_map_g = dict()
 
+class Histogram(object):
+    """
+    Merged buckets of rrr::Histogram (src/rrr/misc/stat.hpp), reported by
+    the clients as HistogramRes.
+    """
+    SUB_BITS = 7
+
+    def __init__(self):
+        self.counts = []
+        self.max = 0
+
+    def add(self, res):
+        if len(self.counts) < len(res.counts):
+            self.counts.extend([0] * (len(res.counts) - len(self.counts)))
+        for i, c in enumerate(res.counts):
+            self.counts[i] += c
+        self.max = max(self.max, res.max)
+
+    def record(self, value, n):
+        """ count value n times """
+        i = Histogram.bucket(value)
+        if len(self.counts) <= i:
+            self.counts.extend([0] * (i + 1 - len(self.counts)))
+        self.counts[i] += n
+        self.max = max(self.max, value)
+
+    def size(self):
+        return sum(self.counts)
+
+    @staticmethod
+    def bucket(value):
+        sub = 1 << Histogram.SUB_BITS
+        if value < sub:
+            return int(value)
+        shift = int(value).bit_length() - Histogram.SUB_BITS
+        return sub + (shift - 1) * (sub // 2) + (int(value) >> shift) - sub // 2
+
+    @staticmethod
+    def value(i):
+        """ the middle of the values in bucket i """
+        sub = 1 << Histogram.SUB_BITS
+        half = sub // 2
+        if i < sub:
+            return i
+        j = i - sub
+        shift = j // half + 1
+        lowest = (half + j % half) << shift
+        return lowest + ((1 << shift) - 1) // 2
+
+    def percentile(self, p):
+        n = self.size()
+        rank = max(1, int(math.ceil(p * n)))
+        seen = 0
+        for i, c in enumerate(self.counts):
+            seen += c
+            if seen >= rank:
+                return min(Histogram.value(i), self.max)
+        return self.max
+
+    def min(self):
+        for i, c in enumerate(self.counts):
+            if c > 0:
+                return Histogram.value(i)
+        return 0
+
+
 class TxnInfo(object):
     def __init__(self, txn_type, txn_name, interest):
         self.txn_type = txn_type
@@ -91,10 +157,10 @@ class TxnInfo(object):
         self.mid_pre_commit_txn = 0
         self.mid_commit_txn = 0
         self.mid_time = 0.0
-        self.mid_latencies = []
-        self.mid_all_latencies = []
-        self.mid_attempt_latencies = []
-        self.mid_n_try = []
+        # latencies in microseconds
+        self.mid_latencies = Histogram()
+        self.mid_attempt_latencies = Histogram()
+        self.mid_n_try = Histogram()
 
     def set_mid_status(self):
         self.mid_status += 1
@@ -140,11 +206,10 @@ class TxnInfo(object):
             logger.debug("mid_pre_commit_txn (+{}): {}".format(commit_txn, self.mid_pre_commit_txn))
         elif self.mid_status == 1:
             logger.debug("during recording period!!! {}".format(self.txn_type))
-            self.mid_latencies.extend(latencies)
-            self.mid_all_latencies.extend(self.mid_latencies)
-            self.mid_attempt_latencies.extend(attempt_latencies)
+            self.mid_latencies.add(latencies)
+            self.mid_attempt_latencies.add(attempt_latencies)
             self.mid_time += interval_time
-            self.mid_n_try.extend(n_tried)
+            self.mid_n_try.add(n_tried)
             self.mid_start_txn += start_txn
             self.mid_total_txn += total_txn
             self.mid_total_try += total_try
@@ -214,14 +279,13 @@ class TxnInfo(object):
         logger.info("mid_pre_commit_txn: {}".format(self.mid_pre_commit_txn))
         logger.info("mid_time = {}".format(self.mid_time))
 
+        # a txn that ran out of retries counts as the slowest one.
+        mid_all_latencies = Histogram()
+        mid_all_latencies.counts = list(self.mid_latencies.counts)
+        mid_all_latencies.max = self.mid_latencies.max
         if self.mid_retry_exhausted > 0:
-            m = [max(self.mid_latencies)]
-            self.mid_all_latencies.extend(m * self.mid_retry_exhausted)
-
-        self.mid_latencies.sort()
-        self.mid_all_latencies.sort()
-        self.mid_attempt_latencies.sort()
-        self.mid_n_try.sort()
+            mid_all_latencies.record(self.mid_latencies.max,
+                                     self.mid_retry_exhausted)
 
         NO_VALUE = 999999.99
 
@@ -232,21 +296,18 @@ class TxnInfo(object):
             logger.info("percent: {}".format(percent))
             percent = percent*100
             key = str(percent)
-            if len(self.mid_latencies)>0:
-                index = int(math.ceil(percent/100*len(self.mid_latencies)))-1
-                latencies[key] = self.mid_latencies[index]
+            if self.mid_latencies.size()>0:
+                latencies[key] = self.mid_latencies.percentile(percent/100) / 1000.0
             else:
                 latencies[key] = NO_VALUE
 
-            if len(self.mid_all_latencies)>0:
-                index = int(math.ceil(percent/100*len(self.mid_all_latencies)))-1
-                all_latencies[key] = self.mid_all_latencies[index]
+            if mid_all_latencies.size()>0:
+                all_latencies[key] = mid_all_latencies.percentile(percent/100) / 1000.0
             else:
                 all_latencies[key] = NO_VALUE
 
-            if len(self.mid_attempt_latencies)>0:
-                att_index = int(math.ceil(percent/100*len(self.mid_attempt_latencies)))-1
-                att_latencies[key] = self.mid_attempt_latencies[att_index]
+            if self.mid_attempt_latencies.size()>0:
+                att_latencies[key] = self.mid_attempt_latencies.percentile(percent/100) / 1000.0
             else:
                 att_latencies[key] = NO_VALUE
 
@@ -278,29 +339,27 @@ class TxnInfo(object):
 
         self.data['latency'] = {}
         self.data['latency'].update(latencies)
-        if len(self.mid_latencies)>0:
-            self.data['latency']['min'] = self.mid_latencies[0]
-            self.data['latency']['max'] = self.mid_latencies[len(self.mid_latencies)-1]
+        if self.mid_latencies.size()>0:
+            self.data['latency']['min'] = self.mid_latencies.min() / 1000.0
+            self.data['latency']['max'] = self.mid_latencies.max / 1000.0
         else:
             self.data['latency']['min'] = NO_VALUE
             self.data['latency']['max'] = NO_VALUE
 
         self.data['all_latency'] = {}
         self.data['all_latency'].update(all_latencies)
-        if len(self.mid_all_latencies)>0:
-            self.data['all_latency']['min'] = self.mid_all_latencies[0]
-            self.data['all_latency']['max'] = self.mid_all_latencies[len(self.mid_all_latencies)-1]
+        if mid_all_latencies.size()>0:
+            self.data['all_latency']['min'] = mid_all_latencies.min() / 1000.0
+            self.data['all_latency']['max'] = mid_all_latencies.max / 1000.0
         else:
             self.data['all_latency']['min'] = NO_VALUE
             self.data['all_latency']['max'] = NO_VALUE
 
         self.data['att_latency'] = {}
         self.data['att_latency'].update(att_latencies)
-        if len(self.mid_latencies)>0:
-            self.data['att_latency']['min'] = self.mid_attempt_latencies[0]
-            self.data['att_latency']['max'] = self.mid_attempt_latencies[
-                len(self.mid_attempt_latencies)-1
-            ]
+        if self.mid_attempt_latencies.size()>0:
+            self.data['att_latency']['min'] = self.mid_attempt_latencies.min() / 1000.0
+            self.data['att_latency']['max'] = self.mid_attempt_latencies.max / 1000.0
         else:
             self.data['att_latency']['min'] = NO_VALUE
             self.data['att_latency']['max'] = NO_VALUE
@@ -9,6 +9,10 @@ char MICRO_BENCH_TABLE_A[] = "table_a";
 char MICRO_BENCH_TABLE_B[] = "table_b";
 char MICRO_BENCH_TABLE_C[] = "table_c";
 char MICRO_BENCH_TABLE_D[] = "table_d";
+const mdb::tblid_t MICRO_BENCH_TABLE_A_ID = mdb::table_id(MICRO_BENCH_TABLE_A);
+const mdb::tblid_t MICRO_BENCH_TABLE_B_ID = mdb::table_id(MICRO_BENCH_TABLE_B);
+const mdb::tblid_t MICRO_BENCH_TABLE_C_ID = mdb::table_id(MICRO_BENCH_TABLE_C);
+const mdb::tblid_t MICRO_BENCH_TABLE_D_ID = mdb::table_id(MICRO_BENCH_TABLE_D);
 
 void MicroWorkload::GetReadReq(TxRequest *req, uint32_t cid) const {
   req->tx_type_ = MICRO_BENCH_R;
@@ -57,7 +61,7 @@ void MicroWorkload::RegisterPrecedures() {
          verify(cmd.input.size() == 2);
          mdb::MultiBlob buf(1);
          buf[0] = cmd.input[0].get_blob();
-         auto tbl = tx.GetTable(MICRO_BENCH_TABLE_A);
+         auto tbl = tx.GetTable(MICRO_BENCH_TABLE_A_ID);
          mdb::Row *r = tx.Query(tbl, buf);
          tx.WriteColumn(r, 1, cmd.input[MICRO_VAR_V_0]);
        }
@@ -73,7 +77,7 @@ void MicroWorkload::RegisterPrecedures() {
          verify(cmd.input.size() == 2);
          mdb::MultiBlob buf(1);
          buf[0] = cmd.input[0].get_blob();
-         auto tbl = tx.GetTable(MICRO_BENCH_TABLE_C);
+         auto tbl = tx.GetTable(MICRO_BENCH_TABLE_C_ID);
          mdb::Row *r = tx.Query(tbl, buf);
          tx.WriteColumn(r, 1, cmd.input[MICRO_VAR_V_2]);
        }
@@ -87,7 +91,7 @@ void MicroWorkload::RegisterPrecedures() {
 //    verify(cmd.input.size() == 2);
 //    mdb::MultiBlob buf(1);
 //    buf[0] = cmd.input[0].get_blob();
-//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_D);
+//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_D_ID);
 //    mdb::Row *r = dtxn->Query(tbl, buf);
 //    dtxn->WriteColumn(r, 1, cmd.input[MICRO_VAR_V_3]);
 //  } END_PIE
@@ -98,7 +102,7 @@ void MicroWorkload::RegisterPrecedures() {
 //    verify(cmd.input.size() == 2);
 //    mdb::MultiBlob buf(1);
 //    buf[0] = cmd.input[0].get_blob();
-//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_A);
+//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_A_ID);
 //    mdb::Row *r = dtxn->Query(tbl, buf);
 //    dtxn->WriteColumn(r, 1, cmd.input[MICRO_VAR_V_0]);
 //  } END_PIE
@@ -109,7 +113,7 @@ void MicroWorkload::RegisterPrecedures() {
 //    verify(cmd.input.size() == 2);
 //    mdb::MultiBlob buf(1);
 //    buf[0] = cmd.input[0].get_blob();
-//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_B);
+//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_B_ID);
 //    mdb::Row *r = dtxn->Query(tbl, buf);
 //    dtxn->WriteColumn(r, 1, cmd.input[MICRO_VAR_V_1]);
 //  } END_PIE
@@ -120,7 +124,7 @@ void MicroWorkload::RegisterPrecedures() {
 //    verify(cmd.input.size() == 2);
 //    mdb::MultiBlob buf(1);
 //    buf[0] = cmd.input[0].get_blob();
-//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_C);
+//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_C_ID);
 //    mdb::Row *r = dtxn->Query(tbl, buf);
 //    dtxn->WriteColumn(r, 1, cmd.input[MICRO_VAR_V_2]);
 //  } END_PIE
@@ -131,7 +135,7 @@ void MicroWorkload::RegisterPrecedures() {
 //    verify(cmd.input.size() == 2);
 //    mdb::MultiBlob buf(1);
 //    buf[0] = cmd.input[0].get_blob();
-//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_D);
+//    auto tbl = dtxn->GetTable(MICRO_BENCH_TABLE_D_ID);
 //    mdb::Row *r = dtxn->Query(tbl, buf);
 //    dtxn->WriteColumn(r, 1, cmd.input[MICRO_VAR_V_3]);
 //  } END_PIE
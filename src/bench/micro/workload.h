@@ -10,6 +10,10 @@ extern char MICRO_BENCH_TABLE_A[];
 extern char MICRO_BENCH_TABLE_B[];
 extern char MICRO_BENCH_TABLE_C[];
 extern char MICRO_BENCH_TABLE_D[];
+extern const mdb::tblid_t MICRO_BENCH_TABLE_A_ID;
+extern const mdb::tblid_t MICRO_BENCH_TABLE_B_ID;
+extern const mdb::tblid_t MICRO_BENCH_TABLE_C_ID;
+extern const mdb::tblid_t MICRO_BENCH_TABLE_D_ID;
 
 #define MICRO_BENCH_R     1
 #define MICRO_BENCH_R_NAME "MICRO_R"
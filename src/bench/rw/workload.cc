@@ -4,6 +4,7 @@
 
 namespace janus {
 char RW_BENCHMARK_TABLE[] = "history";
+const mdb::tblid_t RW_BENCHMARK_TABLE_ID = mdb::table_id(RW_BENCHMARK_TABLE);
 
 void RwWorkload::RegisterPrecedures() {
   RegP(RW_BENCHMARK_R_TXN, RW_BENCHMARK_R_TXN_0,
@@ -18,7 +19,7 @@ void RwWorkload::RegisterPrecedures() {
            verify(cmd.input.size() == 1);
            auto id = cmd.input[0].get_i64();
            buf[0] = cmd.input[0].get_blob();
-           auto tbl = tx.GetTable(RW_BENCHMARK_TABLE);
+           auto tbl = tx.GetTable(RW_BENCHMARK_TABLE_ID);
            auto row = tx.Query(tbl, buf);
            tx.ReadColumn(row, 1, &result, TXN_BYPASS);
            output[0] = result;
@@ -39,7 +40,7 @@ void RwWorkload::RegisterPrecedures() {
          verify(cmd.input.size() == 1);
          auto id = cmd.input[0].get_i64();
          buf[0] = cmd.input[0].get_blob();
-         auto tbl = tx.GetTable(RW_BENCHMARK_TABLE);
+         auto tbl = tx.GetTable(RW_BENCHMARK_TABLE_ID);
          auto row = tx.Query(tbl, buf);
          tx.ReadColumn(row, 1, &result, TXN_BYPASS);
          result.set_i32(result.get_i32() + 1);
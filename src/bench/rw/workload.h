@@ -6,6 +6,7 @@
 namespace janus {
 
 extern char RW_BENCHMARK_TABLE[];
+extern const mdb::tblid_t RW_BENCHMARK_TABLE_ID;
 
 #define RW_BENCHMARK_W_TXN  (100)
 #define RW_BENCHMARK_R_TXN  (200)
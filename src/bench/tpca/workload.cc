@@ -9,6 +9,9 @@ namespace janus {
 char TPCA_BRANCH[] = "branch";
 char TPCA_TELLER[] = "teller";
 char TPCA_CUSTOMER[] = "customer";
+const mdb::tblid_t TPCA_BRANCH_ID = mdb::table_id(TPCA_BRANCH);
+const mdb::tblid_t TPCA_TELLER_ID = mdb::table_id(TPCA_TELLER);
+const mdb::tblid_t TPCA_CUSTOMER_ID = mdb::table_id(TPCA_CUSTOMER);
 
 TpcaWorkload::TpcaWorkload(Config* config) : Workload(config) {
   std::map<std::string, uint64_t> table_num_rows;
@@ -176,7 +179,7 @@ void TpcaWorkload::RegisterPrecedures() {
          mdb::MultiBlob mb(1);
          mb[0] = cmd.input.at(TPCA_VAR_X).get_blob();
 
-         r = tx.Query(tx.GetTable(TPCA_CUSTOMER), mb, TPCA_ROW_1);
+         r = tx.Query(tx.GetTable(TPCA_CUSTOMER_ID), mb, TPCA_ROW_1);
          tx.ReadColumn(r, 1, &buf, TXN_BYPASS);
          output[TPCA_VAR_OX] = buf;
          buf.set_i32(buf.get_i32() + 1/*input[1].get_i32()*/);
@@ -202,7 +205,7 @@ void TpcaWorkload::RegisterPrecedures() {
          mdb::MultiBlob mb(1);
          mb[0] = cmd.input.at(TPCA_VAR_Y).get_blob();
 
-         r = tx.Query(tx.GetTable(TPCA_TELLER), mb, TPCA_ROW_2);
+         r = tx.Query(tx.GetTable(TPCA_TELLER_ID), mb, TPCA_ROW_2);
          tx.ReadColumn(r, 1, &buf, TXN_BYPASS);
          output[TPCA_VAR_OY] = buf;
          buf.set_i32(buf.get_i32() + 1/*input[1].get_i32()*/);
@@ -229,7 +232,7 @@ void TpcaWorkload::RegisterPrecedures() {
          mdb::MultiBlob mb(1);
          mb[0] = cmd.input.at(TPCA_VAR_Z).get_blob();
 
-         r = tx.Query(tx.GetTable(TPCA_BRANCH), mb, TPCA_ROW_3);
+         r = tx.Query(tx.GetTable(TPCA_BRANCH_ID), mb, TPCA_ROW_3);
          tx.ReadColumn(r, 1, &buf, TXN_BYPASS);
          output[TPCA_VAR_OZ] = buf;
          buf.set_i32(buf.get_i32() + 1/*input[1].get_i32()*/);
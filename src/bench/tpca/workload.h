@@ -7,6 +7,9 @@ namespace janus {
 extern char TPCA_BRANCH[];
 extern char TPCA_TELLER[];
 extern char TPCA_CUSTOMER[];
+extern const mdb::tblid_t TPCA_BRANCH_ID;
+extern const mdb::tblid_t TPCA_TELLER_ID;
+extern const mdb::tblid_t TPCA_CUSTOMER_ID;
 
 #define TPCA_PAYMENT (10)
 #define TPCA_PAYMENT_NAME "PAYMENT"
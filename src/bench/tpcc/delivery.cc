@@ -55,7 +55,7 @@ void TpccWorkload::RegDelivery() {
          Value buf;
          //cell_locator_t cl(TPCC_TB_NEW_ORDER, 3);
          mdb::Row *r = NULL;
-         mdb::Table *tbl = tx.GetTable(TPCC_TB_NEW_ORDER);
+         mdb::Table *tbl = tx.GetTable(TPCC_TB_NEW_ORDER_ID);
 
          mdb::MultiBlob mbl(3), mbh(3);
          mbl[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
@@ -152,7 +152,7 @@ void TpccWorkload::RegDelivery() {
          mbh[3] = ol_number_high.get_blob();
 
          mdb::ResultSet
-             rs_ol = tx.QueryIn(tx.GetTable(TPCC_TB_ORDER_LINE),
+             rs_ol = tx.QueryIn(tx.GetTable(TPCC_TB_ORDER_LINE_ID),
                                    mbl,
                                    mbh,
                                    mdb::ORD_ASC,
@@ -209,7 +209,7 @@ void TpccWorkload::RegDelivery() {
          mb[1] = cmd.input[TPCC_VAR_D_ID].get_blob();
          mb[2] = cmd.input[TPCC_VAR_W_ID].get_blob();
 
-         auto tbl_customer = tx.GetTable(TPCC_TB_CUSTOMER);
+         auto tbl_customer = tx.GetTable(TPCC_TB_CUSTOMER_ID);
          row_customer = tx.Query(tbl_customer, mb, ROW_CUSTOMER);
          Value buf = Value(0.0);
          tx.ReadColumn(row_customer, TPCC_COL_CUSTOMER_C_BALANCE,
@@ -68,7 +68,7 @@ void TpccWorkload::RegNewOrder() {
                     cmd.input[TPCC_VAR_D_ID].get_i32(),
                     cmd.input[TPCC_VAR_W_ID].get_i32());
           mdb::Row *row_district = tx.Query(
-              tx.GetTable(TPCC_TB_DISTRICT),
+              tx.GetTable(TPCC_TB_DISTRICT_ID),
               mb,
               ROW_DISTRICT);
               Value buf(0);
@@ -104,7 +104,7 @@ void TpccWorkload::RegNewOrder() {
 //         verify(cmd.input.size() >= 1);
 //         Log::debug("TPCC_NEW_ORDER, piece: %d", TPCC_NEW_ORDER_1);
          mdb::Row *row_warehouse = tx.Query(
-             tx.GetTable(TPCC_TB_WAREHOUSE),
+             tx.GetTable(TPCC_TB_WAREHOUSE_ID),
              cmd.input[TPCC_VAR_W_ID].get_blob(),
              ROW_WAREHOUSE);
          // R warehouse
@@ -129,7 +129,7 @@ void TpccWorkload::RegNewOrder() {
          mb[0] = cmd.input.at(TPCC_VAR_C_ID).get_blob();
          mb[1] = cmd.input.at(TPCC_VAR_D_ID).get_blob();
          mb[2] = cmd.input.at(TPCC_VAR_W_ID).get_blob();
-         auto table = tx.GetTable(TPCC_TB_CUSTOMER);
+         auto table = tx.GetTable(TPCC_TB_CUSTOMER_ID);
          mdb::Row *row_customer = tx.Query(table, mb, ROW_CUSTOMER);
          // R customer
          tx.ReadColumn(row_customer, TPCC_COL_CUSTOMER_C_LAST,
@@ -155,14 +155,14 @@ void TpccWorkload::RegNewOrder() {
 //         verify(cmd.input.size() >= 6);
 //         Log::debug("TPCC_NEW_ORDER, piece: %d", TPCC_NEW_ORDER_3);
          int32_t oi = 0;
-         mdb::Table *tbl = tx.GetTable(TPCC_TB_ORDER);
+         mdb::Table *tbl = tx.GetTable(TPCC_TB_ORDER_ID);
 
          mb = mdb::MultiBlob(3);
          mb[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
          mb[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
          mb[2] = cmd.input[TPCC_VAR_C_ID].get_blob();
 
-         mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY),
+         mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY_ID),
                                    mb,
                                    ROW_ORDER_SEC);
          verify(r);
@@ -183,7 +183,7 @@ void TpccWorkload::RegNewOrder() {
          verify(r->schema_);
          tx.InsertRow(tbl, r);
 
-//    r = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY),
+//    r = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY_ID),
 //                    mb,
 //                    ROW_ORDER_SEC);
          tx.WriteColumn(r, 3, cmd.input[TPCC_VAR_W_ID], TXN_BYPASS);
@@ -202,7 +202,7 @@ void TpccWorkload::RegNewOrder() {
 //         verify(cmd.input.size() >= 3);
 //         Log_debug("TPCC_NEW_ORDER, piece: %d", TPCC_NEW_ORDER_4);
 
-         mdb::Table *new_order_tbl = tx.GetTable(TPCC_TB_NEW_ORDER);
+         mdb::Table *new_order_tbl = tx.GetTable(TPCC_TB_NEW_ORDER_ID);
 
          // W new_order
          std::vector<Value> new_order_row_data(
@@ -233,7 +233,7 @@ void TpccWorkload::RegNewOrder() {
            verify(cmd.input.size() >= 1);
            Log_debug("TPCC_NEW_ORDER, piece: %d",
                      TPCC_NEW_ORDER_RI(i));
-           auto tbl_item = tx.GetTable(TPCC_TB_ITEM);
+           auto tbl_item = tx.GetTable(TPCC_TB_ITEM_ID);
            mdb::Row *row_item =
                tx.Query(tbl_item,
                            cmd.input[TPCC_VAR_I_ID(i)].get_blob(),
@@ -276,7 +276,7 @@ void TpccWorkload::RegNewOrder() {
            Log_debug("new order read stock. item_id: %x, s_w_id: %x",
                      i_id,
                      w_id);
-           auto tbl_stock = tx.GetTable(TPCC_TB_STOCK);
+           auto tbl_stock = tx.GetTable(TPCC_TB_STOCK_ID);
            mdb::Row *r = tx.Query(tbl_stock, mb, ROW_STOCK);
            verify(r->schema_);
            //i32 s_dist_col = 3 + input[2].get_i32();
@@ -315,7 +315,7 @@ void TpccWorkload::RegNewOrder() {
            mb[0] = cmd.input[TPCC_VAR_I_ID(i)].get_blob();
            mb[1] = cmd.input[TPCC_VAR_S_W_ID(i)].get_blob();
 
-           r = tx.Query(tx.GetTable(TPCC_TB_STOCK), mb, ROW_STOCK_TEMP);
+           r = tx.Query(tx.GetTable(TPCC_TB_STOCK_ID), mb, ROW_STOCK_TEMP);
            verify(r->schema_);
            // Ri stock
            Value buf(0);
@@ -371,7 +371,7 @@ void TpccWorkload::RegNewOrder() {
            verify(cmd.input.size() >= 9);
            Log_debug("TPCC_NEW_ORDER, piece: %d", TPCC_NEW_ORDER_WOL(i));
 
-           mdb::Table *tbl = tx.GetTable(TPCC_TB_ORDER_LINE);
+           mdb::Table *tbl = tx.GetTable(TPCC_TB_ORDER_LINE_ID);
            mdb::Row *r = NULL;
 
            double am = (double) cmd.input[TPCC_VAR_OL_QUANTITY(i)].get_i32();
@@ -181,7 +181,7 @@ void TpccWorkload::RegOrderStatus() {
          Log_debug("TPCC_ORDER_STATUS, piece: %d", TPCC_ORDER_STATUS_1);
          verify(cmd.input.size() >= 3);
 
-         mdb::Table *tbl = tx.GetTable(TPCC_TB_CUSTOMER);
+         mdb::Table *tbl = tx.GetTable(TPCC_TB_CUSTOMER_ID);
          // R customer
          Value buf;
          mdb::MultiBlob mb(3);
@@ -228,7 +228,7 @@ void TpccWorkload::RegOrderStatus() {
          mb_0[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
          mb_0[2] = cmd.input[TPCC_VAR_C_ID].get_blob();
          mdb::Row
-             *r_0 = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY),
+             *r_0 = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY_ID),
                                 mb_0,
                                 ROW_ORDER_SEC);
 
@@ -237,7 +237,7 @@ void TpccWorkload::RegOrderStatus() {
          mb[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
          mb[2] = r_0->get_blob(3); // FIXME add lock before reading
 
-         mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_ORDER),
+         mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_ORDER_ID),
                                    mb,
                                    ROW_ORDER);
          tx.ReadColumn(r,
@@ -283,7 +283,7 @@ void TpccWorkload::RegOrderStatus() {
          mbl[3] = ol_number_low.get_blob();
          mbh[3] = ol_number_high.get_blob();
 
-         mdb::ResultSet rs = tx.QueryIn(tx.GetTable(TPCC_TB_ORDER_LINE),
+         mdb::ResultSet rs = tx.QueryIn(tx.GetTable(TPCC_TB_ORDER_LINE_ID),
                                            mbl,
                                            mbh,
                                            mdb::ORD_DESC,
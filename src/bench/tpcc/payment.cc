@@ -88,7 +88,7 @@ void TpccWorkload::RegPayment() {
          verify(cmd.input.size() >= 6);
          Log_debug("TPCC_PAYMENT, piece: %d", TPCC_PAYMENT_0);
          i32 oi = 0;
-         mdb::Row* row_warehouse = tx.Query(tx.GetTable(TPCC_TB_WAREHOUSE),
+         mdb::Row* row_warehouse = tx.Query(tx.GetTable(TPCC_TB_WAREHOUSE_ID),
                                             cmd.input[TPCC_VAR_W_ID].get_blob(),
                                             ROW_WAREHOUSE);
          // R warehouse
@@ -133,7 +133,7 @@ void TpccWorkload::RegPayment() {
         mb[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
         mb[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
         mdb::Row* row_district =
-            tx.Query(tx.GetTable(TPCC_TB_DISTRICT), mb, ROW_DISTRICT);
+            tx.Query(tx.GetTable(TPCC_TB_DISTRICT_ID), mb, ROW_DISTRICT);
         output[TPCC_VAR_D_NAME] = Value("");
 
         // R district
@@ -182,7 +182,7 @@ void TpccWorkload::RegPayment() {
          mdb::MultiBlob mb_temp(2);
          mb_temp[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
          mb_temp[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
-         row_temp = tx.Query(tx.GetTable(TPCC_TB_DISTRICT),
+         row_temp = tx.Query(tx.GetTable(TPCC_TB_DISTRICT_ID),
                              mb_temp,
                              ROW_DISTRICT_TEMP);
          verify(row_temp->schema_ != nullptr);
@@ -322,7 +322,7 @@ void TpccWorkload::RegPayment() {
          mb[1] = cmd.input[TPCC_VAR_C_D_ID].get_blob();
          mb[2] = cmd.input[TPCC_VAR_C_W_ID].get_blob();
          // R customer
-         r = tx.Query(tx.GetTable(TPCC_TB_CUSTOMER), mb, ROW_CUSTOMER);
+         r = tx.Query(tx.GetTable(TPCC_TB_CUSTOMER_ID), mb, ROW_CUSTOMER);
          ALock::type_t lock_20_type = ALock::RLOCK;
          if (cmd.input[TPCC_VAR_C_ID].get_i32() % 10 == 0)
            lock_20_type = ALock::WLOCK;
@@ -34,7 +34,6 @@ void TpccProcedure::Init(TxRequest &req) {
   max_try_ = req.n_try_;
   n_try_ = 1;
   commit_.store(true);
-  leaf_procs_ = txn_reg_->regs_[type_];
   switch (type_) {
     case TPCC_NEW_ORDER:
       NewOrderInit(req);
@@ -67,8 +66,9 @@ bool TpccProcedure::CheckReady() {
     if (status != WAITING) {
       continue;
     }
-    set<int32_t>& input_vars = leaf_procs_[pi].input_vars_;
-    auto& sharding_vars = leaf_procs_[pi].sharder_.second;
+    TxnPieceDef& piece = txn_reg_->get(type_, pi);
+    auto& input_vars = piece.input_vars_;
+    auto& sharding_vars = piece.sharder_.second;
     bool all_found = true;
     for (auto &var : sharding_vars) {
       if (ws_.count(var) == 0) {
@@ -88,7 +88,8 @@ bool TpccProcedure::CheckReady() {
     if (all_found && status == WAITING) {
       status = DISPATCHABLE;
       TxWorkspace& ws = GetWorkspace(pi);
-      ws.keys_ = input_vars;
+      ws.keys_.clear();
+      ws.keys_.insert(input_vars.begin(), input_vars.end());
       n_pieces_dispatchable_++;
       ret = true;
     }
@@ -127,7 +128,7 @@ bool TpccProcedure::HandleOutput(int pi,
   // above is for debug.
 
   PieceCallbackHandler handler;
-  auto& callback = txn_reg_->regs_[type_][pi].callback_;
+  auto& callback = txn_reg_->get(type_, pi).callback_;
   if (callback) {
     ret = callback(this, output_map);
   } else {
@@ -196,7 +197,7 @@ bool TpccProcedure::IsReadOnly() {
 
 parid_t TpccProcedure::GetPiecePartitionId(innid_t inn_id) {
   parid_t partition_id = 0;
-  auto& pair = txn_reg_->regs_[type_][inn_id].sharder_;
+  auto& pair = txn_reg_->get(type_, inn_id).sharder_;
   if (true) {
     auto tb = pair.first;
     auto& var_ids = pair.second;
@@ -264,7 +264,8 @@ int TpccSharding::PopulateTable(tb_info_t *tb_info_ptr, parid_t par_id) {
               std::vector<Value> sec_row_data_buf;
               for (col_info_it = sch_buf->begin();
                    col_info_it != sch_buf->end(); col_info_it++)
-                sec_row_data_buf.push_back(r->get_column(col_info_it->name));
+                sec_row_data_buf.push_back(
+                    r->get_column_view(col_info_it->name));
               mdb::Row *r_buf = frame_->CreateRow(sch_buf, sec_row_data_buf);
               tbl_sec_ptr->insert(r_buf);
             }
@@ -273,18 +274,7 @@ int TpccSharding::PopulateTable(tb_info_t *tb_info_ptr, parid_t par_id) {
 
           //XXX c_last secondary index
           if (tb_info_ptr->tb_name == TPCC_TB_CUSTOMER) {
-            std::string c_last_buf = r->get_column("c_last").get_str();
-            rrr::i32 c_id_buf = r->get_column("c_id").get_i32();
-            size_t mb_size = g_c_last_schema.key_columns_id().size(), mb_i = 0;
-            mdb::MultiBlob mb_buf(mb_size);
-            mdb::Schema::iterator col_info_it = g_c_last_schema.begin();
-            for (; col_info_it != g_c_last_schema.end(); col_info_it++) {
-              mb_buf[mb_i++] = r->get_blob(col_info_it->name);
-            }
-            g_c_last2id.insert(std::make_pair(c_last_id_t(c_last_buf,
-                                                          mb_buf,
-                                                          &g_c_last_schema),
-                                              c_id_buf));
+            InsertCLast(r);
           } //XXX
 
           //Log_debug("Row inserted");
@@ -310,4 +300,38 @@ int TpccSharding::PopulateTables(parid_t par_id) {
   return Sharding::PopulateTables(par_id);
 }
 
+void TpccSharding::InsertCLast(mdb::Row *r) {
+  mdb::blob c_last = r->get_blob("c_last");
+  std::string c_last_buf(c_last.data, c_last.len);
+  rrr::i32 c_id_buf = r->get_column("c_id").get_i32();
+  size_t mb_size = g_c_last_schema.key_columns_id().size(), mb_i = 0;
+  mdb::MultiBlob mb_buf(mb_size);
+  mdb::Schema::iterator col_info_it = g_c_last_schema.begin();
+  for (; col_info_it != g_c_last_schema.end(); col_info_it++) {
+    mb_buf[mb_i++] = r->get_blob(col_info_it->name);
+  }
+  g_c_last2id.insert(std::make_pair(c_last_id_t(c_last_buf,
+                                                mb_buf,
+                                                &g_c_last_schema),
+                                    c_id_buf));
+}
+
+void TpccSharding::SnapshotRowLoaded(const std::string &tb_name,
+                                     mdb::Row *row) {
+  if (tb_name != TPCC_TB_CUSTOMER) {
+    return;
+  }
+  if (g_c_last_schema.columns_count() == 0) {
+    // same columns as population adds, the primary ones with c_id last.
+    const mdb::Schema *schema = row->schema();
+    for (auto col_it = schema->begin(); col_it != schema->end(); col_it++) {
+      if (col_it->indexed && col_it->name != "c_id") {
+        g_c_last_schema.add_column(col_it->name.c_str(), col_it->type, true);
+      }
+    }
+    g_c_last_schema.add_column("c_id", mdb::Value::I32, true);
+  }
+  InsertCLast(row);
+}
+
 } // namespace janus
@@ -36,6 +36,10 @@ class TpccSharding : public Sharding {
   int PopulateTable(tb_info_t *tb_info, parid_t par_id) override;
   int PopulateTables(parid_t par_id) override;
 
+  // XXX c_last secondary index
+  void InsertCLast(mdb::Row *r);
+  void SnapshotRowLoaded(const std::string &tb_name, mdb::Row *row) override;
+
 };
 
 } // namespace janus
@@ -61,7 +61,7 @@ void TpccWorkload::RegStockLevel() {
          mb[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
          mb[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
 
-         auto tbl_district = tx.GetTable(TPCC_TB_DISTRICT);
+         auto tbl_district = tx.GetTable(TPCC_TB_DISTRICT_ID);
          mdb::Row *r = tx.Query(tbl_district,
                                    mb,
                                    ROW_DISTRICT);
@@ -94,7 +94,7 @@ void TpccWorkload::RegStockLevel() {
          mbl[3] = ol_number_low.get_blob();
          mbh[3] = ol_number_high.get_blob();
 
-         mdb::ResultSet rs = tx.QueryIn(tx.GetTable(TPCC_TB_ORDER_LINE),
+         mdb::ResultSet rs = tx.QueryIn(tx.GetTable(TPCC_TB_ORDER_LINE_ID),
                                            mbl,
                                            mbh,
                                            mdb::ORD_ASC,
@@ -170,7 +170,7 @@ void TpccWorkload::RegStockLevel() {
            mb[0] = cmd.input[TPCC_VAR_OL_I_ID(i)].get_blob();
            mb[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
 
-           mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_STOCK), mb, ROW_STOCK);
+           mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_STOCK_ID), mb, ROW_STOCK);
            tx.ReadColumn(r, TPCC_COL_STOCK_S_QUANTITY, &buf, TXN_BYPASS);
 
            if (buf.get_i32() < cmd.input[TPCC_VAR_THRESHOLD].get_i32())
@@ -14,6 +14,17 @@ char TPCC_TB_STOCK[] = "stock";
 char TPCC_TB_ORDER_LINE[] = "order_line";
 char TPCC_TB_ORDER_C_ID_SECONDARY[] = "order_secondary";
 
+const mdb::tblid_t TPCC_TB_WAREHOUSE_ID = mdb::table_id(TPCC_TB_WAREHOUSE);
+const mdb::tblid_t TPCC_TB_DISTRICT_ID = mdb::table_id(TPCC_TB_DISTRICT);
+const mdb::tblid_t TPCC_TB_CUSTOMER_ID = mdb::table_id(TPCC_TB_CUSTOMER);
+const mdb::tblid_t TPCC_TB_HISTORY_ID = mdb::table_id(TPCC_TB_HISTORY);
+const mdb::tblid_t TPCC_TB_ORDER_ID = mdb::table_id(TPCC_TB_ORDER);
+const mdb::tblid_t TPCC_TB_NEW_ORDER_ID = mdb::table_id(TPCC_TB_NEW_ORDER);
+const mdb::tblid_t TPCC_TB_ITEM_ID = mdb::table_id(TPCC_TB_ITEM);
+const mdb::tblid_t TPCC_TB_STOCK_ID = mdb::table_id(TPCC_TB_STOCK);
+const mdb::tblid_t TPCC_TB_ORDER_LINE_ID = mdb::table_id(TPCC_TB_ORDER_LINE);
+const mdb::tblid_t TPCC_TB_ORDER_C_ID_SECONDARY_ID = mdb::table_id(TPCC_TB_ORDER_C_ID_SECONDARY);
+
 void TpccWorkload::RegisterPrecedures() {
   RegNewOrder();
   RegPayment();
@@ -111,7 +122,7 @@ void TpccWorkload::GetNewOrderTxnReq(TxRequest *req,
 //      verify(req->input_[TPCC_VAR_S_W_ID(i)].get_i32() < 3);
       all_local = false;
     } else {
-      req->input_[TPCC_VAR_S_W_ID(i)] = req->input_[TPCC_VAR_W_ID];
+      req->input_[TPCC_VAR_S_W_ID(i)] = w_id;
       req->input_[TPCC_VAR_S_REMOTE_CNT(i)] = Value((i32) 0);
 //      verify(req->input_[TPCC_VAR_S_W_ID(i)].get_i32() < 3);
     }
@@ -248,6 +248,18 @@ extern char TPCC_TB_STOCK[];
 extern char TPCC_TB_ORDER_LINE[];
 extern char TPCC_TB_ORDER_C_ID_SECONDARY[];
 
+// mdb::table_id() of the tables above, for Tx::GetTable in the pieces.
+extern const mdb::tblid_t TPCC_TB_WAREHOUSE_ID;
+extern const mdb::tblid_t TPCC_TB_DISTRICT_ID;
+extern const mdb::tblid_t TPCC_TB_CUSTOMER_ID;
+extern const mdb::tblid_t TPCC_TB_HISTORY_ID;
+extern const mdb::tblid_t TPCC_TB_ORDER_ID;
+extern const mdb::tblid_t TPCC_TB_NEW_ORDER_ID;
+extern const mdb::tblid_t TPCC_TB_ITEM_ID;
+extern const mdb::tblid_t TPCC_TB_STOCK_ID;
+extern const mdb::tblid_t TPCC_TB_ORDER_LINE_ID;
+extern const mdb::tblid_t TPCC_TB_ORDER_C_ID_SECONDARY_ID;
+
 
 class TpccWorkload: public Workload {
  protected:
@@ -56,7 +56,7 @@ void TpccRdWorkload::RegDelivery() {
          Value buf;
          //cell_locator_t cl(TPCC_TB_NEW_ORDER, 3);
          mdb::Row *r = NULL;
-         mdb::Table *tbl = tx.GetTable(TPCC_TB_NEW_ORDER);
+         mdb::Table *tbl = tx.GetTable(TPCC_TB_NEW_ORDER_ID);
 
          mdb::MultiBlob mbl(3), mbh(3);
          mbl[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
@@ -149,7 +149,7 @@ void TpccRdWorkload::RegDelivery() {
          mbl[3] = ol_number_low.get_blob();
          mbh[3] = ol_number_high.get_blob();
 
-         mdb::ResultSet rs = tx.QueryIn(tx.GetTable(TPCC_TB_ORDER_LINE),
+         mdb::ResultSet rs = tx.QueryIn(tx.GetTable(TPCC_TB_ORDER_LINE_ID),
                                            mbl,
                                            mbh,
                                            mdb::ORD_ASC,
@@ -207,7 +207,7 @@ void TpccRdWorkload::RegDelivery() {
          mb[2] = cmd.input[TPCC_VAR_W_ID].get_blob();
 
          row_customer =
-             tx.Query(tx.GetTable(TPCC_TB_CUSTOMER), mb, ROW_CUSTOMER);
+             tx.Query(tx.GetTable(TPCC_TB_CUSTOMER_ID), mb, ROW_CUSTOMER);
          Value buf(0.0);
          tx.ReadColumn(row_customer,
                           TPCC_COL_CUSTOMER_C_BALANCE,
@@ -46,7 +46,7 @@ void TpccRdWorkload::RegNewOrder() {
          Log_debug("new order d_id: %x w_id: %x",
                    cmd.input[TPCC_VAR_D_ID].get_i32(),
                    cmd.input[TPCC_VAR_W_ID].get_i32());
-         mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_DISTRICT),
+         mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_DISTRICT_ID),
                                    mb,
                                    ROW_DISTRICT);
          Value buf(0);
@@ -81,7 +81,7 @@ void TpccRdWorkload::RegNewOrder() {
          verify(cmd.input.size() == 1);
          Log::debug("TPCCD_NEW_ORDER, piece: %d", TPCCD_NEW_ORDER_1);
          mdb::Row
-             *row_warehouse = tx.Query(tx.GetTable(TPCC_TB_WAREHOUSE),
+             *row_warehouse = tx.Query(tx.GetTable(TPCC_TB_WAREHOUSE_ID),
                                           cmd.input[TPCC_VAR_W_ID].get_blob(),
                                           ROW_WAREHOUSE);
          // R warehouse
@@ -106,7 +106,7 @@ void TpccRdWorkload::RegNewOrder() {
          mb[0] = cmd.input[TPCC_VAR_C_ID].get_blob();
          mb[1] = cmd.input[TPCC_VAR_D_ID].get_blob();
          mb[2] = cmd.input[TPCC_VAR_W_ID].get_blob();
-         auto table = tx.GetTable(TPCC_TB_CUSTOMER);
+         auto table = tx.GetTable(TPCC_TB_CUSTOMER_ID);
          mdb::Row *row_customer = tx.Query(table, mb, ROW_CUSTOMER);
          // R customer
          tx.ReadColumn(row_customer, TPCC_COL_CUSTOMER_C_LAST,
@@ -134,14 +134,14 @@ void TpccRdWorkload::RegNewOrder() {
          verify(cmd.input.size() == 7);
          Log::debug("TPCCD_NEW_ORDER, piece: %d", TPCCD_NEW_ORDER_3);
          i32 oi = 0;
-         mdb::Table *tbl = tx.GetTable(TPCC_TB_ORDER);
+         mdb::Table *tbl = tx.GetTable(TPCC_TB_ORDER_ID);
 
          mdb::MultiBlob mb(3);
          mb[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
          mb[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
          mb[2] = cmd.input[TPCC_VAR_C_ID].get_blob();
 
-         mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY),
+         mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY_ID),
                                    mb,
                                    ROW_ORDER_SEC);
          verify(r);
@@ -162,7 +162,7 @@ void TpccRdWorkload::RegNewOrder() {
          verify(r->schema_);
          tx.InsertRow(tbl, r);
 
-         r = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY),
+         r = tx.Query(tx.GetTable(TPCC_TB_ORDER_C_ID_SECONDARY_ID),
                          mb,
                          ROW_ORDER_SEC);
          tx.WriteColumn(r, 3, cmd.input[TPCC_VAR_W_ID], TXN_DEFERRED);
@@ -181,7 +181,7 @@ void TpccRdWorkload::RegNewOrder() {
          verify(cmd.input.size() == 3);
          Log_debug("TPCCD_NEW_ORDER, piece: %d", TPCCD_NEW_ORDER_4);
 
-         mdb::Table *tbl = tx.GetTable(TPCC_TB_NEW_ORDER);
+         mdb::Table *tbl = tx.GetTable(TPCC_TB_NEW_ORDER_ID);
          mdb::Row *r = NULL;
 
          // W new_order
@@ -211,7 +211,7 @@ void TpccRdWorkload::RegNewOrder() {
          LPROC {
            verify(cmd.input.size() == 1);
            Log_debug("TPCCD_NEW_ORDER, piece: %d", TPCCD_NEW_ORDER_RI(i));
-           mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_ITEM),
+           mdb::Row *r = tx.Query(tx.GetTable(TPCC_TB_ITEM_ID),
                                      cmd.input[TPCC_VAR_I_ID(i)].get_blob(),
                                      ROW_ITEM);
            // Ri item
@@ -250,7 +250,7 @@ void TpccRdWorkload::RegNewOrder() {
            Log_debug("new order read stock. item_id: %x, s_w_id: %x",
                      i_id,
                      w_id);
-           auto tbl_stock = tx.GetTable(TPCC_TB_STOCK);
+           auto tbl_stock = tx.GetTable(TPCC_TB_STOCK_ID);
            mdb::Row *r = tx.Query(tbl_stock, mb, ROW_STOCK);
            verify(r->schema_);
            //i32 s_dist_col = 3 + input[2].get_i32();
@@ -282,7 +282,7 @@ void TpccRdWorkload::RegNewOrder() {
            mb[0] = cmd.input[TPCC_VAR_I_ID(i)].get_blob();
            mb[1] = cmd.input[TPCC_VAR_S_W_ID(i)].get_blob();
 
-           r = tx.Query(tx.GetTable(TPCC_TB_STOCK), mb, ROW_STOCK_TEMP);
+           r = tx.Query(tx.GetTable(TPCC_TB_STOCK_ID), mb, ROW_STOCK_TEMP);
            verify(r->schema_);
            // Ri stock
            Value buf(0);
@@ -339,7 +339,7 @@ void TpccRdWorkload::RegNewOrder() {
            Log_debug("TPCCD_NEW_ORDER, piece: %d",
                      TPCCD_NEW_ORDER_WOL(i));
 
-           mdb::Table *tbl = tx.GetTable(TPCC_TB_ORDER_LINE);
+           mdb::Table *tbl = tx.GetTable(TPCC_TB_ORDER_LINE_ID);
            mdb::Row *r = NULL;
 
            Value amount = Value((double) (
@@ -94,7 +94,7 @@ void TpccRdWorkload::RegPayment() {
          Log_debug("TPCC_PAYMENT, piece: %d", TPCC_PAYMENT_0);
          i32 oi = 0;
          mdb::Row *row_warehouse =
-             tx.Query(tx.GetTable(TPCC_TB_WAREHOUSE),
+             tx.Query(tx.GetTable(TPCC_TB_WAREHOUSE_ID),
                          cmd.input[TPCC_VAR_W_ID].get_blob(),
                          ROW_WAREHOUSE);
          // R warehouse
@@ -134,7 +134,7 @@ void TpccRdWorkload::RegPayment() {
          mdb::MultiBlob mb(2);
          mb[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
          mb[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
-         mdb::Row *row_district = tx.Query(tx.GetTable(TPCC_TB_DISTRICT),
+         mdb::Row *row_district = tx.Query(tx.GetTable(TPCC_TB_DISTRICT_ID),
                                               mb,
                                               ROW_DISTRICT);
          // R district
@@ -178,7 +178,7 @@ void TpccRdWorkload::RegPayment() {
          //cell_locator_t cl(TPCC_TB_DISTRICT, 2);
          mb[0] = cmd.input[TPCC_VAR_D_ID].get_blob();
          mb[1] = cmd.input[TPCC_VAR_W_ID].get_blob();
-         r = tx.Query(tx.GetTable(TPCC_TB_DISTRICT),
+         r = tx.Query(tx.GetTable(TPCC_TB_DISTRICT_ID),
                          mb,
                          ROW_DISTRICT_TEMP);
          verify(r->schema_ != nullptr);
@@ -265,7 +265,7 @@ void TpccRdWorkload::RegPayment() {
          mb[1] = cmd.input[TPCC_VAR_C_D_ID].get_blob();
          mb[2] = cmd.input[TPCC_VAR_C_W_ID].get_blob();
          // R customer
-         r = tx.Query(tx.GetTable(TPCC_TB_CUSTOMER), mb, ROW_CUSTOMER);
+         r = tx.Query(tx.GetTable(TPCC_TB_CUSTOMER_ID), mb, ROW_CUSTOMER);
          ALock::type_t lock_20_type = ALock::RLOCK;
          if (cmd.input[TPCC_VAR_C_ID].get_i32() % 10 == 0)
            lock_20_type = ALock::WLOCK;
@@ -80,7 +80,7 @@ void TpccdSharding::InsertRowData(tb_info_t *tb_info,
         for (col_info_it = sch_buf->begin();
              col_info_it != sch_buf->end();
              col_info_it++) {
-          sec_row_data_buf.push_back(r->get_column(col_info_it->name));
+          sec_row_data_buf.push_back(r->get_column_view(col_info_it->name));
         }
         auto r = frame_->CreateRow(sch_buf, sec_row_data_buf);
         tbl_sec_ptr->insert(r);
@@ -89,20 +89,7 @@ void TpccdSharding::InsertRowData(tb_info_t *tb_info,
 
     // XXX c_last secondary index
     if (tb_info->tb_name == TPCC_TB_CUSTOMER) {
-      std::string c_last_buf = r->get_column("c_last").get_str();
-      int32_t c_id_buf = r->get_column("c_id").get_i32();
-      size_t mb_size = g_c_last_schema.key_columns_id().size();
-      size_t mb_i = 0;
-      mdb::MultiBlob mb_buf(mb_size);
-      mdb::Schema::iterator col_info_it = g_c_last_schema.begin();
-
-      for (; col_info_it != g_c_last_schema.end(); col_info_it++) {
-        mb_buf[mb_i++] = r->get_blob(col_info_it->name);
-      }
-      g_c_last2id.insert(std::make_pair(c_last_id_t(c_last_buf,
-                                                    mb_buf,
-                                                    &g_c_last_schema),
-                                        c_id_buf));
+      InsertCLast(r);
     }
   }
 }
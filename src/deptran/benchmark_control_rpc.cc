@@ -190,8 +190,23 @@ void ClientControlServiceImpl::client_force_stop() {
       pthread_kill(*(coo_threads_[i]), SIGALRM);
 }
 
+static int64_t timespec2ns(struct timespec time) {
+  return time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+// add what h recorded since the last drain to res.
+static void drain_histogram(Histogram& h, HistogramRes& res) {
+  res.counts.resize(Histogram::n_buckets, 0);
+  res.max = std::max(res.max, h.drain(&res.counts[0]));
+}
+
+static void trim_histogram(HistogramRes& res) {
+  while (!res.counts.empty() && res.counts.back() == 0) {
+    res.counts.pop_back();
+  }
+}
+
 void ClientControlServiceImpl::client_response(ClientResponse *res) {
-  std::lock_guard<std::recursive_mutex> guard(mtx_);
   status_mutex_.lock();
   if (CCS_FINISH == status_)
     res->is_finish = (rrr::i32) 1;
@@ -199,66 +214,44 @@ void ClientControlServiceImpl::client_response(ClientResponse *res) {
     res->is_finish = (rrr::i32) 0;
   status_mutex_.unlock();
 
-  pthread_rwlock_wrlock(&collect_lock_);
   before_last_time_ = last_time_;
   clock_gettime(&last_time_);
+  last_period_ns_.store(timespec2ns(before_last_time_));
+  this_period_ns_.store(timespec2ns(last_time_));
   res->run_sec = (rrr::i64) (last_time_.tv_sec - start_time_.tv_sec);
   res->run_nsec = (rrr::i64) (last_time_.tv_nsec - start_time_.tv_nsec);
 
   res->period_sec = (rrr::i64) (last_time_.tv_sec - before_last_time_.tv_sec);
   res->period_nsec = (rrr::i64) (last_time_.tv_nsec - before_last_time_.tv_nsec);
 
-  txn_info_switch_ = !txn_info_switch_;
-
   for (int i = 0; i < num_threads_; i++) {
     for (auto it = txn_info_[i].begin();
          it != txn_info_[i].end(); it++) {
-      res->txn_info[it->first].start_txn += it->second.start_txn;
-      res->txn_info[it->first].total_txn += it->second.total_txn;
-      res->txn_info[it->first].total_try += it->second.total_try;
-      res->txn_info[it->first].commit_txn += it->second.commit_txn;
-      res->txn_info[it->first].num_exhausted += it->second.retries_exhausted;
-      res->txn_info[it->first].interval_latency.insert(
-              res->txn_info[it->first].interval_latency.end(),
-              it->second.interval_latency.begin(),
-              it->second.interval_latency.end());
-      it->second.interval_latency.clear();
+      auto& txn_res = res->txn_info[it->first];
+      auto& info = it->second;
+      txn_res.start_txn += info.start_txn.load();
+      txn_res.total_txn += info.total_txn.load();
+      txn_res.total_try += info.total_try.load();
+      txn_res.commit_txn += info.commit_txn.load();
+      txn_res.num_exhausted += info.retries_exhausted.exchange(0);
+      drain_histogram(info.this_latency, txn_res.this_latency);
+      drain_histogram(info.last_latency, txn_res.last_latency);
+      drain_histogram(info.attempt_latency, txn_res.attempt_latency);
+      drain_histogram(info.interval_latency, txn_res.interval_latency);
+      drain_histogram(info.num_try, txn_res.num_try);
+    }
+  }
+  for (auto& pair : res->txn_info) {
+    auto& txn_res = pair.second;
+    for (auto h : {&txn_res.this_latency, &txn_res.last_latency,
+                   &txn_res.attempt_latency, &txn_res.interval_latency,
+                   &txn_res.num_try}) {
+      trim_histogram(*h);
     }
   }
 #ifdef LOG_LEVEL_AS_DEBUG
   LogClientResponse(res);
 #endif
-  pthread_rwlock_unlock(&collect_lock_);
-
-
-  int use = 0;
-  if (txn_info_switch_)
-    use = 1;
-  for (int i = 0; i < num_threads_; i++) {
-    for (std::map<int32_t, txn_info_t>::iterator it = txn_info_[i].begin();
-         it != txn_info_[i].end(); it++) {
-      res->txn_info[it->first].this_latency.insert(
-              res->txn_info[it->first].this_latency.end(),
-              it->second.interval_latencies[use]->begin(), it->second.interval_latencies[use]->end());
-      res->txn_info[it->first].last_latency.insert(
-              res->txn_info[it->first].last_latency.end(),
-              it->second.last_interval_latencies[use]->begin(), it->second.last_interval_latencies[use]->end());
-      res->txn_info[it->first].attempt_latency.insert(
-              res->txn_info[it->first].attempt_latency.end(),
-              it->second.interval_attempt_latencies[use]->begin(),
-              it->second.interval_attempt_latencies[use]->end());
-
-      res->txn_info[it->first].num_try.insert(
-              res->txn_info[it->first].num_try.end(),
-              it->second.num_try[use]->begin(), it->second.num_try[use]->end());
-
-      it->second.retries_exhausted = 0;
-      it->second.num_try[use]->clear();
-      it->second.interval_latencies[use]->clear();
-      it->second.last_interval_latencies[use]->clear();
-      it->second.interval_attempt_latencies[use]->clear();
-    }
-  }
 }
 
 void ClientControlServiceImpl::client_ready_block(rrr::i32 *res,
@@ -291,6 +284,8 @@ void ClientControlServiceImpl::client_start() {
   clock_gettime(&start_time_);
   last_time_ = start_time_;
   before_last_time_ = start_time_;
+  last_period_ns_.store(timespec2ns(start_time_));
+  this_period_ns_.store(timespec2ns(start_time_));
   status_mutex_.unlock();
 }
 
@@ -328,10 +323,8 @@ void ClientControlServiceImpl::client_get_txn_names(std::map<i32, std::string> *
 ClientControlServiceImpl::ClientControlServiceImpl(unsigned int num_threads,
                                                    const std::map<int32_t, std::string> &txn_types)
         : status_(CCS_INIT), txn_info_(NULL), num_threads_(num_threads), num_ready_(0), num_finish_(0) {
-  pthread_rwlock_init(&collect_lock_, NULL);
   coo_threads_ = (pthread_t **) malloc(sizeof(pthread_t * ) * num_threads_);
   txn_info_ = new std::map<int32_t, txn_info_t>[num_threads_];
-  txn_info_switch_ = true;
   for (int i = 0; i < num_threads_; i++) {
     for (std::map<int32_t, std::string>::const_iterator cit = txn_types.begin();
          cit != txn_types.end(); cit++) {
@@ -342,12 +335,8 @@ ClientControlServiceImpl::ClientControlServiceImpl(unsigned int num_threads,
 }
 
 ClientControlServiceImpl::~ClientControlServiceImpl() {
-  pthread_rwlock_destroy(&collect_lock_);
   int i = 0;
   for (; i < num_threads_; i++) {
-    for (std::map<int32_t, txn_info_t>::iterator it = txn_info_[i].begin();
-         it != txn_info_[i].end(); it++)
-      it->second.destroy();
     if (coo_threads_[i] != NULL)
       free(coo_threads_[i]);
   }
@@ -355,8 +344,6 @@ ClientControlServiceImpl::~ClientControlServiceImpl() {
   delete[] txn_info_;
 }
 
-const int MAX_LAT_LOG = 25;
-
 void ClientControlServiceImpl::LogClientResponse(ClientResponse *res) {
   Log_debug("__%s__", __FUNCTION__);
   Log_debug("run_sec: %ld", res->run_sec);
@@ -364,37 +351,19 @@ void ClientControlServiceImpl::LogClientResponse(ClientResponse *res) {
   Log_debug("period_sec: %ld", res->period_sec);
   Log_debug("period_nsec: %ld", res->period_nsec);
 
-  for (int i = 0; i < num_threads_; i++) {
-    for (std::map<int32_t, txn_info_t>::iterator it = txn_info_[i].begin();
-         it != txn_info_[i].end(); it++) {
-
-      Log_debug("%d: start_txn: %d", it->first, res->txn_info[it->first].start_txn);
-      Log_debug("%d: total_txn: %d", it->first, res->txn_info[it->first].total_txn);
-      Log_debug("%d: total_try: %d", it->first, res->txn_info[it->first].total_try);
-      Log_debug("%d: commit_txn: %d", it->first, res->txn_info[it->first].commit_txn);
-
-      char output[1024];
-      output[0] = '\0';
-      Log_debug("%d: interval_latency: ", it->first);
-      auto &interval_lat = res->txn_info[it->first].interval_latency;
-      size_t cnt = 0;
-      int n = 0;
-      for (auto lat_it = interval_lat.begin(); lat_it != interval_lat.end() && n < MAX_LAT_LOG; ++lat_it, ++n) {
-        char buf[32];
-        snprintf(buf, sizeof(buf), "%0.6f, ", *lat_it);
-        if (strlen(buf) + cnt < sizeof(output)) {
-          cnt += strlen(buf);
-        } else {
-          Log_debug("%s", output);
-          output[0] = '\0';
-          cnt = strlen(buf);
-        }
-        strcat(output, buf);
-      }
-      if (strlen(output) > 0) {
-        Log_debug("%s", output);
-      }
-    }
+  for (auto& pair : res->txn_info) {
+    auto& txn_res = pair.second;
+    Log_debug("%d: start_txn: %d", pair.first, txn_res.start_txn);
+    Log_debug("%d: total_txn: %d", pair.first, txn_res.total_txn);
+    Log_debug("%d: total_try: %d", pair.first, txn_res.total_try);
+    Log_debug("%d: commit_txn: %d", pair.first, txn_res.commit_txn);
+    auto& lat = txn_res.interval_latency;
+    Log_debug("%d: interval_latency (us): p50 %ld, p99 %ld, p999 %ld, max %ld",
+              pair.first,
+              Histogram::percentile(lat.counts, lat.max, 0.5),
+              Histogram::percentile(lat.counts, lat.max, 0.99),
+              Histogram::percentile(lat.counts, lat.max, 0.999),
+              lat.max);
   }
   Log_debug("__End %s__", __FUNCTION__);
 }
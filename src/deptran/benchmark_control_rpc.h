@@ -110,102 +110,72 @@ class ClientControlServiceImpl: public ClientControlService {
     CCS_STOP,
   } status_t;
 
-  typedef struct txn_info_t {
-    int32_t txn_type;
-    int32_t commit_txn;
-    int32_t start_txn;
-    int32_t total_txn;
-    int32_t total_try;
-    int32_t retries_exhausted;
-    std::vector<double> *interval_latencies[2];
-    std::vector<double> *last_interval_latencies[2];
-    std::vector<double> *interval_attempt_latencies[2];
-    std::vector<int32_t> *num_try[2];
-    std::vector<double> interval_latency;
-
-    txn_info_t() {
-      txn_type = -1;
-      start_txn = 0;
-      commit_txn = 0;
-      total_txn = 0;
-      total_try = 0;
-      retries_exhausted = 0;
-      num_try[0] = new std::vector<int32_t>();
-      num_try[1] = new std::vector<int32_t>();
-
-      interval_latencies[0] = new std::vector<double>();
-      interval_latencies[1] = new std::vector<double>();
-
-      last_interval_latencies[0] = new std::vector<double>();
-      last_interval_latencies[1] = new std::vector<double>();
-
-      interval_attempt_latencies[0] = new std::vector<double>();
-      interval_attempt_latencies[1] = new std::vector<double>();
-    }
+  /**
+   * Statistics of one txn type on one client thread. The coordinators
+   * record into it without locks, client_response drains it, so its size
+   * does not grow with the number of txns. Latencies in microseconds.
+   */
+  struct txn_info_t {
+    int32_t txn_type = -1;
+    std::atomic<int32_t> commit_txn{0};
+    std::atomic<int32_t> start_txn{0};
+    std::atomic<int32_t> total_txn{0};
+    std::atomic<int32_t> total_try{0};
+    std::atomic<int32_t> retries_exhausted{0};
+    Histogram this_latency{};
+    Histogram last_latency{};
+    Histogram attempt_latency{};
+    Histogram interval_latency{};
+    Histogram num_try{};
 
     void init(int32_t _txn_type) {
       txn_type = _txn_type;
     }
 
-    void destroy() {
-      delete interval_latencies[0];
-      delete interval_latencies[1];
-      delete last_interval_latencies[0];
-      delete last_interval_latencies[1];
-      delete interval_attempt_latencies[0];
-      delete interval_attempt_latencies[1];
-      delete num_try[0];
-      delete num_try[1];
-    }
-
-    void start(bool switzh) {
-      start_txn++;
+    void start() {
+      start_txn.fetch_add(1, std::memory_order_relaxed);
     }
 
     void give_up() {
-      retries_exhausted++;
+      retries_exhausted.fetch_add(1, std::memory_order_relaxed);
     }
 
-    void retry(bool switzh, double attempt_latency) {
-      total_try++;
-      if (switzh)
-        interval_attempt_latencies[0]->push_back(attempt_latency);
-      else
-        interval_attempt_latencies[1]->push_back(attempt_latency);
+    void retry(double attempt_latency_ms) {
+      total_try.fetch_add(1, std::memory_order_relaxed);
+      attempt_latency.record(ms2us(attempt_latency_ms));
     }
 
-    void succ(bool switzh, latency_collection_status_t lcs, double latency, double attempt_latency, int32_t tried) {
-      total_txn++;
-      total_try++;
-      commit_txn++;
-      int use = 1;
-      if (switzh)
-        use = 0;
-      num_try[use]->push_back(tried);
+    void succ(latency_collection_status_t lcs, double latency_ms,
+              double attempt_latency_ms, int32_t tried) {
+      total_txn.fetch_add(1, std::memory_order_relaxed);
+      total_try.fetch_add(1, std::memory_order_relaxed);
+      commit_txn.fetch_add(1, std::memory_order_relaxed);
+      num_try.record(tried);
       switch (lcs) {
         case LCS_THIS_PERIOD:
-          interval_latencies[use]->push_back(latency);
+          this_latency.record(ms2us(latency_ms));
           break;
         case LCS_LAST_PERIOD:
-          last_interval_latencies[use]->push_back(latency);
+          last_latency.record(ms2us(latency_ms));
           break;
         case LCS_IGNORE:
         default:
           break;
       }
-      interval_attempt_latencies[use]->push_back(attempt_latency);
-      interval_latency.push_back(latency);
+      attempt_latency.record(ms2us(attempt_latency_ms));
+      interval_latency.record(ms2us(latency_ms));
     }
 
-    void rej(bool switzh, latency_collection_status_t lcs, double latency, double attempt_latency, int32_t tried) {
-      total_txn++;
-      total_try++;
-      if (switzh)
-        interval_attempt_latencies[0]->push_back(attempt_latency);
-      else
-        interval_attempt_latencies[1]->push_back(attempt_latency);
+    void rej(double attempt_latency_ms) {
+      total_txn.fetch_add(1, std::memory_order_relaxed);
+      total_try.fetch_add(1, std::memory_order_relaxed);
+      attempt_latency.record(ms2us(attempt_latency_ms));
     }
-  } txn_info_t;
+
+    static int64_t ms2us(double ms) {
+      return (int64_t) (ms * 1000 + 0.5);
+    }
+  };
 
   std::vector<DeferredReply *> ready_block_defers_;
   //pthread_mutex_t status_mutex_;
@@ -215,10 +185,10 @@ class ClientControlServiceImpl: public ClientControlService {
   status_t status_;
   pthread_t **coo_threads_;
   std::map<int32_t, txn_info_t>* txn_info_;
-  bool txn_info_switch_;
-
-  std::recursive_mutex mtx_ = {};
-  pthread_rwlock_t collect_lock_;
+  // start of the current and of the last period, read by the
+  //   coordinators to tell this_latency from last_latency.
+  std::atomic<int64_t> this_period_ns_{0};
+  std::atomic<int64_t> last_period_ns_{0};
 
   unsigned int num_threads_;
   unsigned int num_ready_;
@@ -229,6 +199,22 @@ class ClientControlServiceImpl: public ClientControlService {
   std::map<int32_t, std::string> txn_names_;
 
   void LogClientResponse(ClientResponse *res);
+
+  txn_info_t& txn_info(unsigned int id, int32_t txn_type) {
+    verify(id >= 0 && id < num_threads_);
+    auto it = txn_info_[id].find(txn_type);
+    verify(it != txn_info_[id].end());
+    return it->second;
+  }
+
+  latency_collection_status_t collection_status(struct timespec start_time) {
+    int64_t ns = start_time.tv_sec * 1000000000LL + start_time.tv_nsec;
+    if (this_period_ns_.load(std::memory_order_relaxed) < ns)
+      return LCS_THIS_PERIOD;
+    else if (last_period_ns_.load(std::memory_order_relaxed) < ns)
+      return LCS_LAST_PERIOD;
+    return LCS_IGNORE;
+  }
  public:
   void client_get_txn_names(std::map<i32, std::string> *txn_names) override;
   void client_shutdown() override;
@@ -245,28 +231,15 @@ class ClientControlServiceImpl: public ClientControlService {
   void wait_for_shutdown();
 
   inline void txn_give_up_one(txnid_t id, int32_t txn_type) {
-    std::lock_guard<std::recursive_mutex> guard(mtx_);
-    pthread_rwlock_rdlock(&collect_lock_);
-    verify(id >= 0 && id < num_threads_);
-    verify(txn_info_[id].find(txn_type) != txn_info_[id].end());
-    txn_info_[id][txn_type].give_up();
-    pthread_rwlock_unlock(&collect_lock_);
+    txn_info(id, txn_type).give_up();
   }
 
   inline void txn_start_one(unsigned int id, int32_t txn_type) {
-    std::lock_guard<std::recursive_mutex> guard(mtx_);
-    pthread_rwlock_rdlock(&collect_lock_);
-    verify(id >= 0 && id < num_threads_);
-    verify(txn_info_[id].find(txn_type) != txn_info_[id].end());
-    txn_info_[id][txn_type].start(txn_info_switch_);
-    pthread_rwlock_unlock(&collect_lock_);
+    txn_info(id, txn_type).start();
   }
 
   inline void txn_retry_one(unsigned int id, int32_t txn_type, double attempt_latency) {
-    std::lock_guard<std::recursive_mutex> guard(mtx_);
-    pthread_rwlock_rdlock(&collect_lock_);
-    txn_info_[id][txn_type].retry(txn_info_switch_, attempt_latency);
-    pthread_rwlock_unlock(&collect_lock_);
+    txn_info(id, txn_type).retry(attempt_latency);
   }
 
   inline void txn_success_one(unsigned int id,
@@ -275,15 +248,8 @@ class ClientControlServiceImpl: public ClientControlService {
                               double latency,
                               double attempt_latency,
                               int32_t tried) {
-    std::lock_guard<std::recursive_mutex> guard(mtx_);
-    pthread_rwlock_rdlock(&collect_lock_);
-    latency_collection_status_t lcs = LCS_IGNORE;
-    if (last_time_ < start_time)
-      lcs = LCS_THIS_PERIOD;
-    else if (before_last_time_ < start_time)
-      lcs = LCS_LAST_PERIOD;
-    txn_info_[id][txn_type].succ(txn_info_switch_, lcs, latency, attempt_latency, tried);
-    pthread_rwlock_unlock(&collect_lock_);
+    txn_info(id, txn_type).succ(collection_status(start_time), latency,
+                                attempt_latency, tried);
   }
 
   inline void txn_reject_one(unsigned int id,
@@ -292,15 +258,7 @@ class ClientControlServiceImpl: public ClientControlService {
                              double latency,
                              double attempt_latency,
                              int32_t tried) {
-    std::lock_guard<std::recursive_mutex> guard(mtx_);
-    pthread_rwlock_rdlock(&collect_lock_);
-    latency_collection_status_t lcs = LCS_IGNORE;
-    if (last_time_ < start_time)
-      lcs = LCS_THIS_PERIOD;
-    else if (before_last_time_ < start_time)
-      lcs = LCS_LAST_PERIOD;
-    txn_info_[id][txn_type].rej(txn_info_switch_, lcs, latency, attempt_latency, tried);
-    pthread_rwlock_unlock(&collect_lock_);
+    txn_info(id, txn_type).rej(attempt_latency);
   }
 
   void DispatchTxn(const TxDispatchRequest& req, TxReply* txn_reply, rrr::DeferredReply* defer) override;
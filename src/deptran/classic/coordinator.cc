@@ -59,6 +59,9 @@ void CoordinatorClassic::DoTxAsync(TxRequest& req) {
   std::lock_guard<std::recursive_mutex> lock(this->mtx_);
   TxData* cmd = frame_->CreateTxnCommand(req, txn_reg_);
   verify(txn_reg_ != nullptr);
+  if (req.arrival_time_.tv_sec > 0) {
+    cmd->start_time_ = req.arrival_time_;
+  }
   cmd->root_id_ = this->next_txn_id();
   cmd->id_ = cmd->root_id_;
   ongoing_tx_id_ = cmd->id_;
@@ -165,9 +165,20 @@ bool SchedulerClassic::OnPrepare(cmdid_t tx_id,
     Log_debug("finished prepare command replication");
     return sp_tx->result_prepare;
   } else if (Config::GetConfig()->do_logging()) {
-    string log;
-    this->get_prepare_log(tx_id, sids, &log);
-    //   recorder_->submit(log, callback);
+    // a yes vote has to be on disk before it is sent.
+    bool ret = DoPrepare(tx_id);
+    if (ret) {
+      verify(recorder_ != nullptr);
+      TpcPrepareCommand prepare_cmd;
+      prepare_cmd.tx_id_ = tx_id;
+      prepare_cmd.cmd_ = sp_tx->cmd_;
+      Marshal m;
+      prepare_cmd.ToMarshal(m);
+      auto sp_ev = Reactor::CreateSpEvent<IntEvent>();
+      recorder_->submit(m, [sp_ev] () { sp_ev->Set(1); });
+      sp_ev->Wait();
+    }
+    return ret;
   } else {
     return DoPrepare(tx_id);
   }
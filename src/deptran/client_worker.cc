@@ -1,4 +1,5 @@
 #include <cmath>
+#include <fstream>
 #include "client_worker.h"
 #include "frame.h"
 #include "procedure.h"
@@ -8,6 +9,111 @@
 
 namespace janus {
 
+ArrivalProcess::ArrivalProcess(Config* config, int seed, int shard, int n_shards)
+    : type_(config->client_arrival_),
+      gap_ns_(1e9 * n_shards / config->client_rate_),
+      rng_(seed) {
+  verify(config->client_rate_ > 0);
+  if (type_ == Config::ARRIVAL_CONSTANT) {
+    next_ns_ = gap_ns_ * shard / n_shards;
+  } else if (type_ == Config::ARRIVAL_TRACE) {
+    std::ifstream in(config->client_trace_);
+    if (!in) {
+      Log_fatal("cannot open arrival trace %s", config->client_trace_.c_str());
+      verify(0);
+    }
+    uint64_t us, last_us = 0;
+    for (int line = 0; in >> us; line++) {
+      verify(us >= last_us);
+      last_us = us;
+      if (line % n_shards == shard) {
+        trace_.push_back(us * 1000);
+      }
+    }
+    verify(!trace_.empty());
+    // the next round starts one average gap after the last arrival.
+    trace_span_ns_ = last_us * 1000 + last_us * 1000 / (trace_.size() * n_shards);
+    trace_span_ns_ = std::max(trace_span_ns_, (uint64_t) 1);
+  }
+}
+
+uint64_t ArrivalProcess::Next() {
+  switch (type_) {
+    case Config::ARRIVAL_CONSTANT: {
+      auto t = next_ns_;
+      next_ns_ += gap_ns_;
+      return (uint64_t) t;
+    }
+    case Config::ARRIVAL_POISSON:
+      next_ns_ += exp_(rng_) * gap_ns_;
+      return (uint64_t) next_ns_;
+    case Config::ARRIVAL_TRACE: {
+      if (trace_pos_ == trace_.size()) {
+        trace_pos_ = 0;
+        trace_round_ns_ += trace_span_ns_;
+      }
+      return trace_round_ns_ + trace_[trace_pos_++];
+    }
+    default:
+      verify(0);
+      return 0;
+  }
+}
+
+/**
+ * Starts the requests of one arrival shard when they are due. It runs on
+ * its own poll thread and sleeps with it between arrivals; when the
+ * thread falls behind, it catches up with a burst, each request still
+ * stamped with its own arrival time.
+ */
+class OpenLoopJob : public Job {
+ public:
+  ClientWorker* worker_;
+  ArrivalProcess arrivals_;
+  std::chrono::steady_clock::time_point start_;
+  struct timespec start_time_;
+  uint64_t end_ns_;
+  uint64_t next_ns_;
+  bool done_{false};
+
+  OpenLoopJob(ClientWorker* worker, ArrivalProcess arrivals,
+              std::chrono::steady_clock::time_point start,
+              struct timespec start_time, uint64_t end_ns)
+      : worker_(worker), arrivals_(std::move(arrivals)), start_(start),
+        start_time_(start_time), end_ns_(end_ns) {
+    next_ns_ = arrivals_.Next();
+  }
+
+  uint64_t Elapsed() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_).count();
+  }
+
+  bool Ready() override {
+    return !done_ && Elapsed() >= std::min(next_ns_, end_ns_);
+  }
+
+  void Work() override {
+    auto now = Elapsed();
+    while (next_ns_ <= now && next_ns_ < end_ns_) {
+      uint64_t ns = start_time_.tv_nsec + next_ns_;
+      struct timespec arrival_time;
+      arrival_time.tv_sec = start_time_.tv_sec + ns / 1000000000;
+      arrival_time.tv_nsec = ns % 1000000000;
+      worker_->ArriveRequest(arrival_time);
+      next_ns_ = arrivals_.Next();
+    }
+    if (next_ns_ >= end_ns_) {
+      done_ = true;
+      worker_->GeneratorDone();
+    }
+  }
+
+  bool Done() override {
+    return done_;
+  }
+};
+
 ClientWorker::~ClientWorker() {
   if (tx_generator_) {
     delete tx_generator_;
@@ -60,10 +166,19 @@ void ClientWorker::RequestDone(Coordinator* coo, TxReply& txn_reply) {
   bool have_more_time = timer_->elapsed() < duration;
   Log_debug("received callback from tx_id %" PRIx64, txn_reply.tx_id_);
   Log_debug("elapsed: %2.2f; duration: %d", timer_->elapsed(), duration);
-  if (have_more_time && config_->client_type_ == Config::Open) {
-    std::lock_guard<std::mutex> lock(coordinator_mutex);
-    free_coordinators_.push_back(coo);
-  } else if (have_more_time && config_->client_type_ == Config::Closed) {
+  if (config_->client_type_ == Config::Open) {
+    {
+      std::lock_guard<std::mutex> lock(coordinator_mutex);
+      free_coordinators_.push_back(coo);
+    }
+    finish_mutex.lock();
+    verify(n_open_inflight_ > 0);
+    n_open_inflight_--;
+    if (n_open_inflight_ == 0 && n_generating_ == 0) {
+      finish_cond.signal();
+    }
+    finish_mutex.unlock();
+  } else if (have_more_time) {
     Log_debug("there is still time to issue another request. continue.");
     DispatchRequest(coo);
   } else if (!have_more_time) {
@@ -138,6 +253,7 @@ void ClientWorker::Work() {
   Workload* workload = Workload::CreateWorkload(config_);
   workload->txn_reg_ = txn_reg_;
   workload->RegisterPrecedures();
+  txn_reg_->Freeze();
 
   commo_->WaitConnectClientLeaders();
   if (ccsi) {
@@ -162,41 +278,38 @@ void ClientWorker::Work() {
     }
   } else {
     Log_info("open loop clients.");
-    const std::chrono::nanoseconds wait_time
-        ((int) (pow(10, 9) * 1.0 / (double) config_->client_rate_));
-    double tps = 0;
-    long txn_count = 0;
+    // one arrival shard on each poll thread.
+    int n_shards = poll_mgr_->n_threads_;
     auto start = std::chrono::steady_clock::now();
-    std::chrono::nanoseconds elapsed;
-
-    while (timer_->elapsed() < duration) {
-      while (tps < config_->client_rate_ && timer_->elapsed() < duration) {
-        auto coo = FindOrCreateCoordinator();
-        if (coo != nullptr) {
-          auto p_job = (Job*)new OneTimeJob([this, coo] () {
-            this->DispatchRequest(coo);
-          });
-          shared_ptr<Job> sp_job(p_job);
-          poll_mgr_->add(sp_job);
-          txn_count++;
-          elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>
-              (std::chrono::steady_clock::now() - start);
-          tps = (double) txn_count / elapsed.count() * pow(10, 9);
-        }
-      }
-      auto next_time = std::chrono::steady_clock::now() + wait_time;
-      std::this_thread::sleep_until(next_time);
-      elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>
-          (std::chrono::steady_clock::now() - start);
-      tps = (double) txn_count / elapsed.count() * pow(10, 9);
+    struct timespec start_time;
+    clock_gettime(&start_time);
+    finish_mutex.lock();
+    n_generating_ = n_shards;
+    finish_mutex.unlock();
+    for (int i = 0; i < n_shards; i++) {
+      ArrivalProcess arrivals(config_, (cli_id_ << 8) + i, i, n_shards);
+      auto sp_job = std::make_shared<OpenLoopJob>(
+          this, std::move(arrivals), start, start_time,
+          (uint64_t) duration * 1000000000);
+      poll_mgr_->add(sp_job, i);
     }
-    Log_debug("exit client dispatch loop...");
   }
 
   finish_mutex.lock();
-  while (n_concurrent_ > 0) {
-    Log_debug("wait for finish... %d", n_concurrent_);
-    finish_cond.wait(finish_mutex);
+  if (config_->client_type_ == Config::Closed) {
+    while (n_concurrent_ > 0) {
+      Log_debug("wait for finish... %d", n_concurrent_);
+      finish_cond.wait(finish_mutex);
+    }
+  } else {
+    while (n_generating_ > 0 || n_open_inflight_ > 0) {
+      Log_debug("wait for finish... %d", n_open_inflight_);
+      finish_cond.wait(finish_mutex);
+    }
+    if (n_open_dropped_ > 0) {
+      Log_info("%u arrivals dropped, no coordinator left",
+               n_open_dropped_.load());
+    }
   }
   finish_mutex.unlock();
 
@@ -243,7 +356,30 @@ void ClientWorker::AcceptForwardedRequest(TxRequest& request,
 //  dispatch_pool_->run_async(task); // this causes bug
 }
 
-void ClientWorker::DispatchRequest(Coordinator* coo) {
+void ClientWorker::ArriveRequest(struct timespec arrival_time) {
+  auto coo = FindOrCreateCoordinator();
+  if (coo == nullptr) {
+    n_open_dropped_++;
+    return;
+  }
+  finish_mutex.lock();
+  n_open_inflight_++;
+  finish_mutex.unlock();
+  DispatchRequest(coo, arrival_time);
+}
+
+void ClientWorker::GeneratorDone() {
+  finish_mutex.lock();
+  verify(n_generating_ > 0);
+  n_generating_--;
+  if (n_open_inflight_ == 0 && n_generating_ == 0) {
+    finish_cond.signal();
+  }
+  finish_mutex.unlock();
+}
+
+void ClientWorker::DispatchRequest(Coordinator* coo,
+                                   struct timespec arrival_time) {
   const char* f = __FUNCTION__;
   std::function<void()> task = [=]() {
     Log_info("%s: %d", f, cli_id_);
@@ -252,6 +388,7 @@ void ClientWorker::DispatchRequest(Coordinator* coo) {
       std::lock_guard<std::mutex> lock(this->request_gen_mutex);
       tx_generator_->GetTxRequest(&req, coo->coo_id_);
     }
+    req.arrival_time_ = arrival_time;
     req.callback_ = std::bind(&ClientWorker::RequestDone,
                               this,
                               coo,
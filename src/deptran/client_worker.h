@@ -15,6 +15,30 @@ class Coordinator;
 class TxnRegistry;
 class TxReply;
 
+/**
+ * Arrival times of one shard of an open-loop client, in nanoseconds from
+ * the start of the run. The n shards of a client together make its rate:
+ * constant arrivals are interleaved, poisson ones are n independent
+ * processes of rate / n each, and a trace is dealt out line by line.
+ */
+class ArrivalProcess {
+ public:
+  ArrivalProcess(Config* config, int seed, int shard, int n_shards);
+  uint64_t Next();
+
+ protected:
+  Config::ArrivalType type_;
+  double gap_ns_;
+  double next_ns_{0};
+  std::mt19937_64 rng_;
+  std::exponential_distribution<double> exp_{1};
+  // trace only: the arrivals of this shard, replayed over and over.
+  vector<uint64_t> trace_{};
+  size_t trace_pos_{0};
+  uint64_t trace_span_ns_{0};
+  uint64_t trace_round_ns_{0};
+};
+
 class ClientWorker {
  public:
   PollMgr* poll_mgr_{nullptr};
@@ -40,6 +64,10 @@ class ClientWorker {
   rrr::ThreadPool* dispatch_pool_ = new rrr::ThreadPool();
 
   std::atomic<uint32_t> num_txn, success, num_try;
+  // open loop only, guarded by finish_mutex.
+  int32_t n_generating_ = 0;
+  int32_t n_open_inflight_ = 0;
+  std::atomic<uint32_t> n_open_dropped_{0};
   Workload * tx_generator_{nullptr};
   Timer *timer_{nullptr};
   TxnRegistry* txn_reg_ = nullptr;
@@ -56,7 +84,11 @@ class ClientWorker {
   // This is called from a different thread.
   void Work();
   Coordinator* FindOrCreateCoordinator();
-  void DispatchRequest(Coordinator *coo);
+  void DispatchRequest(Coordinator *coo,
+                       struct timespec arrival_time = {0, 0});
+  // open loop: start one request that was due at arrival_time.
+  void ArriveRequest(struct timespec arrival_time);
+  void GeneratorDone();
   void AcceptForwardedRequest(TxRequest &request, TxReply* txn_reply, rrr::DeferredReply* defer);
 
  protected:
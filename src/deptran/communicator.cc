@@ -189,6 +189,27 @@ Communicator::NearestProxyForPartition(parid_t par_id) const {
   return partition_proxies[index];
 };
 
+MarshallDeputy Communicator::MarshalOnce(shared_ptr<Marshallable> payload) {
+  verify(payload);
+  if (dynamic_pointer_cast<SerializedMarshallable>(payload)) {
+    return MarshallDeputy(payload);
+  }
+  return MarshallDeputy(std::make_shared<SerializedMarshallable>(*payload));
+}
+
+void Communicator::BroadcastMarshalled(
+    parid_t par_id,
+    shared_ptr<Marshallable> payload,
+    const function<void(ClassicProxy*, const MarshallDeputy&)>& send) {
+  auto it = rpc_par_proxies_.find(par_id);
+  verify(it != rpc_par_proxies_.end());
+  MarshallDeputy md = MarshalOnce(payload);
+  for (auto& pair : it->second) {
+    verify(pair.second != nullptr);
+    send(pair.second, md);
+  }
+}
+
 void Communicator::BroadcastDispatch(
     shared_ptr<vector<shared_ptr<TxPieceData>>> sp_vec_piece,
     Coordinator* coo,
@@ -210,10 +231,11 @@ void Communicator::BroadcastDispatch(
   auto proxy = pair_leader_proxy.second;
   shared_ptr<VecPieceData> sp_vpd(new VecPieceData);
   sp_vpd->sp_vec_piece_data_ = sp_vec_piece;
-  MarshallDeputy md(sp_vpd); // ????
+  // the same pieces go to every replica.
+  MarshallDeputy md = MarshalOnce(sp_vpd);
   auto future = proxy->async_Dispatch(cmd_id, md, fuattr);
   Future::safe_release(future);
-  for (auto& pair : rpc_par_proxies_[par_id]) {
+  for (auto& pair : rpc_par_proxies_.at(par_id)) {
     if (pair.first != pair_leader_proxy.first) {
       rrr::FutureAttr fuattr;
       fuattr.callback =
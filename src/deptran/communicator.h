@@ -68,6 +68,20 @@ class Communicator {
   vector<function<bool(const MarshallDeputy& arg,
                        MarshallDeputy& ret)> > msg_marshall_handlers_{};
 
+  /**
+   * Serialize payload once. Every rpc the returned deputy is passed to
+   * appends the same refcounted bytes to its client's out-queue, instead
+   * of marshalling the payload again.
+   */
+  static MarshallDeputy MarshalOnce(shared_ptr<Marshallable> payload);
+  /**
+   * Call send for every replica of par_id, with the payload marshalled once.
+   */
+  void BroadcastMarshalled(
+      parid_t par_id,
+      shared_ptr<Marshallable> payload,
+      const function<void(ClassicProxy*, const MarshallDeputy&)>& send);
+
   void SendStart(SimpleCommand& cmd,
                  int32_t output_size,
                  std::function<void(Future *fu)> &callback);
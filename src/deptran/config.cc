@@ -302,6 +302,49 @@ void Config::LoadYML(std::string &filename) {
   if (config["n_parallel_dispatch"]) {
     n_parallel_dispatch_ = config["n_parallel_dispatch"].as<int32_t>();
   }
+  if (config["paxos"]) {
+    LoadPaxosYML(config["paxos"]);
+  }
+  if (config["log"]) {
+    LoadLogYML(config["log"]);
+  }
+}
+
+void Config::LoadPaxosYML(YAML::Node config) {
+  if (config["window"]) {
+    paxos_window_ = config["window"].as<int32_t>();
+  }
+  if (config["batch"]) {
+    paxos_batch_ = config["batch"].as<int32_t>();
+  }
+  if (config["log_keep"]) {
+    paxos_log_keep_ = config["log_keep"].as<int32_t>();
+  }
+  verify(paxos_window_ > 0);
+  verify(paxos_batch_ > 0);
+  verify(paxos_log_keep_ >= 0);
+  Log_info("multi-paxos window: %d, batch: %d, log kept: %d",
+           paxos_window_, paxos_batch_, paxos_log_keep_);
+}
+
+void Config::LoadLogYML(YAML::Node config) {
+  logging_ = true;
+  if (config["path"]) {
+    logging_path_ = config["path"].as<string>();
+  }
+  if (config["flush"]) {
+    static map<string, int32_t> flush_policies = {
+        {"none", rrr::Recorder::FLUSH_NONE},
+        {"fdatasync", rrr::Recorder::FLUSH_FDATASYNC},
+        {"direct", rrr::Recorder::FLUSH_DIRECT}
+    };
+    auto flush_str = config["flush"].as<string>();
+    auto it = flush_policies.find(flush_str);
+    verify(it != flush_policies.end());
+    log_flush_ = it->second;
+  }
+  Log_info("write-ahead log in %s, flush policy: %d",
+           logging_path_.c_str(), log_flush_);
 }
 
 void Config::LoadSiteYML(YAML::Node config) {
@@ -546,6 +589,12 @@ void Config::LoadBenchYML(YAML::Node config) {
     coeffcient_ = config["coefficient"].as<float>();
   if (config["rotate"])
     rotate_ = config["rotate"].as<int32_t>();
+  if (config["populate_threads"])
+    n_populate_threads_ = config["populate_threads"].as<int32_t>();
+  if (n_populate_threads_ <= 0)
+    n_populate_threads_ = std::max(1u, std::thread::hardware_concurrency());
+  if (config["snapshot"])
+    snapshot_dir_ = config["snapshot"].as<string>();
 }
 
 void Config::LoadSchemaYML(YAML::Node config) {
@@ -561,6 +610,15 @@ void Config::LoadSchemaYML(YAML::Node config) {
       info_it = tb_infos.find(tbl_name);
     }
     auto &tbl_info = info_it->second;
+    // point lookups only: a table may be unsorted, hashed on its key.
+    std::string tbl_type = table_node["type"].as<string>("sorted");
+    auto type_it = tbl_types_map_.find(tbl_type);
+    if (type_it == tbl_types_map_.end()) {
+      Log_fatal("unknown type of table %s: %s",
+                tbl_name.c_str(), tbl_type.c_str());
+      verify(0);
+    }
+    tbl_info.symbol = type_it->second;
     auto columns = table_node["column"];
     for (auto iitt = columns.begin(); iitt != columns.end(); iitt++) {
       auto column = *iitt;
@@ -635,7 +693,6 @@ void Config::LoadShardingYML(YAML::Node config) {
          replica_group_it++) {
       auto &replica_group = *replica_group_it;
       tbl_info.par_ids.push_back(replica_group.partition_id);
-      tbl_info.symbol = tbl_types_map_["sorted"];
     }
   
     verify(tbl_info.par_ids.size() > 0);
@@ -648,6 +705,20 @@ void Config::LoadClientYML(YAML::Node client) {
   if (type == "open") {
     client_type_ = Open;
     client_rate_ = client["rate"].as<int>();
+    std::string arrival = client["arrival"].as<std::string>("constant");
+    if (arrival == "constant") {
+      client_arrival_ = ARRIVAL_CONSTANT;
+    } else if (arrival == "poisson") {
+      client_arrival_ = ARRIVAL_POISSON;
+    } else if (arrival == "trace") {
+      client_arrival_ = ARRIVAL_TRACE;
+      client_trace_ = client["trace"].as<std::string>();
+    } else {
+      Log_fatal("unknown client arrival: %s", arrival.c_str());
+      verify(0);
+    }
+    Log_info("open loop client, %d txn/s, %s arrivals",
+             client_rate_, arrival.c_str());
   } else {
     client_type_ = Closed;
     client_rate_ = -1;
@@ -938,7 +1009,7 @@ bool Config::do_early_return() {
 }
 
 bool Config::do_logging() {
-  return logging_path_.empty();
+  return logging_;
 }
 
 bool Config::IsReplicated() {
@@ -23,6 +23,8 @@ class Config {
   };
 
   enum ClientType { Open, Closed };
+  // when the requests of an open-loop client arrive.
+  enum ArrivalType { ARRIVAL_CONSTANT, ARRIVAL_POISSON, ARRIVAL_TRACE };
   enum TimestampType {CLOCK=0, COUNTER=1};
 
  public:
@@ -45,6 +47,9 @@ class Config {
   // common configuration
   ClientType client_type_ = Closed;
   int client_rate_ = -1;
+  ArrivalType client_arrival_ = ARRIVAL_CONSTANT;
+  // arrival times to replay, in microseconds from the start, one per line.
+  string client_trace_{};
   int32_t tx_proto_ = 0; // transaction protocol
   int32_t replica_proto_ = 0; // replication protocol
   uint32_t proc_id_;
@@ -63,7 +68,20 @@ class Config {
   string dist_ = "uniform";
   float coeffcient_ = 0; // "uniform"
   int32_t rotate_{3};
+  // threads filling the tables of a partition, 0 for one per core.
+  int32_t n_populate_threads_{0};
+  // populated tables are dumped here, and loaded instead of being
+  // generated again on the next start. empty to always populate.
+  string snapshot_dir_{};
   int32_t n_parallel_dispatch_{0};
+  // multi-paxos leader: slots in flight, and commands batched per slot.
+  int32_t paxos_window_{64};
+  int32_t paxos_batch_{1};
+  // executed slots kept in the log, for replicas catching up.
+  int32_t paxos_log_keep_{4096};
+  // write-ahead log of paxos accepts and 2pc prepares, under logging_path_.
+  bool logging_{false};
+  int32_t log_flush_{rrr::Recorder::FLUSH_FDATASYNC};
   bool forwarding_enabled_ = false;
   int timestamp_{TimestampType::CLOCK};
 
@@ -166,6 +184,8 @@ class Config {
   void LoadBenchYML(YAML::Node config);
   void LoadShardingYML(YAML::Node config);
   void LoadClientYML(YAML::Node client);
+  void LoadPaxosYML(YAML::Node config);
+  void LoadLogYML(YAML::Node config);
   void LoadSchemaYML(YAML::Node config);
   void LoadSchemaTableColumnYML(Sharding::tb_info_t &tb_info,
                                 YAML::Node column);
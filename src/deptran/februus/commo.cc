@@ -3,9 +3,9 @@
 
 using namespace janus;
 
-// TODO change the event reference to weak ptr? because the event could be
-// destroyed before accessed if a quorum is satisfied early.
-void CommoFebruus::BroadcastPreAccept(QuorumEvent& e,
+// the callbacks hold a reference to the event, because the coordinator may
+// stop waiting on it after a quorum or a timeout.
+void CommoFebruus::BroadcastPreAccept(shared_ptr<QuorumEvent> sp_e,
                                       parid_t par_id,
                                       txid_t tx_id) {
   verify(rpc_par_proxies_.find(par_id) != rpc_par_proxies_.end());
@@ -14,20 +14,22 @@ void CommoFebruus::BroadcastPreAccept(QuorumEvent& e,
     auto proxy = (p.second);
     verify(proxy != nullptr);
     FutureAttr fuattr;
-    fuattr.callback = [&e](Future* fu) {
+    fuattr.callback = [sp_e](Future* fu) {
       int32_t res;
       uint64_t timestamp;
       fu->get_reply() >> res >> timestamp;
-      e.n_voted_++;
-      e.vec_timestamp_.push_back(timestamp);
-      e.Test();
+      sp_e->n_voted_++;
+      sp_e->vec_timestamp_.push_back(timestamp);
+      if (sp_e->status_ == Event::INIT || sp_e->status_ == Event::WAIT) {
+        sp_e->Test();
+      }
     };
     verify(tx_id > 0);
     Future::safe_release(proxy->async_PreAcceptFebruus(tx_id, fuattr));
   }
 }
 
-void CommoFebruus::BroadcastAccept(QuorumEvent& e,
+void CommoFebruus::BroadcastAccept(shared_ptr<QuorumEvent> sp_e,
                                    parid_t par_id,
                                    txid_t tx_id,
                                    ballot_t ballot,
@@ -38,12 +40,14 @@ void CommoFebruus::BroadcastAccept(QuorumEvent& e,
     auto proxy = (p.second);
     verify(proxy != nullptr);
     FutureAttr fuattr;
-    fuattr.callback = [&e](Future* fu) {
+    fuattr.callback = [sp_e](Future* fu) {
       int32_t res;
       uint64_t timestamp;
       fu->get_reply() >> res;
-      e.n_voted_++;
-      e.Test();
+      sp_e->n_voted_++;
+      if (sp_e->status_ == Event::INIT || sp_e->status_ == Event::WAIT) {
+        sp_e->Test();
+      }
     };
     verify(tx_id > 0);
     auto f = proxy->async_AcceptFebruus(tx_id, ballot, timestamp, fuattr);
@@ -7,8 +7,8 @@ namespace janus {
 class QuorumEvent;
 class CommoFebruus : public Communicator {
  public:
-  void BroadcastPreAccept(QuorumEvent& e, parid_t, txid_t);
-  void BroadcastAccept(QuorumEvent& e,
+  void BroadcastPreAccept(shared_ptr<QuorumEvent> sp_e, parid_t, txid_t);
+  void BroadcastAccept(shared_ptr<QuorumEvent> sp_e,
                        parid_t partition_id,
                        txid_t tx_id,
                        ballot_t ballot,
@@ -10,25 +10,35 @@ CommoFebruus* CoordinatorFebruus::commo() {
 }
 
 bool CoordinatorFebruus::PreAccept() {
-  map<parid_t, unique_ptr<QuorumEvent>> map_up_quorum_event;
+  map<parid_t, shared_ptr<QuorumEvent>> map_sp_quorum_event;
 
   for (auto par_id : tx_data().GetPartitionIds()) {
     auto cmds = tx_data().GetCmdsByPartition(par_id);
     auto n_replica = Config::GetConfig()->GetPartitionSize(par_id);
     auto n_quorum = n_replica;
-    map_up_quorum_event[par_id].reset(new QuorumEvent(n_replica, n_quorum));
-    commo()->BroadcastPreAccept(*map_up_quorum_event[par_id],
-                                par_id, tx_data().id_);
+    auto sp_quorum_event = Reactor::CreateSpEvent<QuorumEvent>(n_replica,
+                                                               n_quorum);
+    map_sp_quorum_event[par_id] = sp_quorum_event;
+    commo()->BroadcastPreAccept(sp_quorum_event, par_id, tx_data().id_);
   }
-  for (auto& pair: map_up_quorum_event) {
-    pair.second->Wait();
+  for (auto& pair: map_sp_quorum_event) {
+    if (!pair.second->Wait(QuorumEvent::DEFAULT_TIMEOUT)) {
+      // a replica is slow or down, go through the accept phase instead.
+      pair.second->timeouted_ = true;
+    }
   }
   Log_debug("handle pre-accept ack tx id: %" PRIx64, tx_data().id_);
   fast_path_ = true;
   uint64_t max_timestamp = 0;
-  for (auto& pair: map_up_quorum_event) {
+  for (auto& pair: map_sp_quorum_event) {
     auto& quorum_event = *pair.second;
     auto& vec_timestamp = quorum_event.vec_timestamp_;
+    if (quorum_event.timeouted_) {
+      fast_path_ = false;
+    }
+    if (vec_timestamp.empty()) {
+      continue;
+    }
     bool fast = std::all_of(vec_timestamp.begin(),
                             vec_timestamp.end(),
                             [&vec_timestamp](uint64_t x) -> bool {
@@ -41,36 +51,40 @@ bool CoordinatorFebruus::PreAccept() {
     }
     tx_data().timestamp_ = max_timestamp;
   }
-  // TODO deal with timeout.
   // TODO deal with recovery conflict.
   return fast_path_;
 }
 
 bool CoordinatorFebruus::Accept() {
-  map<parid_t, unique_ptr<QuorumEvent>> map_up_quorum_event;
   ballot_t ballot = 1; // TODO
-  for (auto par_id : tx_data().GetPartitionIds()) {
-    auto cmds = tx_data().GetCmdsByPartition(par_id);
-    commo()->BroadcastAccept(*map_up_quorum_event[par_id],
-                             par_id,
-                             tx_data().id_,
-                             ballot,
-                             tx_data().timestamp_);
-  }
-  for (auto& pair: map_up_quorum_event) {
-    pair.second->Wait();
+  set<parid_t> pending_pars = tx_data().GetPartitionIds();
+  while (!pending_pars.empty()) {
+    map<parid_t, shared_ptr<QuorumEvent>> map_sp_quorum_event;
+    for (auto par_id : pending_pars) {
+      auto cmds = tx_data().GetCmdsByPartition(par_id);
+      auto n_replica = Config::GetConfig()->GetPartitionSize(par_id);
+      auto n_quorum = n_replica / 2 + 1;
+      auto sp_quorum_event = Reactor::CreateSpEvent<QuorumEvent>(n_replica,
+                                                                 n_quorum);
+      map_sp_quorum_event[par_id] = sp_quorum_event;
+      commo()->BroadcastAccept(sp_quorum_event,
+                               par_id,
+                               tx_data().id_,
+                               ballot,
+                               tx_data().timestamp_);
+    }
+    for (auto& pair: map_sp_quorum_event) {
+      if (pair.second->Wait(QuorumEvent::DEFAULT_TIMEOUT)) {
+        pending_pars.erase(pair.first);
+      } else {
+        // retry the partitions that did not reach a quorum in time.
+        Log_debug("accept timeout for tx id: %" PRIx64 " partition: %d",
+                  tx_data().id_, (int) pair.first);
+      }
+    }
   }
   Log_debug("handle accept ack tx id: %" PRIx64, tx_data().id_);
   fast_path_ = true;
-  for (auto& pair: map_up_quorum_event) {
-    auto& quorum_event = *pair.second;
-    if (quorum_event.n_voted_ >= quorum_event.quorum_) {
-      continue;
-    } else {
-      verify(0); // TODO conflict from recovery.
-    }
-  }
-  // TODO deal with timeout.
   return true;
 }
 
@@ -9,6 +9,8 @@ namespace janus {
 
 class QuorumEvent : public Event {
  public:
+  // how long a coordinator waits for a quorum before retrying, in microsec.
+  static const uint64_t DEFAULT_TIMEOUT = 100 * 1000;
   int32_t n_total_ = -1;
   int32_t quorum_ = -1;
   int32_t n_voted_{0};
@@ -25,7 +27,6 @@ class QuorumEvent : public Event {
 
   bool IsReady() override {
     if (timeouted_) {
-      // TODO add time out support
       return true;
     }
     if (n_voted_ >= quorum_) {
@@ -9,7 +9,7 @@ bool SchedulerFebruus::Guard(Tx &tx,
                              bool write) {
 
   auto row_ver = dynamic_cast<mdb::VersionedRow *>(row);
-  auto &ver = row_ver->ver_[col_id];
+  auto ver = row_ver->get_column_ver(col_id);
   auto &tx_feb = dynamic_cast<TxFebruus &>(tx);
   tx_feb.timestamp_ = tx_feb.timestamp_ > ver ?
                            tx_feb.timestamp_ : ver;
@@ -58,32 +58,13 @@ int SchedulerFebruus::OnCommit(const txid_t tx_id,
 }
 
 void SchedulerFebruus::UpdateQueue(shared_ptr<TxFebruus> sp_tx) {
-  // remove it first to be safe.
-  auto it = queue_.begin();
-  while (it != queue_.end()) {
-    if ((*it)->tid_ == sp_tx->tid_) {
-      it = queue_.erase(it);
-      break;
-    }
-    it++;
-  }
-
-  // insert again to the right place.
-  it = queue_.begin();
-  while (it != queue_.end()) {
-    shared_ptr<TxFebruus> sp_tx_max = *it;
-    if ((*it)->timestamp_ > sp_tx->timestamp_) {
-      break; // TODO handle the case where txs have the same timestamp
-    }
-    it++;
-  }
-  queue_.insert(it, sp_tx);
+  // txs with the same timestamp go by txn id.
+  queue_.Update(sp_tx->tid_, sp_tx->timestamp_, sp_tx);
 
   // execute
-  it = queue_.begin();
-  while (it != queue_.end() && (*it) -> committed_) {
-    (*it)->ev_execute_ready_->Set(1);
-    it = queue_.erase(it);
+  while (!queue_.Empty() && queue_.Front()->committed_) {
+    queue_.Front()->ev_execute_ready_->Set(1);
+    queue_.PopFront();
   }
 }
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../classic/scheduler.h"
+#include "tx_queue.h"
 
 namespace janus {
 
@@ -12,7 +13,7 @@ class TxFebruus;
 class SchedulerFebruus : public SchedulerClassic {
  public:
   using SchedulerClassic::SchedulerClassic;
-  std::list<shared_ptr<TxFebruus>> queue_;
+  TxQueue<shared_ptr<TxFebruus>> queue_{};
 
   virtual bool Guard(Tx &tx, Row *row, int col_id, bool write = true)
   override;
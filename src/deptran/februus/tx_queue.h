@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+namespace janus {
+
+// Transactions in the order Februus executes them: by timestamp, ties
+// broken by txn id. A transaction is found again by its id, so moving it
+// to a new timestamp or taking it off the head costs O(log n) instead of a
+// walk over the queue.
+template <class T>
+class TxQueue {
+ public:
+  typedef std::pair<uint64_t, uint64_t> key_t; // timestamp, txn id
+  typedef typename std::map<key_t, T>::iterator iterator;
+
+  // queues the transaction at the timestamp, or moves it there.
+  void Update(uint64_t tx_id, uint64_t timestamp, const T& tx) {
+    key_t key(timestamp, tx_id);
+    auto it = index_.find(tx_id);
+    if (it == index_.end()) {
+      index_.emplace(tx_id, queue_.emplace(key, tx).first);
+    } else if (it->second->first == key) {
+      it->second->second = tx;
+    } else {
+      queue_.erase(it->second);
+      it->second = queue_.emplace(key, tx).first;
+    }
+  }
+
+  bool Erase(uint64_t tx_id) {
+    auto it = index_.find(tx_id);
+    if (it == index_.end()) {
+      return false;
+    }
+    queue_.erase(it->second);
+    index_.erase(it);
+    return true;
+  }
+
+  bool Empty() const {
+    return queue_.empty();
+  }
+  size_t Size() const {
+    return queue_.size();
+  }
+  T& Front() {
+    return queue_.begin()->second;
+  }
+  void PopFront() {
+    auto it = queue_.begin();
+    index_.erase(it->first.second);
+    queue_.erase(it);
+  }
+
+  iterator begin() {
+    return queue_.begin();
+  }
+  iterator end() {
+    return queue_.end();
+  }
+
+ private:
+  std::map<key_t, T> queue_{};
+  std::unordered_map<uint64_t, iterator> index_{};
+};
+
+} // namespace janus
@@ -86,7 +86,7 @@ void JanusCommo::SendInquire(parid_t pid,
 }
 
 bool JanusCommo::IsGraphOrphan(RccGraph& graph, txnid_t cmd_id) {
-  if (graph.size() == 1) {
+  if (graph.size() == 1 && !graph.partial_) {
     auto v = graph.FindV(cmd_id);
     verify(v);
     return true;
@@ -105,6 +105,10 @@ void JanusCommo::BroadcastPreAccept(
   verify(rpc_par_proxies_.find(par_id) != rpc_par_proxies_.end());
 
   bool skip_graph = IsGraphOrphan(*sp_graph, txn_id);
+  MarshallDeputy md;
+  if (!skip_graph) {
+    md = MarshalOnce(sp_graph);
+  }
 
   for (auto& p : rpc_par_proxies_[par_id]) {
     auto proxy = (p.second);
@@ -123,7 +127,6 @@ void JanusCommo::BroadcastPreAccept(
     if (skip_graph) {
       f = proxy->async_JanusPreAcceptWoGraph(txn_id, cmds, fuattr);
     } else {
-      MarshallDeputy md(sp_graph);
       f = proxy->async_JanusPreAccept(txn_id, cmds, md, fuattr);
     }
     Future::safe_release(f);
@@ -135,23 +138,20 @@ void JanusCommo::BroadcastAccept(parid_t par_id,
                                  ballot_t ballot,
                                  shared_ptr<RccGraph> graph,
                                  const function<void(int)>& callback) {
-  verify(rpc_par_proxies_.find(par_id) != rpc_par_proxies_.end());
-  for (auto& p : rpc_par_proxies_[par_id]) {
-    auto proxy = (p.second);
-    verify(proxy != nullptr);
+  verify(cmd_id > 0);
+  BroadcastMarshalled(par_id, graph, [&](ClassicProxy* proxy,
+                                         const MarshallDeputy& md) {
     FutureAttr fuattr;
     fuattr.callback = [callback](Future* fu) {
       int32_t res;
       fu->get_reply() >> res;
       callback(res);
     };
-    verify(cmd_id > 0);
-    MarshallDeputy md(graph);
     Future::safe_release(proxy->async_JanusAccept(cmd_id,
                                                   ballot,
                                                   md,
                                                   fuattr));
-  }
+  });
 }
 
 void JanusCommo::BroadcastCommit(
@@ -160,6 +160,10 @@ void JanusCommo::BroadcastCommit(
     shared_ptr<RccGraph> graph,
     const function<void(int32_t, TxnOutput&)>& callback) {
   bool skip_graph = IsGraphOrphan(*graph, cmd_id);
+  MarshallDeputy md;
+  if (!skip_graph) {
+    md = MarshalOnce(graph);
+  }
 
   verify(rpc_par_proxies_.find(par_id) != rpc_par_proxies_.end());
   for (auto& p : rpc_par_proxies_[par_id]) {
@@ -176,7 +180,6 @@ void JanusCommo::BroadcastCommit(
     if (skip_graph) {
       Future::safe_release(proxy->async_JanusCommitWoGraph(cmd_id, fuattr));
     } else {
-      MarshallDeputy md(graph);
       Future::safe_release(proxy->async_JanusCommit(cmd_id, md, fuattr));
     }
   }
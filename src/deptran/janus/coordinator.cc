@@ -135,6 +135,17 @@ void CoordinatorJanus::ChooseGraph() {
   }
 }
 
+shared_ptr<RccGraph> CoordinatorJanus::GraphFor(parid_t par_id) {
+  auto& acks = n_fast_accept_graphs_[par_id];
+  // a graph of the txn alone goes without graph at all, and a replica that
+  // did not reply gets everything.
+  if (sp_graph_->size() == 1 ||
+      acks.size() < commo()->rpc_par_proxies_[par_id].size()) {
+    return sp_graph_;
+  }
+  return sp_graph_->Delta(acks, cmd_->id_);
+}
+
 void CoordinatorJanus::Accept() {
   std::lock_guard<std::recursive_mutex> guard(mtx_);
   verify(!fast_path_);
@@ -148,7 +159,7 @@ void CoordinatorJanus::Accept() {
     commo()->BroadcastAccept(par_id,
                              cmd_->id_,
                              ballot_,
-                             sp_graph_,
+                             GraphFor(par_id),
                              std::bind(&CoordinatorJanus::AcceptAck,
                                        this,
                                        phase_,
@@ -189,7 +200,7 @@ void CoordinatorJanus::Commit() {
   for (auto par_id : cmd_->GetPartitionIds()) {
     commo()->BroadcastCommit(par_id,
                              cmd_->id_,
-                             sp_graph_,
+                             GraphFor(par_id),
                              std::bind(&CoordinatorJanus::CommitAck,
                                        this,
                                        phase_,
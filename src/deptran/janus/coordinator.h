@@ -68,6 +68,8 @@ class CoordinatorJanus : public RccCoord {
   void prepare();
   // functions needed in the accept phase.
   void ChooseGraph();
+  // the part of sp_graph_ par_id has not acknowledged in its replies.
+  shared_ptr<RccGraph> GraphFor(parid_t par_id);
   void Accept();
   void AcceptAck(phase_t phase, parid_t par_id, int res);
   bool AcceptQuorumPossible() {
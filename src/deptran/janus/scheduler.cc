@@ -304,9 +304,7 @@ void SchedulerJanus::OnCommit(const txnid_t cmd_id,
       UpgradeStatus(*dtxn, TXN_DCD);
       Execute(*dtxn);
       if (dtxn->to_checks_.size() > 0) {
-        for (auto child : dtxn->to_checks_) {
-          waitlist_.insert(child);
-        }
+        ReleaseToChecks(*dtxn);
         CheckWaitlist();
       }
     } else {
@@ -48,7 +48,7 @@ rrr::Marshal &operator>>(rrr::Marshal &m, mdb::Value &value) {
     case 3:
       std::string str;
       m >> str;
-      value.set_str(str);
+      value.set_str(std::move(str));
       break;
   }
   return m;
@@ -75,4 +75,14 @@ Marshal &Marshallable::ToMarshal(Marshal &m) const {
   return m;
 }
 
+SerializedMarshallable::SerializedMarshallable(const Marshallable& data)
+    : Marshallable(data.kind_), sp_bytes_(std::make_shared<Marshal>()) {
+  data.ToMarshal(*sp_bytes_);
+}
+
+Marshal& SerializedMarshallable::ToMarshal(Marshal& m) const {
+  m.write_shared(*sp_bytes_);
+  return m;
+}
+
 } // namespace janus
@@ -37,7 +37,9 @@ class MarshallDeputy {
     CONTAINER_CMD=3,
     CMD_TPC_PREPARE=4,
     CMD_TPC_COMMIT=5,
-    CMD_VEC_PIECE=6
+    CMD_VEC_PIECE=6,
+    CMD_BATCH=7,
+    PAXOS_SNAPSHOT=8
   };
   /**
    * This should be called by the rpc layer.
@@ -61,6 +63,19 @@ class MarshallDeputy {
   ~MarshallDeputy() = default;
 };
 
+/**
+ * A marshallable already serialized into a buffer. Marshalling it appends
+ * the same refcounted bytes without copying them, so a payload sent to
+ * many peers is only serialized once. It is never unmarshalled, the
+ * receiver gets the original kind.
+ */
+class SerializedMarshallable : public Marshallable {
+ public:
+  shared_ptr<Marshal> sp_bytes_{};
+  explicit SerializedMarshallable(const Marshallable& data);
+  Marshal& ToMarshal(Marshal& m) const override;
+};
+
 inline Marshal& operator>>(Marshal& m, MarshallDeputy& rhs) {
   m >> rhs.kind_;
   rhs.CreateActualObjectFrom(m);
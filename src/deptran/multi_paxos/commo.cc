@@ -18,8 +18,7 @@ void MultiPaxosCommo::BroadcastPrepare(parid_t par_id,
                                        ballot_t ballot,
                                        const function<void(Future*)>& cb) {
 
-  auto proxies = rpc_par_proxies_[par_id];
-  vector<Future*> fus;
+  auto& proxies = rpc_par_proxies_[par_id];
   for (auto& p : proxies) {
     auto proxy = (MultiPaxosProxy*) p.second;
     FutureAttr fuattr;
@@ -33,33 +32,42 @@ void MultiPaxosCommo::BroadcastAccept(parid_t par_id,
                                       ballot_t ballot,
                                       shared_ptr<Marshallable> cmd,
                                       const function<void(Future*)>& cb) {
-  auto proxies = rpc_par_proxies_[par_id];
-  vector<Future*> fus;
-  for (auto& p : proxies) {
-    auto proxy = (MultiPaxosProxy*) p.second;
+  BroadcastMarshalled(par_id, cmd, [&](ClassicProxy* p,
+                                       const MarshallDeputy& md) {
+    auto proxy = (MultiPaxosProxy*) p;
     FutureAttr fuattr;
     fuattr.callback = cb;
-    MarshallDeputy md(cmd);
     auto f = proxy->async_Accept(slot_id, ballot, md, fuattr);
     Future::safe_release(f);
-  }
-//  verify(0);
+  });
 }
 
 void MultiPaxosCommo::BroadcastDecide(const parid_t par_id,
                                       const slotid_t slot_id,
                                       const ballot_t ballot,
                                       const shared_ptr<Marshallable> cmd) {
-  auto proxies = rpc_par_proxies_[par_id];
-  vector<Future*> fus;
-  for (auto& p : proxies) {
-    auto proxy = (MultiPaxosProxy*) p.second;
+  BroadcastMarshalled(par_id, cmd, [&](ClassicProxy* p,
+                                       const MarshallDeputy& md) {
+    auto proxy = (MultiPaxosProxy*) p;
     FutureAttr fuattr;
     fuattr.callback = [](Future* fu) {};
-    MarshallDeputy md(cmd);
     auto f = proxy->async_Decide(slot_id, ballot, md, fuattr);
     Future::safe_release(f);
-  }
+  });
+}
+
+void MultiPaxosCommo::SendCatchup(
+    parid_t par_id,
+    slotid_t from_slot,
+    const function<void(shared_ptr<Marshallable>)>& callback) {
+  auto proxy = (MultiPaxosProxy*) LeaderProxyForPartition(par_id).second;
+  FutureAttr fuattr;
+  fuattr.callback = [callback] (Future* fu) {
+    MarshallDeputy md;
+    fu->get_reply() >> md;
+    callback(md.sp_data_);
+  };
+  Future::safe_release(proxy->async_Catchup(from_slot, fuattr));
 }
 
 } // namespace janus
@@ -24,6 +24,10 @@ class MultiPaxosCommo : public Communicator {
                        const slotid_t slot_id,
                        const ballot_t ballot,
                        const shared_ptr<Marshallable> cmd);
+  // ask the leader of par_id for what was committed from from_slot on.
+  void SendCatchup(parid_t par_id,
+                   slotid_t from_slot,
+                   const function<void(shared_ptr<Marshallable>)> &callback);
 };
 
 } // namespace janus
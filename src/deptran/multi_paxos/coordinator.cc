@@ -3,6 +3,7 @@
 #include "../constants.h"
 #include "coordinator.h"
 #include "commo.h"
+#include "pipeline.h"
 
 namespace janus {
 
@@ -21,6 +22,13 @@ void CoordinatorMultiPaxos::Submit(shared_ptr<Marshallable>& cmd,
               frame_->site_info_->id, loc_id_);
   }
 
+  verify(cmd->kind_ != MarshallDeputy::UNKNOWN);
+  verify(pipeline_ != nullptr);
+  pipeline_->Submit(*this, cmd, func);
+}
+
+void CoordinatorMultiPaxos::Propose(shared_ptr<Marshallable> cmd,
+                                    const function<void()>& func) {
   std::lock_guard<std::recursive_mutex> lock(mtx_);
   verify(!in_submission_);
   verify(cmd_ == nullptr);
@@ -32,6 +40,20 @@ void CoordinatorMultiPaxos::Submit(shared_ptr<Marshallable>& cmd,
   GotoNextPhase();
 }
 
+CoordinatorMultiPaxos* CoordinatorMultiPaxos::CreateSlotCoord() const {
+  auto coo = new CoordinatorMultiPaxos(coo_id_, benchmark_, ccsi_, thread_id_);
+  coo->frame_ = frame_;
+  coo->commo_ = commo_;
+  coo->par_id_ = par_id_;
+  coo->loc_id_ = loc_id_;
+  coo->n_replica_ = n_replica_;
+  coo->slot_hint_ = slot_hint_;
+  coo->pipeline_ = pipeline_;
+  verify(slot_hint_ != nullptr);
+  coo->slot_id_ = (*slot_hint_)++;
+  return coo;
+}
+
 ballot_t CoordinatorMultiPaxos::PickBallot() {
   return curr_ballot_ + 1;
 }
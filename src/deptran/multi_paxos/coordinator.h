@@ -7,6 +7,7 @@
 namespace janus {
 
 class MultiPaxosCommo;
+class MultiPaxosPipeline;
 class CoordinatorMultiPaxos : public Coordinator {
  public:
 //  static ballot_t next_slot_s;
@@ -32,6 +33,7 @@ class CoordinatorMultiPaxos : public Coordinator {
   uint32_t n_replica_ = 0;   // TODO
   slotid_t slot_id_ = 0;
   slotid_t *slot_hint_ = nullptr;
+  MultiPaxosPipeline *pipeline_ = nullptr;
 
   uint32_t n_replica() {
     verify(n_replica_ > 0);
@@ -54,9 +56,17 @@ class CoordinatorMultiPaxos : public Coordinator {
   }
 
   void DoTxAsync(TxRequest &req) override {}
+  /**
+   * Hand cmd to the leader's pipeline, which proposes it in the next free
+   * slot, possibly batched with other commands.
+   */
   void Submit(shared_ptr<Marshallable> &cmd,
               const std::function<void()> &func = []() {},
               const std::function<void()> &exe_callback = []() {}) override;
+  // run paxos for cmd in slot_id_, func is called once it is committed.
+  void Propose(shared_ptr<Marshallable> cmd, const std::function<void()> &func);
+  // a coordinator for the next slot, on the same partition.
+  CoordinatorMultiPaxos *CreateSlotCoord() const;
 
   ballot_t PickBallot();
   void Prepare();
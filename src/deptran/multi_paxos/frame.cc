@@ -6,6 +6,7 @@
 #include "scheduler.h"
 #include "service.h"
 #include "commo.h"
+#include "pipeline.h"
 #include "config.h"
 
 namespace janus {
@@ -41,11 +42,16 @@ Coordinator *MultiPaxosFrame::CreateCoordinator(cooid_t coo_id,
   verify(commo_ != nullptr);
   coo->commo_ = commo_;
   coo->slot_hint_ = &slot_hint_;
-  coo->slot_id_ = slot_hint_++;
+  // slots are assigned by the pipeline, when the command is proposed.
+  if (pipeline_ == nullptr) {
+    pipeline_ = new MultiPaxosPipeline(config->paxos_window_,
+                                       config->paxos_batch_);
+  }
+  coo->pipeline_ = pipeline_;
   coo->n_replica_ = config->GetPartitionSize(site_info_->partition_id_);
   coo->loc_id_ = this->site_info_->locale_id;
   verify(coo->n_replica_ != 0); // TODO
-  Log_debug("create new multi-paxos coord, slot_id: %d", (int) coo->slot_id_);
+  Log_debug("create new multi-paxos coord");
   return coo;
 }
 
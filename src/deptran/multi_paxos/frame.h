@@ -7,12 +7,14 @@
 
 namespace janus {
 
+class MultiPaxosPipeline;
 class MultiPaxosFrame : public Frame {
- private:
-  slotid_t slot_hint_ = 1;
  public:
+  // next slot the leader proposes in.
+  slotid_t slot_hint_ = 1;
   MultiPaxosFrame(int mode);
   MultiPaxosCommo *commo_ = nullptr;
+  MultiPaxosPipeline *pipeline_ = nullptr;
   Executor *CreateExecutor(cmdid_t cmd_id, Scheduler *sched) override;
   Coordinator *CreateCoordinator(cooid_t coo_id,
                                  Config *config,
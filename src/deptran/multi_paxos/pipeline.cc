@@ -0,0 +1,83 @@
+#include "pipeline.h"
+#include "coordinator.h"
+
+namespace janus {
+
+static int volatile x1 =
+    MarshallDeputy::RegInitializer(MarshallDeputy::CMD_BATCH,
+                                   [] () -> Marshallable* {
+                                     return new BatchCommand;
+                                   });
+
+Marshal& BatchCommand::ToMarshal(Marshal& m) const {
+  m << (int32_t) cmds_.size();
+  for (auto& sp_cmd : cmds_) {
+    MarshallDeputy md(sp_cmd);
+    m << md;
+  }
+  return m;
+}
+
+Marshal& BatchCommand::FromMarshal(Marshal& m) {
+  verify(cmds_.empty());
+  int32_t sz;
+  m >> sz;
+  for (int i = 0; i < sz; i++) {
+    MarshallDeputy md;
+    m >> md;
+    cmds_.push_back(md.sp_data_);
+  }
+  return m;
+}
+
+MultiPaxosPipeline::MultiPaxosPipeline(int32_t window, int32_t batch_size)
+    : window_(window), batch_size_(batch_size) {
+  verify(window_ > 0);
+  verify(batch_size_ > 0);
+}
+
+void MultiPaxosPipeline::Submit(const CoordinatorMultiPaxos& proto,
+                                shared_ptr<Marshallable> cmd,
+                                const function<void()>& callback) {
+  std::lock_guard<std::recursive_mutex> lock(mtx_);
+  queue_.push_back(Request{std::move(cmd), callback});
+  Pump(proto);
+}
+
+void MultiPaxosPipeline::Pump(const CoordinatorMultiPaxos& proto) {
+  std::lock_guard<std::recursive_mutex> lock(mtx_);
+  while (n_inflight_ < window_ && !queue_.empty()) {
+    shared_ptr<Marshallable> cmd;
+    auto sp_callbacks = std::make_shared<vector<function<void()>>>();
+    if (queue_.size() == 1 || batch_size_ == 1) {
+      // a single command goes out as it is.
+      cmd = queue_.front().cmd_;
+      sp_callbacks->push_back(queue_.front().callback_);
+      queue_.pop_front();
+    } else {
+      auto sp_batch = std::make_shared<BatchCommand>();
+      while (!queue_.empty()
+             && (int32_t) sp_batch->cmds_.size() < batch_size_) {
+        sp_batch->cmds_.push_back(queue_.front().cmd_);
+        sp_callbacks->push_back(queue_.front().callback_);
+        queue_.pop_front();
+      }
+      cmd = sp_batch;
+    }
+    n_inflight_++;
+    auto coo = proto.CreateSlotCoord();
+    Log_debug("multi-paxos pipeline proposes slot %d, %d in flight",
+              (int) coo->slot_id_, n_inflight_);
+    coo->Propose(cmd, [this, coo, sp_callbacks] () {
+      std::lock_guard<std::recursive_mutex> lock(mtx_);
+      verify(n_inflight_ > 0);
+      n_inflight_--;
+      for (auto& callback : *sp_callbacks) {
+        callback();
+      }
+      Pump(*coo);
+    });
+  }
+}
+
+} // namespace janus
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../__dep__.h"
+#include "../constants.h"
+#include "../marshallable.h"
+
+namespace janus {
+
+class CoordinatorMultiPaxos;
+
+/**
+ * Several commands decided in one paxos slot, executed in order.
+ */
+class BatchCommand : public Marshallable {
+ public:
+  vector<shared_ptr<Marshallable>> cmds_{};
+
+  BatchCommand() : Marshallable(MarshallDeputy::CMD_BATCH) {
+  }
+
+  Marshal& ToMarshal(Marshal&) const override;
+  Marshal& FromMarshal(Marshal&) override;
+};
+
+/**
+ * Leader side of multi-paxos. Submitted commands are proposed in
+ * consecutive slots, with up to window_ slots waiting for their accept
+ * quorum at the same time. Once the window is full the commands queue up,
+ * and each slot that frees up takes up to batch_size_ of them in a single
+ * accept.
+ */
+class MultiPaxosPipeline {
+ public:
+  const int32_t window_;
+  const int32_t batch_size_;
+
+  MultiPaxosPipeline(int32_t window, int32_t batch_size);
+
+  /**
+   * @param proto the submitting coordinator, the coordinators of the slots
+   * are created after it.
+   * @param callback called once cmd is committed.
+   */
+  void Submit(const CoordinatorMultiPaxos& proto,
+              shared_ptr<Marshallable> cmd,
+              const function<void()>& callback);
+
+  int32_t n_inflight() {
+    return n_inflight_;
+  }
+
+ protected:
+  struct Request {
+    shared_ptr<Marshallable> cmd_;
+    function<void()> callback_;
+  };
+
+  std::recursive_mutex mtx_{};
+  std::deque<Request> queue_{};
+  int32_t n_inflight_ = 0;
+
+  // propose queued commands while the window has room.
+  void Pump(const CoordinatorMultiPaxos& proto);
+};
+
+} // namespace janus
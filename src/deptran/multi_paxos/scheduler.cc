@@ -2,9 +2,53 @@
 
 #include "scheduler.h"
 #include "exec.h"
+#include "pipeline.h"
+#include "commo.h"
+#include "../config.h"
+#include "frame.h"
 
 namespace janus {
 
+static int volatile x1 =
+    MarshallDeputy::RegInitializer(MarshallDeputy::PAXOS_SNAPSHOT,
+                                   [] () -> Marshallable* {
+                                     return new PaxosSnapshot;
+                                   });
+
+Marshal& PaxosSnapshot::ToMarshal(Marshal& m) const {
+  m << snapshot_slot_;
+  m << (int8_t) (app_state_ ? 1 : 0);
+  if (app_state_) {
+    MarshallDeputy md(app_state_);
+    m << md;
+  }
+  m << (int32_t) cmds_.size();
+  for (auto& sp_cmd : cmds_) {
+    MarshallDeputy md(sp_cmd);
+    m << md;
+  }
+  return m;
+}
+
+Marshal& PaxosSnapshot::FromMarshal(Marshal& m) {
+  verify(cmds_.empty());
+  int8_t has_state;
+  m >> snapshot_slot_ >> has_state;
+  if (has_state) {
+    MarshallDeputy md;
+    m >> md;
+    app_state_ = md.sp_data_;
+  }
+  int32_t sz;
+  m >> sz;
+  for (int i = 0; i < sz; i++) {
+    MarshallDeputy md;
+    m >> md;
+    cmds_.push_back(md.sp_data_);
+  }
+  return m;
+}
+
 void SchedulerMultiPaxos::OnPrepare(slotid_t slot_id,
                                     ballot_t ballot,
                                     ballot_t *max_ballot,
@@ -13,6 +57,12 @@ void SchedulerMultiPaxos::OnPrepare(slotid_t slot_id,
   Log_debug("multi-paxos scheduler receives prepare for slot_id: %llx",
             slot_id);
   auto instance = GetInstance(slot_id);
+  if (instance == nullptr) {
+    // executed and compacted already, nothing to recover here.
+    *max_ballot = ballot;
+    cb();
+    return;
+  }
   verify(ballot != instance->max_ballot_seen_);
   if (instance->max_ballot_seen_ < ballot) {
     instance->max_ballot_seen_ = ballot;
@@ -32,16 +82,82 @@ void SchedulerMultiPaxos::OnAccept(const slotid_t slot_id,
   std::lock_guard<std::recursive_mutex> lock(mtx_);
   Log_debug("multi-paxos scheduler accept for slot_id: %llx", slot_id);
   auto instance = GetInstance(slot_id);
+  if (instance == nullptr) {
+    *max_ballot = ballot;
+    cb();
+    return;
+  }
   verify(instance->max_ballot_accepted_ < ballot);
   if (instance->max_ballot_seen_ <= ballot) {
     instance->max_ballot_seen_ = ballot;
     instance->max_ballot_accepted_ = ballot;
+    instance->accepted_cmd_ = cmd;
   } else {
     // TODO
     verify(0);
   }
   *max_ballot = instance->max_ballot_seen_;
-  cb();
+  if (recorder_ != nullptr) {
+    // the accept counts towards a quorum only once it is on disk.
+    Marshal m;
+    MarshallDeputy md(cmd);
+    m << (int8_t) LOG_ACCEPT << slot_id << ballot << md;
+    recorder_->submit(m, cb);
+  } else {
+    cb();
+  }
+}
+
+void SchedulerMultiPaxos::Recover(Marshal& record) {
+  std::lock_guard<std::recursive_mutex> lock(mtx_);
+  int8_t kind;
+  slotid_t slot_id;
+  ballot_t ballot;
+  record >> kind >> slot_id >> ballot;
+  auto instance = GetInstance(slot_id);
+  if (instance == nullptr) {
+    // recovered and compacted already.
+    return;
+  }
+  if (kind == LOG_ACCEPT) {
+    MarshallDeputy md;
+    record >> md;
+    if (instance->max_ballot_accepted_ < ballot) {
+      instance->max_ballot_accepted_ = ballot;
+      instance->accepted_cmd_ = md.sp_data_;
+    }
+    if (instance->max_ballot_seen_ < ballot) {
+      instance->max_ballot_seen_ = ballot;
+    }
+  } else {
+    verify(kind == LOG_COMMIT);
+    int8_t with_cmd;
+    record >> with_cmd;
+    if (with_cmd) {
+      MarshallDeputy md;
+      record >> md;
+      instance->committed_cmd_ = md.sp_data_;
+    } else {
+      // the value decided is the one accepted with the same ballot.
+      verify(instance->max_ballot_accepted_ == ballot);
+      instance->committed_cmd_ = instance->accepted_cmd_;
+    }
+    if (slot_id > max_committed_slot_) {
+      max_committed_slot_ = slot_id;
+    }
+    // tables are populated afresh at start up instead of being rebuilt by
+    // executing the log again, every replica restarts with the same state.
+    while (max_executed_slot_ < max_committed_slot_
+           && GetInstance(max_executed_slot_ + 1)->committed_cmd_) {
+      max_executed_slot_++;
+    }
+    Compact();
+  }
+  // a recovered leader proposes after every slot it knows of.
+  auto frame = dynamic_cast<MultiPaxosFrame*>(frame_);
+  if (frame->slot_hint_ <= slot_id) {
+    frame->slot_hint_ = slot_id + 1;
+  }
 }
 
 void SchedulerMultiPaxos::OnCommit(const slotid_t slot_id,
@@ -49,22 +165,138 @@ void SchedulerMultiPaxos::OnCommit(const slotid_t slot_id,
                                    shared_ptr<Marshallable> &cmd) {
   std::lock_guard<std::recursive_mutex> lock(mtx_);
   Log_debug("multi-paxos scheduler decide for slot: %lx", slot_id);
+  if (slot_id <= max_executed_slot_) {
+    // learned through a catch-up already.
+    return;
+  }
   auto instance = GetInstance(slot_id);
+  if (recorder_ != nullptr) {
+    // no need to wait, a lost commit is learned again from the leader.
+    Marshal m;
+    m << (int8_t) LOG_COMMIT << slot_id << ballot;
+    // the command is in the log already if this replica accepted it.
+    int8_t with_cmd = instance->max_ballot_accepted_ == ballot ? 0 : 1;
+    m << with_cmd;
+    if (with_cmd) {
+      MarshallDeputy md(cmd);
+      m << md;
+    }
+    recorder_->submit(m);
+  }
   instance->committed_cmd_ = cmd;
   if (slot_id > max_committed_slot_) {
     max_committed_slot_ = slot_id;
   }
-  verify(slot_id > max_executed_slot_);
+  Execute();
+  // a hole this far behind is not going to be filled by accepts in flight.
+  auto window = Config::GetConfig()->paxos_window_;
+  if (max_committed_slot_ - max_executed_slot_ > 2 * window) {
+    Catchup();
+  }
+}
+
+void SchedulerMultiPaxos::Execute() {
+  std::lock_guard<std::recursive_mutex> lock(mtx_);
   for (slotid_t id = max_executed_slot_ + 1; id <= max_committed_slot_; id++) {
     auto next_instance = GetInstance(id);
     if (next_instance->committed_cmd_) {
-      app_next_(*next_instance->committed_cmd_);
+      auto& cmd = *next_instance->committed_cmd_;
+      if (cmd.kind_ == MarshallDeputy::CMD_BATCH) {
+        for (auto& sp_cmd : dynamic_cast<BatchCommand&>(cmd).cmds_) {
+          app_next_(*sp_cmd);
+        }
+      } else {
+        app_next_(cmd);
+      }
       Log_debug("multi-paxos executed slot %d now", id);
       max_executed_slot_++;
     } else {
       break;
     }
   }
+  Compact();
+}
+
+void SchedulerMultiPaxos::Compact() {
+  std::lock_guard<std::recursive_mutex> lock(mtx_);
+  slotid_t keep = Config::GetConfig()->paxos_log_keep_;
+  if (max_executed_slot_ < log_start_ + keep) {
+    return;
+  }
+  slotid_t new_start = max_executed_slot_ + 1 - keep;
+  auto n = std::min((size_t) (new_start - log_start_), logs_.size());
+  logs_.erase(logs_.begin(), logs_.begin() + n);
+  log_start_ = new_start;
+}
+
+void SchedulerMultiPaxos::Catchup() {
+  std::lock_guard<std::recursive_mutex> lock(mtx_);
+  if (catching_up_ || loc_id_ == 0) {
+    return;
+  }
+  catching_up_ = true;
+  auto par_id = frame_->site_info_->partition_id_;
+  Log_info("multi-paxos replica of partition %d catches up from slot %d, "
+           "%d slots committed",
+           (int) par_id, (int) max_executed_slot_ + 1,
+           (int) max_committed_slot_);
+  auto commo = dynamic_cast<MultiPaxosCommo*>(commo_);
+  verify(commo != nullptr);
+  commo->SendCatchup(par_id,
+                     max_executed_slot_ + 1,
+                     [this] (shared_ptr<Marshallable> sp_snapshot) {
+                       OnCatchupReply(
+                           dynamic_cast<PaxosSnapshot&>(*sp_snapshot));
+                     });
+}
+
+void SchedulerMultiPaxos::OnCatchup(const slotid_t from_slot,
+                                    shared_ptr<Marshallable> *snapshot) {
+  std::lock_guard<std::recursive_mutex> lock(mtx_);
+  auto sp_snapshot = std::make_shared<PaxosSnapshot>();
+  sp_snapshot->snapshot_slot_ = from_slot - 1;
+  if (from_slot < log_start_) {
+    if (app_snapshot_) {
+      sp_snapshot->app_state_ = app_snapshot_();
+      sp_snapshot->snapshot_slot_ = max_executed_slot_;
+    } else {
+      Log_error("multi-paxos cannot serve slot %d, compacted up to %d and "
+                "no snapshot action registered",
+                (int) from_slot, (int) log_start_ - 1);
+    }
+  } else {
+    for (slotid_t id = from_slot; id <= max_executed_slot_; id++) {
+      sp_snapshot->cmds_.push_back(GetInstance(id)->committed_cmd_);
+    }
+  }
+  Log_debug("multi-paxos catch-up from slot %d, %d commands",
+            (int) from_slot, (int) sp_snapshot->cmds_.size());
+  *snapshot = sp_snapshot;
+}
+
+void SchedulerMultiPaxos::OnCatchupReply(PaxosSnapshot& snapshot) {
+  std::lock_guard<std::recursive_mutex> lock(mtx_);
+  catching_up_ = false;
+  if (snapshot.app_state_ && snapshot.snapshot_slot_ > max_executed_slot_) {
+    verify(app_install_);
+    app_install_(*snapshot.app_state_);
+    max_executed_slot_ = snapshot.snapshot_slot_;
+    if (max_committed_slot_ < max_executed_slot_) {
+      max_committed_slot_ = max_executed_slot_;
+    }
+    Compact();
+  }
+  slotid_t id = snapshot.snapshot_slot_ + 1;
+  for (auto& sp_cmd : snapshot.cmds_) {
+    if (id > max_executed_slot_) {
+      GetInstance(id)->committed_cmd_ = sp_cmd;
+      if (id > max_committed_slot_) {
+        max_committed_slot_ = id;
+      }
+    }
+    id++;
+  }
+  Execute();
 }
 
 } // namespace janus
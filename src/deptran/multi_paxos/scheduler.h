@@ -15,17 +15,49 @@ struct PaxosData {
   shared_ptr<Marshallable> committed_cmd_{nullptr};
 };
 
+/**
+ * What a lagging replica needs to catch up: the application state up to
+ * snapshot_slot_ if the slots before were already compacted away, and the
+ * commands committed in the slots right after.
+ */
+class PaxosSnapshot : public Marshallable {
+ public:
+  slotid_t snapshot_slot_ = 0;
+  shared_ptr<Marshallable> app_state_{nullptr};
+  // committed in slots snapshot_slot_ + 1, snapshot_slot_ + 2, ...
+  vector<shared_ptr<Marshallable>> cmds_{};
+
+  PaxosSnapshot() : Marshallable(MarshallDeputy::PAXOS_SNAPSHOT) {
+  }
+
+  Marshal& ToMarshal(Marshal&) const override;
+  Marshal& FromMarshal(Marshal&) override;
+};
+
 class SchedulerMultiPaxos : public Scheduler {
  public:
+  // kinds of write-ahead log records.
+  enum LogRecord : int8_t { LOG_ACCEPT = 1, LOG_COMMIT = 2 };
+
   slotid_t max_executed_slot_ = 0;
   slotid_t max_committed_slot_ = 0;
-  map<slotid_t, shared_ptr<PaxosData>> logs_{};
+  // instances from slot log_start_ on, older ones are compacted once
+  // executed.
+  std::deque<PaxosData> logs_{};
+  slotid_t log_start_ = 1;
+  bool catching_up_ = false;
 
-  shared_ptr<PaxosData> GetInstance(slotid_t id) {
-    auto& sp_instance = logs_[id];
-    if(!sp_instance)
-      sp_instance.reset(new PaxosData);
-    return sp_instance;
+  /**
+   * @return nullptr if the slot is already compacted.
+   */
+  PaxosData* GetInstance(slotid_t id) {
+    if (id < log_start_) {
+      return nullptr;
+    }
+    while (log_start_ + logs_.size() <= id) {
+      logs_.emplace_back();
+    }
+    return &logs_[id - log_start_];
   }
 
   void OnPrepare(slotid_t slot_id,
@@ -43,6 +75,24 @@ class SchedulerMultiPaxos : public Scheduler {
                 const ballot_t ballot,
                 shared_ptr<Marshallable> &cmd);
 
+  // an accept or commit logged before a restart.
+  void Recover(Marshal& record) override;
+
+  // on the leader, for a replica missing slots from from_slot on.
+  void OnCatchup(const slotid_t from_slot,
+                 shared_ptr<Marshallable> *snapshot);
+
+  void OnCatchupReply(PaxosSnapshot& snapshot);
+
+  // execute the committed slots in order, as far as there is no hole.
+  void Execute();
+
+  // drop executed slots, all but the last few.
+  void Compact();
+
+  // ask the leader for the slots this replica missed.
+  void Catchup();
+
   virtual bool HandleConflicts(Tx& dtxn,
                                innid_t inn_id,
                                vector<string>& conflicts) {
@@ -53,5 +53,14 @@ void MultiPaxosServiceImpl::Decide(const uint64_t& slot,
   });
 }
 
+void MultiPaxosServiceImpl::Catchup(const uint64_t& from_slot,
+                                    MarshallDeputy* snapshot,
+                                    rrr::DeferredReply* defer) {
+  verify(sched_ != nullptr);
+  shared_ptr<Marshallable> sp_snapshot;
+  sched_->OnCatchup(from_slot, &sp_snapshot);
+  snapshot->SetMarshallable(sp_snapshot);
+  defer->reply();
+}
 
 } // namespace janus;
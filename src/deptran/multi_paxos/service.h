@@ -37,6 +37,10 @@ class MultiPaxosServiceImpl : public MultiPaxosService {
               const MarshallDeputy& cmd,
               rrr::DeferredReply* defer) override;
 
+  void Catchup(const uint64_t& from_slot,
+               MarshallDeputy* snapshot,
+               rrr::DeferredReply* defer) override;
+
 };
 
 } // namespace janus
@@ -13,11 +13,9 @@ static int volatile x1 =
                                    });
 
 TxWorkspace::TxWorkspace() {
-  values_ = std::make_shared<map<int32_t, Value>>();
 }
 
 TxWorkspace::~TxWorkspace() {
-//  delete values_;
 }
 
 TxWorkspace::TxWorkspace(const TxWorkspace& rhs)
@@ -26,8 +24,8 @@ TxWorkspace::TxWorkspace(const TxWorkspace& rhs)
 
 void TxWorkspace::Aggregate(const TxWorkspace& rhs) {
   keys_.insert(rhs.keys_.begin(), rhs.keys_.end());
-  if (values_ != rhs.values_) {
-    values_->insert(rhs.values_->begin(), rhs.values_->end());
+  if (values_ != rhs.values_ && rhs.values_) {
+    Merge(rhs.values_->begin(), rhs.values_->end());
   }
 }
 
@@ -39,16 +37,28 @@ TxWorkspace& TxWorkspace::operator=(const TxWorkspace& rhs) {
 
 TxWorkspace& TxWorkspace::operator=(const map<int32_t, Value>& rhs) {
   keys_.clear();
+  auto& vs = *mutable_values_ptr();
+  vs.clear();
+  vs.reserve(rhs.size());
   for (const auto& pair: rhs) {
     keys_.insert(pair.first);
+    vs.emplace_back(pair.first, pair.second);
   }
-  *values_ = rhs;
   return *this;
 }
 
 Value& TxWorkspace::operator[](size_t idx) {
   keys_.insert(idx);
-  return (*values_)[idx];
+  return Slot(idx);
+}
+
+Value& TxWorkspace::Slot(int32_t k) {
+  auto& vs = *mutable_values_ptr();
+  auto it = lower_bound(vs, k);
+  if (it == vs.end() || it->first != k) {
+    it = vs.emplace(it, k, Value());
+  }
+  return it->second;
 }
 
 TxData::TxData() {
@@ -58,14 +68,34 @@ TxData::TxData() {
   early_return_ = Config::GetConfig()->do_early_return();
 }
 
+Marshal& operator << (Marshal& m, const VarSet& s) {
+  int32_t n = s.ids_.size();
+  m << n;
+  m.write(s.ids_.data(), n * sizeof(int32_t));
+  return m;
+}
+
+Marshal& operator >> (Marshal& m, VarSet& s) {
+  int32_t n;
+  m >> n;
+  s.ids_.resize(n);
+  verify(m.read(s.ids_.data(), n * sizeof(int32_t)) == n * sizeof(int32_t));
+  return m;
+}
+
 Marshal& operator << (Marshal& m, const TxWorkspace &ws) {
   m << (ws.keys_);
-  auto& input_vars = *ws.values_;
-  for (int32_t k : ws.keys_) {
-    auto it = input_vars.find(k);
-    // allow some input vars not ready.
-    if (it != input_vars.end()) {
-      m << k << it->second;
+  if (ws.values_) {
+    // both sorted, walk them side by side.
+    auto it = ws.values_->begin();
+    for (int32_t k : ws.keys_) {
+      while (it != ws.values_->end() && it->first < k) {
+        it++;
+      }
+      // allow some input vars not ready.
+      if (it != ws.values_->end() && it->first == k) {
+        m << k << it->second;
+      }
     }
   }
   m << -1;
@@ -78,9 +108,16 @@ Marshal& operator >> (Marshal& m, TxWorkspace &ws) {
     int32_t k;
     m >> k;
     if (k >= 0) {
-      Value v;
-      m >> v;
-      (*ws.values_)[k] = v;
+      auto& vs = *ws.mutable_values_ptr();
+      if (vs.empty() || vs.back().first < k) {
+        // the usual case, they come in order.
+        vs.emplace_back(k, Value());
+        m >> vs.back().second;
+      } else {
+        Value v;
+        m >> v;
+        ws.Slot(k) = std::move(v);
+      }
     } else {
       break;
     }
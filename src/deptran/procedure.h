@@ -27,10 +27,72 @@ class TxReply {
   txnid_t tx_id_;
 };
 
+/**
+ * Var ids, sorted in a flat vector. A piece names tens of them at most, so
+ * a binary search and a shift on insert are cheaper than tree nodes.
+ */
+class VarSet {
+ public:
+  VarSet() = default;
+  VarSet(std::initializer_list<int32_t> ids) : ids_(ids) {
+    Normalize();
+  }
+  VarSet& operator= (std::initializer_list<int32_t> ids) {
+    ids_.assign(ids);
+    Normalize();
+    return *this;
+  }
+
+  void insert(int32_t k) {
+    auto it = std::lower_bound(ids_.begin(), ids_.end(), k);
+    if (it == ids_.end() || *it != k) {
+      ids_.insert(it, k);
+    }
+  }
+  template<class It>
+  void insert(It first, It last) {
+    ids_.insert(ids_.end(), first, last);
+    Normalize();
+  }
+  size_t count(int32_t k) const {
+    return std::binary_search(ids_.begin(), ids_.end(), k) ? 1 : 0;
+  }
+  size_t size() const {
+    return ids_.size();
+  }
+  void clear() {
+    ids_.clear();
+  }
+  vector<int32_t>::const_iterator begin() const {
+    return ids_.begin();
+  }
+  vector<int32_t>::const_iterator end() const {
+    return ids_.end();
+  }
+
+  friend Marshal& operator << (Marshal& m, const VarSet& s);
+  friend Marshal& operator >> (Marshal& m, VarSet& s);
+
+ private:
+  vector<int32_t> ids_{};
+
+  void Normalize() {
+    std::sort(ids_.begin(), ids_.end());
+    ids_.erase(std::unique(ids_.begin(), ids_.end()), ids_.end());
+  }
+};
+
+/**
+ * The vars a txn or a piece sees. keys_ are the visible ones; values live in
+ * a block sorted by var id that copies of a workspace share, so the
+ * workspace of a piece sees what the txn learns after it was made. The block
+ * is only allocated on the first write.
+ */
 class TxWorkspace {
  public:
-  set<int32_t> keys_ = {};
-  std::shared_ptr<map<int32_t, Value>> values_{};
+  typedef vector<pair<int32_t, Value>> values_t;
+  VarSet keys_ = {};
+  std::shared_ptr<values_t> values_{};
   TxWorkspace();
   ~TxWorkspace();
   TxWorkspace(const TxWorkspace& rhs);
@@ -41,15 +103,14 @@ class TxWorkspace {
 
   size_t count(int32_t k) {
     auto r1 = keys_.count(k);
-    auto r2 = (*values_).count(k);
-    verify(r1 <= r2);
+    verify(r1 == 0 || find(k) != nullptr);
     return r1;
   }
 
   Value& at(int32_t k) {
-    auto it = values_->find(k);
-    verify(it != values_->end());
-    return it->second;
+    Value* v = find(k);
+    verify(v != nullptr);
+    return *v;
   }
 
   size_t size() const {
@@ -58,7 +119,7 @@ class TxWorkspace {
 
   bool VerifyReady() {
     for (auto k: keys_) {
-      if (values_->count(k) == 0) {
+      if (find(k) == nullptr) {
         verify(0);
         return false;
       }
@@ -67,12 +128,80 @@ class TxWorkspace {
   }
 
   void insert(map<int32_t, Value>& m) {
-    // TODO
     for (auto& pair : m) {
       keys_.insert(pair.first);
     }
-    (*values_).insert(m.begin(), m.end());
+    Merge(m.begin(), m.end());
+  }
+
+  // nullptr if there is no value for k, visible or not.
+  Value* find(int32_t k) const {
+    if (!values_) {
+      return nullptr;
+    }
+    auto it = lower_bound(*values_, k);
+    if (it == values_->end() || it->first != k) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  bool has_values() const {
+    return values_ && !values_->empty();
+  }
+
+  // share the value block of rhs, creating it if rhs has none yet.
+  void ShareValues(TxWorkspace& rhs) {
+    values_ = rhs.mutable_values_ptr();
+  }
+
+ private:
+  static values_t::iterator lower_bound(values_t& vs, int32_t k) {
+    return std::lower_bound(vs.begin(), vs.end(), k,
+                            [] (const pair<int32_t, Value>& p, int32_t k) {
+                              return p.first < k;
+                            });
   }
+
+  // the value of k, added if missing, keys_ left alone.
+  Value& Slot(int32_t k);
+
+  const std::shared_ptr<values_t>& mutable_values_ptr() {
+    if (!values_) {
+      values_ = std::make_shared<values_t>();
+    }
+    return values_;
+  }
+
+  // add the pairs of a sorted range, keeping the values we already have.
+  template<class It>
+  void Merge(It first, It last) {
+    if (first == last) {
+      return;
+    }
+    auto& vs = *mutable_values_ptr();
+    values_t merged;
+    merged.reserve(vs.size() + std::distance(first, last));
+    auto it = vs.begin();
+    while (it != vs.end() && first != last) {
+      if (it->first < first->first) {
+        merged.push_back(std::move(*it++));
+      } else if (first->first < it->first) {
+        merged.emplace_back(first->first, first->second);
+        ++first;
+      } else {
+        merged.push_back(std::move(*it++));
+        ++first;
+      }
+    }
+    std::move(it, vs.end(), std::back_inserter(merged));
+    for (; first != last; ++first) {
+      merged.emplace_back(first->first, first->second);
+    }
+    vs.swap(merged);
+  }
+
+  friend Marshal& operator >> (Marshal& m, TxWorkspace& ws);
 };
 
 class TxRequest {
@@ -80,6 +209,9 @@ class TxRequest {
   uint32_t tx_type_ = ~0;
   TxWorkspace input_{};    // the inputs for the transactions.
   int n_try_ = 20;
+  // open-loop clients: when the request was due. Its latency counts from
+  //   here rather than from when it was dispatched.
+  struct timespec arrival_time_{0, 0};
   function<void(TxReply &)> callback_ = [] (TxReply&)->void {verify(0);};
   function<void()> fail_callback_ = [] () {
     verify(0);
@@ -254,8 +386,8 @@ class TxData: public CmdData {
   TxWorkspace& GetWorkspace(innid_t inn_id) {
     verify(inn_id != 0);
     TxWorkspace& ws = inputs_[inn_id];
-    if (ws.values_->size() == 0)
-      ws.values_ = ws_.values_;
+    if (!ws.has_values())
+      ws.ShareValues(ws_);
     return ws;
   }
 
@@ -0,0 +1,911 @@
+import os
+from simplerpc.marshal import Marshal
+from simplerpc.future import Future
+
+ValueTimesPair = Marshal.reg_type('ValueTimesPair', [('value', 'rrr::i64'), ('times', 'rrr::i64')])
+
+HistogramRes = Marshal.reg_type('HistogramRes', [('max', 'rrr::i64'), ('counts', 'std::vector<rrr::i64>')])
+
+TxnInfoRes = Marshal.reg_type('TxnInfoRes', [('start_txn', 'rrr::i32'), ('total_txn', 'rrr::i32'), ('total_try', 'rrr::i32'), ('commit_txn', 'rrr::i32'), ('num_exhausted', 'rrr::i32'), ('this_latency', 'HistogramRes'), ('last_latency', 'HistogramRes'), ('attempt_latency', 'HistogramRes'), ('interval_latency', 'HistogramRes'), ('num_try', 'HistogramRes')])
+
+ServerResponse = Marshal.reg_type('ServerResponse', [('statistics', 'std::map<std::string, ValueTimesPair>'), ('cpu_util', 'double'), ('r_cnt_sum', 'rrr::i64'), ('r_cnt_num', 'rrr::i64'), ('r_sz_sum', 'rrr::i64'), ('r_sz_num', 'rrr::i64')])
+
+ClientResponse = Marshal.reg_type('ClientResponse', [('txn_info', 'std::map<rrr::i32, TxnInfoRes>'), ('run_sec', 'rrr::i64'), ('run_nsec', 'rrr::i64'), ('period_sec', 'rrr::i64'), ('period_nsec', 'rrr::i64'), ('is_finish', 'rrr::i32'), ('n_asking', 'rrr::i64')])
+
+TxDispatchRequest = Marshal.reg_type('TxDispatchRequest', [('id', 'rrr::i32'), ('tx_type', 'rrr::i32'), ('input', 'std::vector<Value>')])
+
+TxnDispatchResponse = Marshal.reg_type('TxnDispatchResponse', [])
+
+class MultiPaxosService(object):
+    FORWARD = 0x5a723721
+    PREPARE = 0x50fdb952
+    ACCEPT = 0x6a656ed4
+    DECIDE = 0x408fac70
+    CATCHUP = 0x58800356
+
+    __input_type_info__ = {
+        'Forward': ['MarshallDeputy'],
+        'Prepare': ['uint64_t','ballot_t'],
+        'Accept': ['uint64_t','ballot_t','MarshallDeputy'],
+        'Decide': ['uint64_t','ballot_t','MarshallDeputy'],
+        'Catchup': ['uint64_t'],
+    }
+
+    __output_type_info__ = {
+        'Forward': [],
+        'Prepare': ['ballot_t'],
+        'Accept': ['ballot_t'],
+        'Decide': [],
+        'Catchup': ['MarshallDeputy'],
+    }
+
+    def __bind_helper__(self, func):
+        def f(*args):
+            return getattr(self, func.__name__)(*args)
+        return f
+
+    def __reg_to__(self, server):
+        server.__reg_func__(MultiPaxosService.FORWARD, self.__bind_helper__(self.Forward), ['MarshallDeputy'], [])
+        server.__reg_func__(MultiPaxosService.PREPARE, self.__bind_helper__(self.Prepare), ['uint64_t','ballot_t'], ['ballot_t'])
+        server.__reg_func__(MultiPaxosService.ACCEPT, self.__bind_helper__(self.Accept), ['uint64_t','ballot_t','MarshallDeputy'], ['ballot_t'])
+        server.__reg_func__(MultiPaxosService.DECIDE, self.__bind_helper__(self.Decide), ['uint64_t','ballot_t','MarshallDeputy'], [])
+        server.__reg_func__(MultiPaxosService.CATCHUP, self.__bind_helper__(self.Catchup), ['uint64_t'], ['MarshallDeputy'])
+
+    def Forward(__self__, cmd):
+        raise NotImplementedError('subclass MultiPaxosService and implement your own Forward function')
+
+    def Prepare(__self__, slot, ballot):
+        raise NotImplementedError('subclass MultiPaxosService and implement your own Prepare function')
+
+    def Accept(__self__, slot, ballot, cmd):
+        raise NotImplementedError('subclass MultiPaxosService and implement your own Accept function')
+
+    def Decide(__self__, slot, ballot, cmd):
+        raise NotImplementedError('subclass MultiPaxosService and implement your own Decide function')
+
+    def Catchup(__self__, from_slot):
+        raise NotImplementedError('subclass MultiPaxosService and implement your own Catchup function')
+
+class MultiPaxosProxy(object):
+    def __init__(self, clnt):
+        self.__clnt__ = clnt
+
+    def async_Forward(__self__, cmd):
+        return __self__.__clnt__.async_call(MultiPaxosService.FORWARD, [cmd], MultiPaxosService.__input_type_info__['Forward'], MultiPaxosService.__output_type_info__['Forward'])
+
+    def async_Prepare(__self__, slot, ballot):
+        return __self__.__clnt__.async_call(MultiPaxosService.PREPARE, [slot, ballot], MultiPaxosService.__input_type_info__['Prepare'], MultiPaxosService.__output_type_info__['Prepare'])
+
+    def async_Accept(__self__, slot, ballot, cmd):
+        return __self__.__clnt__.async_call(MultiPaxosService.ACCEPT, [slot, ballot, cmd], MultiPaxosService.__input_type_info__['Accept'], MultiPaxosService.__output_type_info__['Accept'])
+
+    def async_Decide(__self__, slot, ballot, cmd):
+        return __self__.__clnt__.async_call(MultiPaxosService.DECIDE, [slot, ballot, cmd], MultiPaxosService.__input_type_info__['Decide'], MultiPaxosService.__output_type_info__['Decide'])
+
+    def async_Catchup(__self__, from_slot):
+        return __self__.__clnt__.async_call(MultiPaxosService.CATCHUP, [from_slot], MultiPaxosService.__input_type_info__['Catchup'], MultiPaxosService.__output_type_info__['Catchup'])
+
+    def sync_Forward(__self__, cmd):
+        __result__ = __self__.__clnt__.sync_call(MultiPaxosService.FORWARD, [cmd], MultiPaxosService.__input_type_info__['Forward'], MultiPaxosService.__output_type_info__['Forward'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_Prepare(__self__, slot, ballot):
+        __result__ = __self__.__clnt__.sync_call(MultiPaxosService.PREPARE, [slot, ballot], MultiPaxosService.__input_type_info__['Prepare'], MultiPaxosService.__output_type_info__['Prepare'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_Accept(__self__, slot, ballot, cmd):
+        __result__ = __self__.__clnt__.sync_call(MultiPaxosService.ACCEPT, [slot, ballot, cmd], MultiPaxosService.__input_type_info__['Accept'], MultiPaxosService.__output_type_info__['Accept'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_Decide(__self__, slot, ballot, cmd):
+        __result__ = __self__.__clnt__.sync_call(MultiPaxosService.DECIDE, [slot, ballot, cmd], MultiPaxosService.__input_type_info__['Decide'], MultiPaxosService.__output_type_info__['Decide'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_Catchup(__self__, from_slot):
+        __result__ = __self__.__clnt__.sync_call(MultiPaxosService.CATCHUP, [from_slot], MultiPaxosService.__input_type_info__['Catchup'], MultiPaxosService.__output_type_info__['Catchup'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+class ClassicService(object):
+    MSGSTRING = 0x4bac9f34
+    MSGMARSHALL = 0x18b70eda
+    DISPATCH = 0x622f0191
+    PREPARE = 0x4d4aa006
+    COMMIT = 0x227deef2
+    ABORT = 0x56700762
+    UPGRADEEPOCH = 0x188c3409
+    TRUNCATEEPOCH = 0x5f1f5db7
+    RPC_NULL = 0x2994570d
+    TAPIRACCEPT = 0x2784bfc6
+    TAPIRFASTACCEPT = 0x575a02fa
+    TAPIRDECIDE = 0x64e0ff8d
+    RCCDISPATCH = 0x595bdd64
+    RCCFINISH = 0x30de7693
+    RCCINQUIRE = 0x6166173c
+    RCCDISPATCHRO = 0x10923a78
+    JANUSDISPATCH = 0x5d4f0528
+    JANUSCOMMIT = 0x5a9029d3
+    JANUSCOMMITWOGRAPH = 0x2a97379c
+    JANUSINQUIRE = 0x2910ab78
+    JANUSPREACCEPT = 0x383abc05
+    JANUSPREACCEPTWOGRAPH = 0x5d0512a1
+    JANUSACCEPT = 0x5b1ca53c
+    PREACCEPTFEBRUUS = 0x62f146c5
+    ACCEPTFEBRUUS = 0x598f6a33
+    COMMITFEBRUUS = 0x2eb097db
+
+    __input_type_info__ = {
+        'MsgString': ['std::string'],
+        'MsgMarshall': ['MarshallDeputy'],
+        'Dispatch': ['rrr::i64','MarshallDeputy'],
+        'Prepare': ['rrr::i64','std::vector<rrr::i32>'],
+        'Commit': ['rrr::i64'],
+        'Abort': ['rrr::i64'],
+        'UpgradeEpoch': ['uint32_t'],
+        'TruncateEpoch': ['uint32_t'],
+        'rpc_null': [],
+        'TapirAccept': ['uint64_t','int64_t','int32_t'],
+        'TapirFastAccept': ['uint64_t','std::vector<SimpleCommand>'],
+        'TapirDecide': ['uint64_t','rrr::i32'],
+        'RccDispatch': ['std::vector<SimpleCommand>'],
+        'RccFinish': ['cmdid_t','MarshallDeputy'],
+        'RccInquire': ['epoch_t','txnid_t'],
+        'RccDispatchRo': ['SimpleCommand'],
+        'JanusDispatch': ['std::vector<SimpleCommand>'],
+        'JanusCommit': ['cmdid_t','MarshallDeputy'],
+        'JanusCommitWoGraph': ['cmdid_t'],
+        'JanusInquire': ['epoch_t','txnid_t'],
+        'JanusPreAccept': ['cmdid_t','std::vector<SimpleCommand>','MarshallDeputy'],
+        'JanusPreAcceptWoGraph': ['cmdid_t','std::vector<SimpleCommand>'],
+        'JanusAccept': ['cmdid_t','ballot_t','MarshallDeputy'],
+        'PreAcceptFebruus': ['txid_t'],
+        'AcceptFebruus': ['txid_t','ballot_t','uint64_t'],
+        'CommitFebruus': ['txid_t','uint64_t'],
+    }
+
+    __output_type_info__ = {
+        'MsgString': ['std::string'],
+        'MsgMarshall': ['MarshallDeputy'],
+        'Dispatch': ['rrr::i32','TxnOutput'],
+        'Prepare': ['rrr::i32'],
+        'Commit': ['rrr::i32'],
+        'Abort': ['rrr::i32'],
+        'UpgradeEpoch': ['int32_t'],
+        'TruncateEpoch': [],
+        'rpc_null': [],
+        'TapirAccept': [],
+        'TapirFastAccept': ['rrr::i32'],
+        'TapirDecide': [],
+        'RccDispatch': ['rrr::i32','TxnOutput','MarshallDeputy'],
+        'RccFinish': ['std::map<uint32_t, std::map<int32_t, Value>>'],
+        'RccInquire': ['MarshallDeputy'],
+        'RccDispatchRo': ['std::map<rrr::i32, Value>'],
+        'JanusDispatch': ['rrr::i32','TxnOutput','MarshallDeputy'],
+        'JanusCommit': ['int32_t','TxnOutput'],
+        'JanusCommitWoGraph': ['int32_t','TxnOutput'],
+        'JanusInquire': ['MarshallDeputy'],
+        'JanusPreAccept': ['rrr::i32','MarshallDeputy'],
+        'JanusPreAcceptWoGraph': ['rrr::i32','MarshallDeputy'],
+        'JanusAccept': ['rrr::i32'],
+        'PreAcceptFebruus': ['rrr::i32','uint64_t'],
+        'AcceptFebruus': ['rrr::i32'],
+        'CommitFebruus': ['rrr::i32'],
+    }
+
+    def __bind_helper__(self, func):
+        def f(*args):
+            return getattr(self, func.__name__)(*args)
+        return f
+
+    def __reg_to__(self, server):
+        server.__reg_func__(ClassicService.MSGSTRING, self.__bind_helper__(self.MsgString), ['std::string'], ['std::string'])
+        server.__reg_func__(ClassicService.MSGMARSHALL, self.__bind_helper__(self.MsgMarshall), ['MarshallDeputy'], ['MarshallDeputy'])
+        server.__reg_func__(ClassicService.DISPATCH, self.__bind_helper__(self.Dispatch), ['rrr::i64','MarshallDeputy'], ['rrr::i32','TxnOutput'])
+        server.__reg_func__(ClassicService.PREPARE, self.__bind_helper__(self.Prepare), ['rrr::i64','std::vector<rrr::i32>'], ['rrr::i32'])
+        server.__reg_func__(ClassicService.COMMIT, self.__bind_helper__(self.Commit), ['rrr::i64'], ['rrr::i32'])
+        server.__reg_func__(ClassicService.ABORT, self.__bind_helper__(self.Abort), ['rrr::i64'], ['rrr::i32'])
+        server.__reg_func__(ClassicService.UPGRADEEPOCH, self.__bind_helper__(self.UpgradeEpoch), ['uint32_t'], ['int32_t'])
+        server.__reg_func__(ClassicService.TRUNCATEEPOCH, self.__bind_helper__(self.TruncateEpoch), ['uint32_t'], [])
+        server.__reg_func__(ClassicService.RPC_NULL, self.__bind_helper__(self.rpc_null), [], [])
+        server.__reg_func__(ClassicService.TAPIRACCEPT, self.__bind_helper__(self.TapirAccept), ['uint64_t','int64_t','int32_t'], [])
+        server.__reg_func__(ClassicService.TAPIRFASTACCEPT, self.__bind_helper__(self.TapirFastAccept), ['uint64_t','std::vector<SimpleCommand>'], ['rrr::i32'])
+        server.__reg_func__(ClassicService.TAPIRDECIDE, self.__bind_helper__(self.TapirDecide), ['uint64_t','rrr::i32'], [])
+        server.__reg_func__(ClassicService.RCCDISPATCH, self.__bind_helper__(self.RccDispatch), ['std::vector<SimpleCommand>'], ['rrr::i32','TxnOutput','MarshallDeputy'])
+        server.__reg_func__(ClassicService.RCCFINISH, self.__bind_helper__(self.RccFinish), ['cmdid_t','MarshallDeputy'], ['std::map<uint32_t, std::map<int32_t, Value>>'])
+        server.__reg_func__(ClassicService.RCCINQUIRE, self.__bind_helper__(self.RccInquire), ['epoch_t','txnid_t'], ['MarshallDeputy'])
+        server.__reg_func__(ClassicService.RCCDISPATCHRO, self.__bind_helper__(self.RccDispatchRo), ['SimpleCommand'], ['std::map<rrr::i32, Value>'])
+        server.__reg_func__(ClassicService.JANUSDISPATCH, self.__bind_helper__(self.JanusDispatch), ['std::vector<SimpleCommand>'], ['rrr::i32','TxnOutput','MarshallDeputy'])
+        server.__reg_func__(ClassicService.JANUSCOMMIT, self.__bind_helper__(self.JanusCommit), ['cmdid_t','MarshallDeputy'], ['int32_t','TxnOutput'])
+        server.__reg_func__(ClassicService.JANUSCOMMITWOGRAPH, self.__bind_helper__(self.JanusCommitWoGraph), ['cmdid_t'], ['int32_t','TxnOutput'])
+        server.__reg_func__(ClassicService.JANUSINQUIRE, self.__bind_helper__(self.JanusInquire), ['epoch_t','txnid_t'], ['MarshallDeputy'])
+        server.__reg_func__(ClassicService.JANUSPREACCEPT, self.__bind_helper__(self.JanusPreAccept), ['cmdid_t','std::vector<SimpleCommand>','MarshallDeputy'], ['rrr::i32','MarshallDeputy'])
+        server.__reg_func__(ClassicService.JANUSPREACCEPTWOGRAPH, self.__bind_helper__(self.JanusPreAcceptWoGraph), ['cmdid_t','std::vector<SimpleCommand>'], ['rrr::i32','MarshallDeputy'])
+        server.__reg_func__(ClassicService.JANUSACCEPT, self.__bind_helper__(self.JanusAccept), ['cmdid_t','ballot_t','MarshallDeputy'], ['rrr::i32'])
+        server.__reg_func__(ClassicService.PREACCEPTFEBRUUS, self.__bind_helper__(self.PreAcceptFebruus), ['txid_t'], ['rrr::i32','uint64_t'])
+        server.__reg_func__(ClassicService.ACCEPTFEBRUUS, self.__bind_helper__(self.AcceptFebruus), ['txid_t','ballot_t','uint64_t'], ['rrr::i32'])
+        server.__reg_func__(ClassicService.COMMITFEBRUUS, self.__bind_helper__(self.CommitFebruus), ['txid_t','uint64_t'], ['rrr::i32'])
+
+    def MsgString(__self__, arg):
+        raise NotImplementedError('subclass ClassicService and implement your own MsgString function')
+
+    def MsgMarshall(__self__, arg):
+        raise NotImplementedError('subclass ClassicService and implement your own MsgMarshall function')
+
+    def Dispatch(__self__, tid, cmd):
+        raise NotImplementedError('subclass ClassicService and implement your own Dispatch function')
+
+    def Prepare(__self__, tid, sids):
+        raise NotImplementedError('subclass ClassicService and implement your own Prepare function')
+
+    def Commit(__self__, tid):
+        raise NotImplementedError('subclass ClassicService and implement your own Commit function')
+
+    def Abort(__self__, tid):
+        raise NotImplementedError('subclass ClassicService and implement your own Abort function')
+
+    def UpgradeEpoch(__self__, curr_epoch):
+        raise NotImplementedError('subclass ClassicService and implement your own UpgradeEpoch function')
+
+    def TruncateEpoch(__self__, old_epoch):
+        raise NotImplementedError('subclass ClassicService and implement your own TruncateEpoch function')
+
+    def rpc_null(__self__):
+        raise NotImplementedError('subclass ClassicService and implement your own rpc_null function')
+
+    def TapirAccept(__self__, cmd_id, ballot, decision):
+        raise NotImplementedError('subclass ClassicService and implement your own TapirAccept function')
+
+    def TapirFastAccept(__self__, cmd_id, txn_cmds):
+        raise NotImplementedError('subclass ClassicService and implement your own TapirFastAccept function')
+
+    def TapirDecide(__self__, cmd_id, commit):
+        raise NotImplementedError('subclass ClassicService and implement your own TapirDecide function')
+
+    def RccDispatch(__self__, cmd):
+        raise NotImplementedError('subclass ClassicService and implement your own RccDispatch function')
+
+    def RccFinish(__self__, id, md_graph):
+        raise NotImplementedError('subclass ClassicService and implement your own RccFinish function')
+
+    def RccInquire(__self__, epoch, txn_id):
+        raise NotImplementedError('subclass ClassicService and implement your own RccInquire function')
+
+    def RccDispatchRo(__self__, cmd):
+        raise NotImplementedError('subclass ClassicService and implement your own RccDispatchRo function')
+
+    def JanusDispatch(__self__, cmd):
+        raise NotImplementedError('subclass ClassicService and implement your own JanusDispatch function')
+
+    def JanusCommit(__self__, id, graph):
+        raise NotImplementedError('subclass ClassicService and implement your own JanusCommit function')
+
+    def JanusCommitWoGraph(__self__, id):
+        raise NotImplementedError('subclass ClassicService and implement your own JanusCommitWoGraph function')
+
+    def JanusInquire(__self__, epoch, txn_id):
+        raise NotImplementedError('subclass ClassicService and implement your own JanusInquire function')
+
+    def JanusPreAccept(__self__, txn_id, cmd, graph):
+        raise NotImplementedError('subclass ClassicService and implement your own JanusPreAccept function')
+
+    def JanusPreAcceptWoGraph(__self__, txn_id, cmd):
+        raise NotImplementedError('subclass ClassicService and implement your own JanusPreAcceptWoGraph function')
+
+    def JanusAccept(__self__, txn_id, ballot, graph):
+        raise NotImplementedError('subclass ClassicService and implement your own JanusAccept function')
+
+    def PreAcceptFebruus(__self__, tx_id):
+        raise NotImplementedError('subclass ClassicService and implement your own PreAcceptFebruus function')
+
+    def AcceptFebruus(__self__, tx_id, ballot, timestamp):
+        raise NotImplementedError('subclass ClassicService and implement your own AcceptFebruus function')
+
+    def CommitFebruus(__self__, tx_id, timestamp):
+        raise NotImplementedError('subclass ClassicService and implement your own CommitFebruus function')
+
+class ClassicProxy(object):
+    def __init__(self, clnt):
+        self.__clnt__ = clnt
+
+    def async_MsgString(__self__, arg):
+        return __self__.__clnt__.async_call(ClassicService.MSGSTRING, [arg], ClassicService.__input_type_info__['MsgString'], ClassicService.__output_type_info__['MsgString'])
+
+    def async_MsgMarshall(__self__, arg):
+        return __self__.__clnt__.async_call(ClassicService.MSGMARSHALL, [arg], ClassicService.__input_type_info__['MsgMarshall'], ClassicService.__output_type_info__['MsgMarshall'])
+
+    def async_Dispatch(__self__, tid, cmd):
+        return __self__.__clnt__.async_call(ClassicService.DISPATCH, [tid, cmd], ClassicService.__input_type_info__['Dispatch'], ClassicService.__output_type_info__['Dispatch'])
+
+    def async_Prepare(__self__, tid, sids):
+        return __self__.__clnt__.async_call(ClassicService.PREPARE, [tid, sids], ClassicService.__input_type_info__['Prepare'], ClassicService.__output_type_info__['Prepare'])
+
+    def async_Commit(__self__, tid):
+        return __self__.__clnt__.async_call(ClassicService.COMMIT, [tid], ClassicService.__input_type_info__['Commit'], ClassicService.__output_type_info__['Commit'])
+
+    def async_Abort(__self__, tid):
+        return __self__.__clnt__.async_call(ClassicService.ABORT, [tid], ClassicService.__input_type_info__['Abort'], ClassicService.__output_type_info__['Abort'])
+
+    def async_UpgradeEpoch(__self__, curr_epoch):
+        return __self__.__clnt__.async_call(ClassicService.UPGRADEEPOCH, [curr_epoch], ClassicService.__input_type_info__['UpgradeEpoch'], ClassicService.__output_type_info__['UpgradeEpoch'])
+
+    def async_TruncateEpoch(__self__, old_epoch):
+        return __self__.__clnt__.async_call(ClassicService.TRUNCATEEPOCH, [old_epoch], ClassicService.__input_type_info__['TruncateEpoch'], ClassicService.__output_type_info__['TruncateEpoch'])
+
+    def async_rpc_null(__self__):
+        return __self__.__clnt__.async_call(ClassicService.RPC_NULL, [], ClassicService.__input_type_info__['rpc_null'], ClassicService.__output_type_info__['rpc_null'])
+
+    def async_TapirAccept(__self__, cmd_id, ballot, decision):
+        return __self__.__clnt__.async_call(ClassicService.TAPIRACCEPT, [cmd_id, ballot, decision], ClassicService.__input_type_info__['TapirAccept'], ClassicService.__output_type_info__['TapirAccept'])
+
+    def async_TapirFastAccept(__self__, cmd_id, txn_cmds):
+        return __self__.__clnt__.async_call(ClassicService.TAPIRFASTACCEPT, [cmd_id, txn_cmds], ClassicService.__input_type_info__['TapirFastAccept'], ClassicService.__output_type_info__['TapirFastAccept'])
+
+    def async_TapirDecide(__self__, cmd_id, commit):
+        return __self__.__clnt__.async_call(ClassicService.TAPIRDECIDE, [cmd_id, commit], ClassicService.__input_type_info__['TapirDecide'], ClassicService.__output_type_info__['TapirDecide'])
+
+    def async_RccDispatch(__self__, cmd):
+        return __self__.__clnt__.async_call(ClassicService.RCCDISPATCH, [cmd], ClassicService.__input_type_info__['RccDispatch'], ClassicService.__output_type_info__['RccDispatch'])
+
+    def async_RccFinish(__self__, id, md_graph):
+        return __self__.__clnt__.async_call(ClassicService.RCCFINISH, [id, md_graph], ClassicService.__input_type_info__['RccFinish'], ClassicService.__output_type_info__['RccFinish'])
+
+    def async_RccInquire(__self__, epoch, txn_id):
+        return __self__.__clnt__.async_call(ClassicService.RCCINQUIRE, [epoch, txn_id], ClassicService.__input_type_info__['RccInquire'], ClassicService.__output_type_info__['RccInquire'])
+
+    def async_RccDispatchRo(__self__, cmd):
+        return __self__.__clnt__.async_call(ClassicService.RCCDISPATCHRO, [cmd], ClassicService.__input_type_info__['RccDispatchRo'], ClassicService.__output_type_info__['RccDispatchRo'])
+
+    def async_JanusDispatch(__self__, cmd):
+        return __self__.__clnt__.async_call(ClassicService.JANUSDISPATCH, [cmd], ClassicService.__input_type_info__['JanusDispatch'], ClassicService.__output_type_info__['JanusDispatch'])
+
+    def async_JanusCommit(__self__, id, graph):
+        return __self__.__clnt__.async_call(ClassicService.JANUSCOMMIT, [id, graph], ClassicService.__input_type_info__['JanusCommit'], ClassicService.__output_type_info__['JanusCommit'])
+
+    def async_JanusCommitWoGraph(__self__, id):
+        return __self__.__clnt__.async_call(ClassicService.JANUSCOMMITWOGRAPH, [id], ClassicService.__input_type_info__['JanusCommitWoGraph'], ClassicService.__output_type_info__['JanusCommitWoGraph'])
+
+    def async_JanusInquire(__self__, epoch, txn_id):
+        return __self__.__clnt__.async_call(ClassicService.JANUSINQUIRE, [epoch, txn_id], ClassicService.__input_type_info__['JanusInquire'], ClassicService.__output_type_info__['JanusInquire'])
+
+    def async_JanusPreAccept(__self__, txn_id, cmd, graph):
+        return __self__.__clnt__.async_call(ClassicService.JANUSPREACCEPT, [txn_id, cmd, graph], ClassicService.__input_type_info__['JanusPreAccept'], ClassicService.__output_type_info__['JanusPreAccept'])
+
+    def async_JanusPreAcceptWoGraph(__self__, txn_id, cmd):
+        return __self__.__clnt__.async_call(ClassicService.JANUSPREACCEPTWOGRAPH, [txn_id, cmd], ClassicService.__input_type_info__['JanusPreAcceptWoGraph'], ClassicService.__output_type_info__['JanusPreAcceptWoGraph'])
+
+    def async_JanusAccept(__self__, txn_id, ballot, graph):
+        return __self__.__clnt__.async_call(ClassicService.JANUSACCEPT, [txn_id, ballot, graph], ClassicService.__input_type_info__['JanusAccept'], ClassicService.__output_type_info__['JanusAccept'])
+
+    def async_PreAcceptFebruus(__self__, tx_id):
+        return __self__.__clnt__.async_call(ClassicService.PREACCEPTFEBRUUS, [tx_id], ClassicService.__input_type_info__['PreAcceptFebruus'], ClassicService.__output_type_info__['PreAcceptFebruus'])
+
+    def async_AcceptFebruus(__self__, tx_id, ballot, timestamp):
+        return __self__.__clnt__.async_call(ClassicService.ACCEPTFEBRUUS, [tx_id, ballot, timestamp], ClassicService.__input_type_info__['AcceptFebruus'], ClassicService.__output_type_info__['AcceptFebruus'])
+
+    def async_CommitFebruus(__self__, tx_id, timestamp):
+        return __self__.__clnt__.async_call(ClassicService.COMMITFEBRUUS, [tx_id, timestamp], ClassicService.__input_type_info__['CommitFebruus'], ClassicService.__output_type_info__['CommitFebruus'])
+
+    def sync_MsgString(__self__, arg):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.MSGSTRING, [arg], ClassicService.__input_type_info__['MsgString'], ClassicService.__output_type_info__['MsgString'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_MsgMarshall(__self__, arg):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.MSGMARSHALL, [arg], ClassicService.__input_type_info__['MsgMarshall'], ClassicService.__output_type_info__['MsgMarshall'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_Dispatch(__self__, tid, cmd):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.DISPATCH, [tid, cmd], ClassicService.__input_type_info__['Dispatch'], ClassicService.__output_type_info__['Dispatch'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_Prepare(__self__, tid, sids):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.PREPARE, [tid, sids], ClassicService.__input_type_info__['Prepare'], ClassicService.__output_type_info__['Prepare'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_Commit(__self__, tid):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.COMMIT, [tid], ClassicService.__input_type_info__['Commit'], ClassicService.__output_type_info__['Commit'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_Abort(__self__, tid):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.ABORT, [tid], ClassicService.__input_type_info__['Abort'], ClassicService.__output_type_info__['Abort'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_UpgradeEpoch(__self__, curr_epoch):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.UPGRADEEPOCH, [curr_epoch], ClassicService.__input_type_info__['UpgradeEpoch'], ClassicService.__output_type_info__['UpgradeEpoch'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_TruncateEpoch(__self__, old_epoch):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.TRUNCATEEPOCH, [old_epoch], ClassicService.__input_type_info__['TruncateEpoch'], ClassicService.__output_type_info__['TruncateEpoch'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_rpc_null(__self__):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.RPC_NULL, [], ClassicService.__input_type_info__['rpc_null'], ClassicService.__output_type_info__['rpc_null'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_TapirAccept(__self__, cmd_id, ballot, decision):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.TAPIRACCEPT, [cmd_id, ballot, decision], ClassicService.__input_type_info__['TapirAccept'], ClassicService.__output_type_info__['TapirAccept'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_TapirFastAccept(__self__, cmd_id, txn_cmds):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.TAPIRFASTACCEPT, [cmd_id, txn_cmds], ClassicService.__input_type_info__['TapirFastAccept'], ClassicService.__output_type_info__['TapirFastAccept'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_TapirDecide(__self__, cmd_id, commit):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.TAPIRDECIDE, [cmd_id, commit], ClassicService.__input_type_info__['TapirDecide'], ClassicService.__output_type_info__['TapirDecide'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_RccDispatch(__self__, cmd):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.RCCDISPATCH, [cmd], ClassicService.__input_type_info__['RccDispatch'], ClassicService.__output_type_info__['RccDispatch'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_RccFinish(__self__, id, md_graph):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.RCCFINISH, [id, md_graph], ClassicService.__input_type_info__['RccFinish'], ClassicService.__output_type_info__['RccFinish'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_RccInquire(__self__, epoch, txn_id):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.RCCINQUIRE, [epoch, txn_id], ClassicService.__input_type_info__['RccInquire'], ClassicService.__output_type_info__['RccInquire'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_RccDispatchRo(__self__, cmd):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.RCCDISPATCHRO, [cmd], ClassicService.__input_type_info__['RccDispatchRo'], ClassicService.__output_type_info__['RccDispatchRo'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_JanusDispatch(__self__, cmd):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.JANUSDISPATCH, [cmd], ClassicService.__input_type_info__['JanusDispatch'], ClassicService.__output_type_info__['JanusDispatch'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_JanusCommit(__self__, id, graph):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.JANUSCOMMIT, [id, graph], ClassicService.__input_type_info__['JanusCommit'], ClassicService.__output_type_info__['JanusCommit'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_JanusCommitWoGraph(__self__, id):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.JANUSCOMMITWOGRAPH, [id], ClassicService.__input_type_info__['JanusCommitWoGraph'], ClassicService.__output_type_info__['JanusCommitWoGraph'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_JanusInquire(__self__, epoch, txn_id):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.JANUSINQUIRE, [epoch, txn_id], ClassicService.__input_type_info__['JanusInquire'], ClassicService.__output_type_info__['JanusInquire'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_JanusPreAccept(__self__, txn_id, cmd, graph):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.JANUSPREACCEPT, [txn_id, cmd, graph], ClassicService.__input_type_info__['JanusPreAccept'], ClassicService.__output_type_info__['JanusPreAccept'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_JanusPreAcceptWoGraph(__self__, txn_id, cmd):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.JANUSPREACCEPTWOGRAPH, [txn_id, cmd], ClassicService.__input_type_info__['JanusPreAcceptWoGraph'], ClassicService.__output_type_info__['JanusPreAcceptWoGraph'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_JanusAccept(__self__, txn_id, ballot, graph):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.JANUSACCEPT, [txn_id, ballot, graph], ClassicService.__input_type_info__['JanusAccept'], ClassicService.__output_type_info__['JanusAccept'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_PreAcceptFebruus(__self__, tx_id):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.PREACCEPTFEBRUUS, [tx_id], ClassicService.__input_type_info__['PreAcceptFebruus'], ClassicService.__output_type_info__['PreAcceptFebruus'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_AcceptFebruus(__self__, tx_id, ballot, timestamp):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.ACCEPTFEBRUUS, [tx_id, ballot, timestamp], ClassicService.__input_type_info__['AcceptFebruus'], ClassicService.__output_type_info__['AcceptFebruus'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_CommitFebruus(__self__, tx_id, timestamp):
+        __result__ = __self__.__clnt__.sync_call(ClassicService.COMMITFEBRUUS, [tx_id, timestamp], ClassicService.__input_type_info__['CommitFebruus'], ClassicService.__output_type_info__['CommitFebruus'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+class ServerControlService(object):
+    SERVER_SHUTDOWN = 0x219991a3
+    SERVER_READY = 0x65986b21
+    SERVER_HEART_BEAT_WITH_DATA = 0x3c56f1ab
+    SERVER_HEART_BEAT = 0x4b321d2e
+
+    __input_type_info__ = {
+        'server_shutdown': [],
+        'server_ready': [],
+        'server_heart_beat_with_data': [],
+        'server_heart_beat': [],
+    }
+
+    __output_type_info__ = {
+        'server_shutdown': [],
+        'server_ready': ['rrr::i32'],
+        'server_heart_beat_with_data': ['ServerResponse'],
+        'server_heart_beat': [],
+    }
+
+    def __bind_helper__(self, func):
+        def f(*args):
+            return getattr(self, func.__name__)(*args)
+        return f
+
+    def __reg_to__(self, server):
+        server.__reg_func__(ServerControlService.SERVER_SHUTDOWN, self.__bind_helper__(self.server_shutdown), [], [])
+        server.__reg_func__(ServerControlService.SERVER_READY, self.__bind_helper__(self.server_ready), [], ['rrr::i32'])
+        server.__reg_func__(ServerControlService.SERVER_HEART_BEAT_WITH_DATA, self.__bind_helper__(self.server_heart_beat_with_data), [], ['ServerResponse'])
+        server.__reg_func__(ServerControlService.SERVER_HEART_BEAT, self.__bind_helper__(self.server_heart_beat), [], [])
+
+    def server_shutdown(__self__):
+        raise NotImplementedError('subclass ServerControlService and implement your own server_shutdown function')
+
+    def server_ready(__self__):
+        raise NotImplementedError('subclass ServerControlService and implement your own server_ready function')
+
+    def server_heart_beat_with_data(__self__):
+        raise NotImplementedError('subclass ServerControlService and implement your own server_heart_beat_with_data function')
+
+    def server_heart_beat(__self__):
+        raise NotImplementedError('subclass ServerControlService and implement your own server_heart_beat function')
+
+class ServerControlProxy(object):
+    def __init__(self, clnt):
+        self.__clnt__ = clnt
+
+    def async_server_shutdown(__self__):
+        return __self__.__clnt__.async_call(ServerControlService.SERVER_SHUTDOWN, [], ServerControlService.__input_type_info__['server_shutdown'], ServerControlService.__output_type_info__['server_shutdown'])
+
+    def async_server_ready(__self__):
+        return __self__.__clnt__.async_call(ServerControlService.SERVER_READY, [], ServerControlService.__input_type_info__['server_ready'], ServerControlService.__output_type_info__['server_ready'])
+
+    def async_server_heart_beat_with_data(__self__):
+        return __self__.__clnt__.async_call(ServerControlService.SERVER_HEART_BEAT_WITH_DATA, [], ServerControlService.__input_type_info__['server_heart_beat_with_data'], ServerControlService.__output_type_info__['server_heart_beat_with_data'])
+
+    def async_server_heart_beat(__self__):
+        return __self__.__clnt__.async_call(ServerControlService.SERVER_HEART_BEAT, [], ServerControlService.__input_type_info__['server_heart_beat'], ServerControlService.__output_type_info__['server_heart_beat'])
+
+    def sync_server_shutdown(__self__):
+        __result__ = __self__.__clnt__.sync_call(ServerControlService.SERVER_SHUTDOWN, [], ServerControlService.__input_type_info__['server_shutdown'], ServerControlService.__output_type_info__['server_shutdown'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_server_ready(__self__):
+        __result__ = __self__.__clnt__.sync_call(ServerControlService.SERVER_READY, [], ServerControlService.__input_type_info__['server_ready'], ServerControlService.__output_type_info__['server_ready'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_server_heart_beat_with_data(__self__):
+        __result__ = __self__.__clnt__.sync_call(ServerControlService.SERVER_HEART_BEAT_WITH_DATA, [], ServerControlService.__input_type_info__['server_heart_beat_with_data'], ServerControlService.__output_type_info__['server_heart_beat_with_data'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_server_heart_beat(__self__):
+        __result__ = __self__.__clnt__.sync_call(ServerControlService.SERVER_HEART_BEAT, [], ServerControlService.__input_type_info__['server_heart_beat'], ServerControlService.__output_type_info__['server_heart_beat'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+class ClientControlService(object):
+    CLIENT_GET_TXN_NAMES = 0x1db91fb0
+    CLIENT_SHUTDOWN = 0x589cca97
+    CLIENT_FORCE_STOP = 0x4d68a35c
+    CLIENT_RESPONSE = 0x1a6deb1b
+    CLIENT_READY = 0x1e124fb6
+    CLIENT_READY_BLOCK = 0x3abbee20
+    CLIENT_START = 0x1f855960
+    DISPATCHTXN = 0x616e6f15
+
+    __input_type_info__ = {
+        'client_get_txn_names': [],
+        'client_shutdown': [],
+        'client_force_stop': [],
+        'client_response': [],
+        'client_ready': [],
+        'client_ready_block': [],
+        'client_start': [],
+        'DispatchTxn': ['TxDispatchRequest'],
+    }
+
+    __output_type_info__ = {
+        'client_get_txn_names': ['std::map<rrr::i32, std::string>'],
+        'client_shutdown': [],
+        'client_force_stop': [],
+        'client_response': ['ClientResponse'],
+        'client_ready': ['rrr::i32'],
+        'client_ready_block': ['rrr::i32'],
+        'client_start': [],
+        'DispatchTxn': ['TxReply'],
+    }
+
+    def __bind_helper__(self, func):
+        def f(*args):
+            return getattr(self, func.__name__)(*args)
+        return f
+
+    def __reg_to__(self, server):
+        server.__reg_func__(ClientControlService.CLIENT_GET_TXN_NAMES, self.__bind_helper__(self.client_get_txn_names), [], ['std::map<rrr::i32, std::string>'])
+        server.__reg_func__(ClientControlService.CLIENT_SHUTDOWN, self.__bind_helper__(self.client_shutdown), [], [])
+        server.__reg_func__(ClientControlService.CLIENT_FORCE_STOP, self.__bind_helper__(self.client_force_stop), [], [])
+        server.__reg_func__(ClientControlService.CLIENT_RESPONSE, self.__bind_helper__(self.client_response), [], ['ClientResponse'])
+        server.__reg_func__(ClientControlService.CLIENT_READY, self.__bind_helper__(self.client_ready), [], ['rrr::i32'])
+        server.__reg_func__(ClientControlService.CLIENT_READY_BLOCK, self.__bind_helper__(self.client_ready_block), [], ['rrr::i32'])
+        server.__reg_func__(ClientControlService.CLIENT_START, self.__bind_helper__(self.client_start), [], [])
+        server.__reg_func__(ClientControlService.DISPATCHTXN, self.__bind_helper__(self.DispatchTxn), ['TxDispatchRequest'], ['TxReply'])
+
+    def client_get_txn_names(__self__):
+        raise NotImplementedError('subclass ClientControlService and implement your own client_get_txn_names function')
+
+    def client_shutdown(__self__):
+        raise NotImplementedError('subclass ClientControlService and implement your own client_shutdown function')
+
+    def client_force_stop(__self__):
+        raise NotImplementedError('subclass ClientControlService and implement your own client_force_stop function')
+
+    def client_response(__self__):
+        raise NotImplementedError('subclass ClientControlService and implement your own client_response function')
+
+    def client_ready(__self__):
+        raise NotImplementedError('subclass ClientControlService and implement your own client_ready function')
+
+    def client_ready_block(__self__):
+        raise NotImplementedError('subclass ClientControlService and implement your own client_ready_block function')
+
+    def client_start(__self__):
+        raise NotImplementedError('subclass ClientControlService and implement your own client_start function')
+
+    def DispatchTxn(__self__, req):
+        raise NotImplementedError('subclass ClientControlService and implement your own DispatchTxn function')
+
+class ClientControlProxy(object):
+    def __init__(self, clnt):
+        self.__clnt__ = clnt
+
+    def async_client_get_txn_names(__self__):
+        return __self__.__clnt__.async_call(ClientControlService.CLIENT_GET_TXN_NAMES, [], ClientControlService.__input_type_info__['client_get_txn_names'], ClientControlService.__output_type_info__['client_get_txn_names'])
+
+    def async_client_shutdown(__self__):
+        return __self__.__clnt__.async_call(ClientControlService.CLIENT_SHUTDOWN, [], ClientControlService.__input_type_info__['client_shutdown'], ClientControlService.__output_type_info__['client_shutdown'])
+
+    def async_client_force_stop(__self__):
+        return __self__.__clnt__.async_call(ClientControlService.CLIENT_FORCE_STOP, [], ClientControlService.__input_type_info__['client_force_stop'], ClientControlService.__output_type_info__['client_force_stop'])
+
+    def async_client_response(__self__):
+        return __self__.__clnt__.async_call(ClientControlService.CLIENT_RESPONSE, [], ClientControlService.__input_type_info__['client_response'], ClientControlService.__output_type_info__['client_response'])
+
+    def async_client_ready(__self__):
+        return __self__.__clnt__.async_call(ClientControlService.CLIENT_READY, [], ClientControlService.__input_type_info__['client_ready'], ClientControlService.__output_type_info__['client_ready'])
+
+    def async_client_ready_block(__self__):
+        return __self__.__clnt__.async_call(ClientControlService.CLIENT_READY_BLOCK, [], ClientControlService.__input_type_info__['client_ready_block'], ClientControlService.__output_type_info__['client_ready_block'])
+
+    def async_client_start(__self__):
+        return __self__.__clnt__.async_call(ClientControlService.CLIENT_START, [], ClientControlService.__input_type_info__['client_start'], ClientControlService.__output_type_info__['client_start'])
+
+    def async_DispatchTxn(__self__, req):
+        return __self__.__clnt__.async_call(ClientControlService.DISPATCHTXN, [req], ClientControlService.__input_type_info__['DispatchTxn'], ClientControlService.__output_type_info__['DispatchTxn'])
+
+    def sync_client_get_txn_names(__self__):
+        __result__ = __self__.__clnt__.sync_call(ClientControlService.CLIENT_GET_TXN_NAMES, [], ClientControlService.__input_type_info__['client_get_txn_names'], ClientControlService.__output_type_info__['client_get_txn_names'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_client_shutdown(__self__):
+        __result__ = __self__.__clnt__.sync_call(ClientControlService.CLIENT_SHUTDOWN, [], ClientControlService.__input_type_info__['client_shutdown'], ClientControlService.__output_type_info__['client_shutdown'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_client_force_stop(__self__):
+        __result__ = __self__.__clnt__.sync_call(ClientControlService.CLIENT_FORCE_STOP, [], ClientControlService.__input_type_info__['client_force_stop'], ClientControlService.__output_type_info__['client_force_stop'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_client_response(__self__):
+        __result__ = __self__.__clnt__.sync_call(ClientControlService.CLIENT_RESPONSE, [], ClientControlService.__input_type_info__['client_response'], ClientControlService.__output_type_info__['client_response'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_client_ready(__self__):
+        __result__ = __self__.__clnt__.sync_call(ClientControlService.CLIENT_READY, [], ClientControlService.__input_type_info__['client_ready'], ClientControlService.__output_type_info__['client_ready'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_client_ready_block(__self__):
+        __result__ = __self__.__clnt__.sync_call(ClientControlService.CLIENT_READY_BLOCK, [], ClientControlService.__input_type_info__['client_ready_block'], ClientControlService.__output_type_info__['client_ready_block'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_client_start(__self__):
+        __result__ = __self__.__clnt__.sync_call(ClientControlService.CLIENT_START, [], ClientControlService.__input_type_info__['client_start'], ClientControlService.__output_type_info__['client_start'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
+    def sync_DispatchTxn(__self__, req):
+        __result__ = __self__.__clnt__.sync_call(ClientControlService.DISPATCHTXN, [req], ClientControlService.__input_type_info__['DispatchTxn'], ClientControlService.__output_type_info__['DispatchTxn'])
+        if __result__[0] != 0:
+            raise Exception("RPC returned non-zero error code %d: %s" % (__result__[0], os.strerror(__result__[0])))
+        if len(__result__[1]) == 1:
+            return __result__[1][0]
+        elif len(__result__[1]) > 1:
+            return __result__[1]
+
@@ -464,6 +464,36 @@ map<txnid_t, shared_ptr<TxRococo>> RccGraph::Aggregate(epoch_t epoch,
   return index;
 }
 
+bool RccGraph::Covers(RccGraph& known, TxRococo& v) {
+  auto k = known.FindV(v.id());
+  if (k == nullptr) {
+    return false;
+  }
+  if ((v.status() & ~k->status()) != 0) {
+    return false;
+  }
+  return std::includes(k->partition_.begin(), k->partition_.end(),
+                       v.partition_.begin(), v.partition_.end());
+}
+
+shared_ptr<RccGraph> RccGraph::Delta(const vector<shared_ptr<RccGraph>>& acks,
+                                     txnid_t txn_id) {
+  auto delta = std::make_shared<RccGraph>();
+  delta->partial_ = true;
+  for (auto& pair : vertex_index()) {
+    auto& v = pair.second;
+    bool known = std::all_of(acks.begin(),
+                             acks.end(),
+                             [&v](const shared_ptr<RccGraph>& g) -> bool {
+                               return Covers(*g, *v);
+                             });
+    if (!known || pair.first == txn_id) {
+      delta->vertex_index()[pair.first] = v;
+    }
+  }
+  return delta;
+}
+
 bool RccGraph::HasICycle(const RccScc &scc) {
   verify(0);
 //  for (auto& vertex : scc) {
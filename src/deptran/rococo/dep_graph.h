@@ -30,6 +30,8 @@ class RccGraph : public Graph<TxRococo> {
   SchedulerRococo* sched_{nullptr};
   bool empty_{false};
   parid_t partition_id_ = 0; // TODO
+  // made by Delta(), leaves out vertexes the receivers already know.
+  bool partial_{false};
 //  std::vector<rrr::Client *> rpc_clients_;
 //  std::vector<RococoProxy *> rpc_proxies_;
 //  std::vector<std::string> server_addrs_;
@@ -70,6 +72,15 @@ class RccGraph : public Graph<TxRococo> {
 
   bool HasICycle(const RccScc& scc);
 
+  // whether known has the vertex with every status bit and partition v
+  // has, so that aggregating v into it would change nothing.
+  static bool Covers(RccGraph& known, TxRococo& v);
+  // the vertexes of this graph some receiver may not know yet, given the
+  // graphs each of them last replied with, and always that of txn_id. the
+  // vertexes are shared.
+  shared_ptr<RccGraph> Delta(const vector<shared_ptr<RccGraph>>& acks,
+                             txnid_t txn_id);
+
 
 //  Marshal& ToMarshal(Marshal& m) const override;
 //  Marshal& FromMarshal(Marshal& m) override;
@@ -6,18 +6,68 @@
 
 namespace janus {
 
+/**
+ * Parent vertex ids, sorted in a flat vector. A txn has a handful of
+ * parents, so searches walk one array instead of chasing tree nodes.
+ */
+class ParentSet {
+ public:
+  void insert(uint64_t id) {
+    auto it = std::lower_bound(ids_.begin(), ids_.end(), id);
+    if (it == ids_.end() || *it != id) {
+      ids_.insert(it, id);
+    }
+  }
+  template<class It>
+  void insert(It first, It last) {
+    ids_.insert(ids_.end(), first, last);
+    std::sort(ids_.begin(), ids_.end());
+    ids_.erase(std::unique(ids_.begin(), ids_.end()), ids_.end());
+  }
+  size_t count(uint64_t id) const {
+    return std::binary_search(ids_.begin(), ids_.end(), id) ? 1 : 0;
+  }
+  size_t size() const {
+    return ids_.size();
+  }
+  void clear() {
+    ids_.clear();
+  }
+  vector<uint64_t>::const_iterator begin() const {
+    return ids_.begin();
+  }
+  vector<uint64_t>::const_iterator end() const {
+    return ids_.end();
+  }
+  bool operator==(const ParentSet& rhs) const {
+    return ids_ == rhs.ids_;
+  }
+  bool operator!=(const ParentSet& rhs) const {
+    return ids_ != rhs.ids_;
+  }
+
+ private:
+  vector<uint64_t> ids_{};
+};
+
 // This is a CRTP
 template<class T>
 class Vertex {
  private:
 //  std::shared_ptr<T> data_{};
  public:
-  set<uint64_t> parents_{}; // parent vertex ids in the graph.
+  ParentSet parents_{}; // parent vertex ids in the graph.
 //  map<T *, int8_t> outgoing_{}; // helper data structure, deprecated
 //  map<T *, int8_t> incoming_{}; // helper data structure, deprecated
 //  set<T *> removed_children_{}; // helper data structure, deprecated
   bool walked_{false}; // flag for traversing.
   std::shared_ptr<vector<T*>> scc_{nullptr};
+  // Tarjan state of the last FindSccPred that reached this vertex, only
+  // meaningful while dfs_gen_ equals the graph's.
+  uint64_t dfs_gen_{0};
+  int32_t dfs_index_{0};
+  int32_t dfs_lowlink_{0};
+  bool dfs_on_stack_{false};
 
   T *this_pointer() {
     T *ret = static_cast<T *>(this);
@@ -32,9 +82,9 @@ class Vertex {
 //    verify(0);
   }
   virtual ~Vertex() {};
-  set<uint64_t> &GetParentSet() {
+  ParentSet &GetParentSet() {
 #ifdef DEBUG_CODE
-    set<uint64_t> ret;
+    ParentSet ret;
     for (auto& pair : incoming_) {
       ret.insert(pair.first->id());
     }
@@ -78,6 +128,12 @@ class Graph : public Marshallable {
   typedef std::vector<V *> VertexList;
   bool managing_memory_{true};
   std::unordered_map<uint64_t, shared_ptr<V>> vertex_index_{};
+  // searches over the parents reuse these, so they do not allocate once
+  // the vectors have grown.
+  uint64_t dfs_gen_{0};
+  vector<V*> dfs_stack_{};
+  vector<V*> walked_buf_{};
+  bool walking_{false};
 
   virtual std::unordered_map<uint64_t, shared_ptr<V>> &vertex_index() {
     verify(managing_memory_);
@@ -180,24 +236,28 @@ class Graph : public Marshallable {
                    int64_t depth,
                    function<int(V& )> &func,
                    vector<V *> *walked = nullptr) {
-    bool to_clean = false;
-    if (walked == nullptr) {
-      to_clean = true;
-      walked = new vector<V *>;
-      walked->reserve(100);
-    }
     if (vertex.walked_) {
       return true;
     } else {
       vertex.walked_ = true;
     }
+    bool to_clean = false;
+    vector<V *> nested;
+    if (walked == nullptr) {
+      to_clean = true;
+      // a search started from func gets its own list.
+      walked = walking_ ? &nested : &walked_buf_;
+      walking_ = true;
+    }
     walked->push_back(&vertex);
 
+    auto& index = vertex_index();
     int ret = SearchHint::Ok;
     for (auto &pair : vertex.parents_) {
-      auto v = FindV(pair);
+      auto it = index.find(pair);
       // TODO? maybe this could happen for foreign decided?
-      verify(v != nullptr);
+      verify(it != index.end());
+      V* v = it->second.get();
       ret = func(*v);
       if (ret == SearchHint::Exit) {
         break;
@@ -214,9 +274,9 @@ class Graph : public Marshallable {
     if (to_clean) {
       for (V *v: *walked) {
         v->walked_ = false;
-
       }
-      delete walked;
+      walked->clear();
+      walking_ = (walked != &walked_buf_);
     }
     return ret;
   }
@@ -271,46 +331,46 @@ class Graph : public Marshallable {
     return true;
   }
 
-  Scc<V> StrongConnectPred(V& v,
-                           map<V*, int> &indexes,
-                           map<V*, int> &lowlinks,
-                           int &index,
-                           vector<V*> &S) {
-    indexes[&v] = index;
-    lowlinks[&v] = index;
-    index++;
-    S.push_back(&v);
+  // Tarjan's search from v over the parents, with the index, lowlink and
+  // stack flag kept in the vertexes. Sccs closed below v are dropped, the
+  // one of v goes to scc if given.
+  void StrongConnectPred(V& v,
+                         std::unordered_map<uint64_t, shared_ptr<V>> &index,
+                         int &next,
+                         Scc<V> *scc) {
+    v.dfs_gen_ = dfs_gen_;
+    v.dfs_index_ = next;
+    v.dfs_lowlink_ = next;
+    v.dfs_on_stack_ = true;
+    next++;
+    dfs_stack_.push_back(&v);
 
     for (auto &p : v.parents_) {
-      auto w = FindV(p);
-      verify(w != nullptr); // TODO, allow non-existing vertex?
+      auto it = index.find(p);
+      verify(it != index.end()); // TODO, allow non-existing vertex?
+      V* w = it->second.get();
       if (w->scc_) // opt scc already computed
         continue;
 
-      if (indexes.find(w.get()) == indexes.end()) {
-        this->StrongConnectPred(*w, indexes, lowlinks, index, S);
-        lowlinks[&v] = (lowlinks[&v] < lowlinks[w.get()]) ?
-                       lowlinks[&v] : lowlinks[w.get()];
-      } else {
-        for (auto &t : S) {
-          if (t == w.get()) {
-            lowlinks[&v] = lowlinks[&v] < indexes[w.get()] ?
-                           lowlinks[&v] : indexes[w.get()];
-          }
-        }
+      if (w->dfs_gen_ != dfs_gen_) {
+        StrongConnectPred(*w, index, next, nullptr);
+        v.dfs_lowlink_ = std::min(v.dfs_lowlink_, w->dfs_lowlink_);
+      } else if (w->dfs_on_stack_) {
+        v.dfs_lowlink_ = std::min(v.dfs_lowlink_, w->dfs_index_);
       }
     }
 
-    Scc<V> ret;
-    if (lowlinks[&v] == indexes[&v]) {
+    if (v.dfs_lowlink_ == v.dfs_index_) {
       V* w;
       do {
-        w = S.back();
-        S.pop_back();
-        ret.push_back(w);
+        w = dfs_stack_.back();
+        dfs_stack_.pop_back();
+        w->dfs_on_stack_ = false;
+        if (scc != nullptr) {
+          scc->push_back(w);
+        }
       } while (w != &v);
     }
-    return ret;
   }
 
 //  std::vector<V*> StrongConnect(V* v,
@@ -485,12 +545,11 @@ class Graph : public Marshallable {
       // already computed.
       return (Scc<V> &) (*(vertex.scc_));
     }
-    map<V*, int> indexes;
-    map<V*, int> lowlinks;
-    int index = 0;
-    vector<V*> S;
-    shared_ptr<Scc<V>> sp_scc(new Scc<V>);
-    *sp_scc = StrongConnectPred(vertex, indexes, lowlinks, index, S);
+    dfs_gen_++;
+    dfs_stack_.clear();
+    int next = 0;
+    auto sp_scc = std::make_shared<Scc<V>>();
+    StrongConnectPred(vertex, vertex_index(), next, sp_scc.get());
     for (auto v : *sp_scc) {
       verify(!v->scc_); // FIXME
       v->scc_ = sp_scc;
@@ -590,82 +649,42 @@ class Graph : public Marshallable {
     }
   }
 
+  // vertexes in id order, each id as a varint difference from the one
+  // before, so ids of txns from the same coordinator take a byte or two.
   Marshal &ToMarshal(Marshal &m) const override {
     verify(managing_memory_);
-    uint64_t n = size();
-    verify(n >= 0 && n < 10000);
-    m << n;
-    int i = 0;
+    vector<pair<uint64_t, V*>> vs;
+    vs.reserve(size());
     for (auto &pair : const_cast<Graph *>(this)->vertex_index()) {
-      auto &v = pair.second;
-      i++;
-//      int32_t n_out_edge = v->outgoing_.size();
-      m << v->id();
-      m << *v;
-//      m << n_out_edge;
-//      for (auto &it : v->outgoing_) {
-//        V* vv = static_cast<V*>(it.first);
-//        verify(vv != nullptr);
-//        uint64_t id = vv->id();
-//        int8_t weight = it.second;
-//        m << id << weight;
-//      }
+      vs.push_back(std::make_pair(pair.first, pair.second.get()));
+    }
+    std::sort(vs.begin(), vs.end());
+    m << rrr::v64(vs.size());
+    uint64_t prev = 0;
+    for (auto &pair : vs) {
+      m << rrr::v64(pair.first - prev);
+      m << *pair.second;
+      prev = pair.first;
     }
-//    verify(i == n);
     return m;
   }
 
   Marshal &FromMarshal(Marshal &m) override {
     verify(managing_memory_);
     verify(size() == 0);
-    uint64_t n;
+    rrr::v64 n;
     m >> n;
-    verify(n >= 0 && n < 10000);
-    map<uint64_t, shared_ptr<V>> ref;
-//    map<uint64_t, map<int64_t, int8_t> > v_to;
-
-    // Log::debug("marshalling gra, graph size: %d", (int) n);
-
-    int nn = n;
-
-    while (nn-- > 0) {
-      uint64_t v_id;
-      m >> v_id;
-      ref[v_id].reset(new V(v_id)); // TODO? can new RccDTxn?
-      m >> *(ref[v_id]);
-//      int32_t n_out_edge;
-//      m >> n_out_edge;
-//
-//      while (n_out_edge-- > 0) {
-//        uint64_t child_id;
-//        int8_t weight;
-//        m >> child_id;
-//        m >> weight;
-//        v_to[v_id][child_id] = weight;
-//      }
+    verify(n.get() >= 0);
+    uint64_t v_id = 0;
+    for (int64_t i = 0; i < n.get(); i++) {
+      rrr::v64 delta;
+      m >> delta;
+      v_id += delta.get();
+      shared_ptr<V> sp_v(new V(v_id));
+      m >> *sp_v;
+      vertex_index()[v_id] = sp_v;
     }
-    // insert vertexes into graph.
-    verify(ref.size() == n);
-    for (auto &kv : ref) {
-      vertex_index()[kv.first] = kv.second;
-    }
-    // build edge pointers.
-//    for (auto &kv : v_to) {
-//      uint64_t v_id = kv.first;
-//      map<int64_t, int8_t>& o_to = kv.second;
-//      V *v = ref[v_id];
-//
-//      for (auto &tokv : o_to) {
-//        uint64_t child_vid = tokv.first;
-//        int8_t weight = tokv.second;
-//        V *child_v = ref[child_vid];
-//        v->outgoing_[child_v] = weight;
-//        child_v->incoming_[v] = weight;
-//        child_v->parents_.insert(v->id());
-//      }
-//    }
-
-//    verify(size() > 0);
+    verify(size() == (uint64_t) n.get());
     return m;
   }
 };
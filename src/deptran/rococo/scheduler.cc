@@ -184,100 +184,77 @@ void SchedulerRococo::AnswerIfInquired(TxRococo& dtxn) {
   }
 }
 
+// Goes in rounds. A round takes the transactions put on the waitlist since
+// the last one, in txn id order, decides the sccs whose ancestors have all
+// committed, and executes in one batch the sccs whose ancestors have all
+// executed, smallest txn id first. A transaction stopped by an ancestor
+// waits in its to_checks_ and is skipped until that ancestor executes, so
+// the ancestors are not searched again on every round; executing the
+// batch puts the waiting ones into the next round.
 void SchedulerRococo::CheckWaitlist() {
   std::lock_guard<std::recursive_mutex> lock(mtx_);
-#ifdef DEBUG_CODE
-  //  Log_info("start to check waitlist, length: %d, fridge size: %d",
-  //           (int)waitlist_.size(), (int)fridge_.size());
-#endif
-  auto it = waitlist_.begin();
-  while (it != waitlist_.end()) {
-//    Log_info("checking loop, length: %d, fridge size: %d",
-//             (int)waitlist_.¬size(), (int)fridge_.size());
-    auto v = *it;
-    verify(v != nullptr);
-//  for (RccVertex *v : waitlist_) {
-    // TODO minimize the length of the waitlist.
-    InquireAboutIfNeeded(*v); // inquire about unknown transaction.
-    if (v->status() >= TXN_CMT &&
-        !v->IsExecuted()) {
-      if (AllAncCmt(*v)) {
-//        check_again = true;
+  vector<TxRococo*> round;
+  map<txnid_t, RccScc*> ready;
+  while (!waitlist_.empty()) {
+    round.assign(waitlist_.begin(), waitlist_.end());
+    waitlist_.clear();
+    ready.clear();
+    for (auto v : round) {
+      verify(v != nullptr);
+      InquireAboutIfNeeded(*v); // inquire about unknown transaction.
+      if (v->status() >= TXN_CMT &&
+          !v->IsExecuted() &&
+          v->n_blockers_ == 0 &&
+          AllAncCmt(*v)) {
         RccScc& scc = FindSccPred(*v);
         verify(v->epoch_ > 0);
         Decide(scc);
-        if (AllAncFns(scc)) {
-          // FIXME
+        if (AllAncFns(scc) && FullyDispatched(scc)) {
+          txnid_t id = scc[0]->tid_;
           for (auto vv : scc) {
             verify(vv->epoch_ > 0);
-#ifdef DEBUG_CODE
-            verify(AllAncCmt(vv));
-          verify(vv->Get().status() >= TXN_DCD);
-#endif
-//          vv->Get().union_status(TXN_DCD);
-          }
-          if (FullyDispatched(scc)) {
-            Execute(scc);
-            for (auto v : scc) {
-//              AddChildrenIntoWaitlist(v);
-            }
+            id = std::min(id, vv->tid_);
           }
-//        check_again = true;
-        } // else do nothing.
-#ifdef DEBUG_CODE
-        for(auto vv : scc) {
-          auto s = vv->Get().status();
-          verify(s >= TXN_DCD);
+          ready[id] = &scc;
         }
-#endif
-      } else {
-        // else do nothing
-#ifdef DEBUG_CODE
-        //        auto anc_v = __DebugFindAnOngoingAncestor(v);
-        //        RccDTxn& tinfo = *anc_v->data_;
-        //        Log_debug("this transaction has some ongoing ancestors, tid: %llx, "
-        //                      "is_involved: %d, during_inquire: %d, inquire_acked: %d",
-        //                  tinfo.id(),
-        //                  tinfo.Involve(partition_id_),
-        //                  tinfo.during_asking,
-        //                  tinfo.inquire_acked_);
-#endif
       }
       AnswerIfInquired(*v);
-    } // else do nothing
-
-    // Adjust the waitlist.
-    __DebugExamineGraphVerify(*v);
-    if (v->IsExecuted() ||
-        v->IsAborted() ||
-        (v->IsDecided() &&
-            !v->Involve(Scheduler::partition_id_))) {
-      // TODO? check for its descendants, perhaps
-      // add redundant vertex here?
-      //      AddChildrenIntoWaitlist(v);
-      for (auto& vv: v->to_checks_) {
-        waitlist_.insert(vv);
+    }
+    for (auto& pair : ready) {
+      RccScc& scc = *pair.second;
+      Execute(scc);
+      for (auto vv : scc) {
+        ReleaseToChecks(*vv);
       }
-      v->to_checks_.clear();
-//      it = waitlist_.erase(it);
-    } else {
-//      it++;
     }
-#ifdef DEBUG_CODE
-    if (tinfo.IsExecuted()) {
-      fridge_.erase(v);
-    } else {
-      fridge_.insert(v);
-      if (v->Get().status() >= TXN_CMT && AllAncCmt(v)) {
-        verify(v->Get().status() >= TXN_DCD);
+    for (auto v : round) {
+      __DebugExamineGraphVerify(*v);
+      if (v->IsExecuted() ||
+          v->IsAborted() ||
+          (v->IsDecided() &&
+              !v->Involve(Scheduler::partition_id_))) {
+        ReleaseToChecks(*v);
       }
     }
-#endif
-    it = waitlist_.erase(it);
   }
   __DebugExamineFridge();
 }
 
+void SchedulerRococo::WaitFor(TxRococo& ancestor, TxRococo& v) {
+  if (ancestor.to_checks_.insert(&v).second) {
+    v.n_blockers_++;
+  }
+}
+
+void SchedulerRococo::ReleaseToChecks(TxRococo& dtxn) {
+  for (auto v : dtxn.to_checks_) {
+    verify(v->n_blockers_ > 0);
+    v->n_blockers_--;
+    waitlist_.insert(v);
+  }
+  dtxn.to_checks_.clear();
+}
+
 void SchedulerRococo::AddChildrenIntoWaitlist(TxRococo* v) {
   verify(0);
 //  RccDTxn& tinfo = *v;
@@ -413,7 +390,7 @@ TxRococo& SchedulerRococo::__DebugFindAnOngoingAncestor(TxRococo& vertex) {
 bool SchedulerRococo::AllAncCmt(TxRococo& vertex) {
   bool all_anc_cmt = true;
   std::function<int(TxRococo&)> func =
-      [&all_anc_cmt, &vertex](TxRococo& v) -> int {
+      [this, &all_anc_cmt, &vertex](TxRococo& v) -> int {
         TxRococo& parent = v;
         int r = 0;
         if (parent.IsExecuted() || parent.IsAborted()) {
@@ -422,7 +399,7 @@ bool SchedulerRococo::AllAncCmt(TxRococo& vertex) {
           r = RccGraph::SearchHint::Ok;
         } else {
           r = RccGraph::SearchHint::Exit;
-          parent.to_checks_.insert(&vertex);
+          WaitFor(parent, vertex);
           all_anc_cmt = false;
         }
         return r;
@@ -548,17 +525,17 @@ bool SchedulerRococo::AllAncFns(const RccScc& scc) {
   scc_set.insert(scc.begin(), scc.end());
   bool all_anc_fns = true;
   std::function<int(TxRococo&)> func =
-      [&all_anc_fns, &scc_set, &scc](TxRococo& v) -> int {
+      [this, &all_anc_fns, &scc_set, &scc](TxRococo& v) -> int {
         TxRococo& info = v;
         if (info.IsExecuted()) {
           return RccGraph::SearchHint::Skip;
-        } else if (info.status() >= TXN_DCD) {
-          return RccGraph::SearchHint::Ok;
         } else if (scc_set.find(&v) != scc_set.end()) {
           return RccGraph::SearchHint::Ok;
         } else {
+          // a decided ancestor may still be waiting to execute, in this
+          // round's batch or for its own ancestors.
           all_anc_fns = false;
-          info.to_checks_.insert(scc[0]);
+          WaitFor(info, *scc[0]);
           return RccGraph::SearchHint::Exit; // abort traverse
         }
       };
@@ -28,8 +28,15 @@ class SchedulerRococo : public Scheduler, public RccGraph {
 
  public:
 //  RccGraph *dep_graph_ = nullptr;
+  // checks go in txn id order.
+  struct TxIdLess {
+    bool operator()(const TxRococo* a, const TxRococo* b) const {
+      return a->tid_ < b->tid_;
+    }
+  };
+
   WaitlistChecker* waitlist_checker_ = nullptr;
-  set<TxRococo*> waitlist_ = {};
+  set<TxRococo*, TxIdLess> waitlist_ = {};
   set<shared_ptr<TxRococo>> fridge_ = {};
   std::recursive_mutex mtx_{};
   std::time_t last_upgrade_time_{0};
@@ -105,6 +112,8 @@ class SchedulerRococo : public Scheduler, public RccGraph {
   void AnswerIfInquired(TxRococo &dtxn);
   void InquiredGraph(TxRococo& dtxn, shared_ptr<RccGraph> graph);
   void CheckWaitlist();
+  void WaitFor(TxRococo& ancestor, TxRococo& v);
+  void ReleaseToChecks(TxRococo& dtxn);
   void InquireAck(cmdid_t cmd_id, RccGraph& graph);
   void TriggerCheckAfterAggregation(RccGraph &graph);
   void AddChildrenIntoWaitlist(TxRococo* v);
@@ -30,6 +30,9 @@ class TxRococo: public Tx, public Vertex<TxRococo> {
   // if any other transactions is blocked by this transaction,
   // add it to this set to make the checking waitlist faster.
   set<TxRococo*> to_checks_{};
+  // in how many to_checks_ of its ancestors this transaction waits. it is
+  // not checked again before one of them lets it go.
+  int32_t n_blockers_{0};
 
   TxRococo() = delete;
   TxRococo(txnid_t id);
@@ -255,14 +258,26 @@ class TxRococo: public Tx, public Vertex<TxRococo> {
 };
 
 
+// the graph sends the id with the vertex; epoch and partitions are small
+// numbers, sent as varints.
 inline rrr::Marshal &operator<<(rrr::Marshal &m, const TxRococo &ti) {
-  m << ti.tid_ << ti.status() << ti.partition_ << ti.epoch_;
+  m << ti.status() << rrr::v64(ti.epoch_) << rrr::v64(ti.partition_.size());
+  for (auto par_id : ti.partition_) {
+    m << rrr::v64(par_id);
+  }
   return m;
 }
 
 inline rrr::Marshal &operator>>(rrr::Marshal &m, TxRococo &ti) {
   int8_t status;
-  m >> ti.tid_ >> status >> ti.partition_ >> ti.epoch_;
+  rrr::v64 epoch, n;
+  m >> status >> epoch >> n;
+  ti.epoch_ = epoch.get();
+  for (int64_t i = 0; i < n.get(); i++) {
+    rrr::v64 par_id;
+    m >> par_id;
+    ti.partition_.insert(par_id.get());
+  }
   ti.union_status(status);
   return m;
 }
@@ -186,11 +186,7 @@ void Scheduler::get_prepare_log(i64 txn_id,
 
 Scheduler::Scheduler() : mtx_() {
   mdb_txn_mgr_ = new mdb::TxnMgrUnsafe();
-  if (Config::GetConfig()->do_logging()) {
-    auto path = Config::GetConfig()->log_path();
-    // TODO free this
-//    recorder_ = new Recorder(path);
-  }
+  // recorder_ is set up by the server worker, see SetupLogging.
 }
 
 Coordinator *Scheduler::CreateRepCoord() {
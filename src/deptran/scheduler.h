@@ -23,6 +23,10 @@ class Scheduler {
   unordered_map<txid_t, Executor *> executors_{};
 
   function<void(Marshallable &)> app_next_{};
+  // state of the application up to the last command passed to app_next_,
+  // and installing such a state, for a replica that fell too far behind.
+  function<shared_ptr<Marshallable>()> app_snapshot_{};
+  function<void(Marshallable &)> app_install_{};
   function<shared_ptr<vector<MultiValue>>(Marshallable&)> key_deps_{};
 
   mdb::TxnMgr *mdb_txn_mgr_;
@@ -131,6 +135,10 @@ class Scheduler {
     return mdb_txn_mgr_->get_table(name);
   }
 
+  inline mdb::Table *get_table(mdb::tblid_t tbl_id) {
+    return mdb_txn_mgr_->get_table(tbl_id);
+  }
+
   virtual mdb::Txn *GetMTxn(const i64 tid);
   virtual mdb::Txn *GetOrCreateMTxn(const i64 tid);
   virtual mdb::Txn *RemoveMTxn(const i64 tid);
@@ -158,8 +166,17 @@ class Scheduler {
     app_next_ = learner_action;
   }
 
+  void RegSnapshotAction(function<shared_ptr<Marshallable>()> snapshot,
+                         function<void(Marshallable &)> install) {
+    app_snapshot_ = snapshot;
+    app_install_ = install;
+  }
+
   virtual void Next(Marshallable& cmd) { verify(0); };
 
+  // called at start up with every record recorder_ had on disk.
+  virtual void Recover(Marshal& record) {};
+
   // epoch related functions
   void TriggerUpgradeEpoch();
   void UpgradeEpochAck(parid_t par_id, siteid_t site_id, int res);
@@ -1,3 +1,4 @@
+#include <sys/stat.h>
 #include "server_worker.h"
 #include "service.h"
 #include "benchmark_control_rpc.h"
@@ -112,6 +113,7 @@ void ServerWorker::RegisterWorkload() {
   workload->sss_ = sharding_;
   workload->txn_reg_ = tx_reg_;
   workload->RegisterPrecedures();
+  tx_reg_->Freeze();
 }
 
 void ServerWorker::SetupService() {
@@ -127,6 +129,10 @@ void ServerWorker::SetupService() {
   int n_io_threads = 1;
   svr_poll_mgr_ = new rrr::PollMgr(n_io_threads);
 
+  if (Config::GetConfig()->do_logging()) {
+    SetupLogging();
+  }
+
   // init service implementation
 
   if (tx_frame_ != nullptr) {
@@ -185,18 +191,15 @@ void ServerWorker::WaitForShutdown() {
 #ifdef CHECK_ISO
       this->tx_sched_->CheckDeltas();
 #endif
-      if (DepTranServiceImpl* s = dynamic_cast<DepTranServiceImpl*>(service)) {
-        auto& recorder = s->recorder_;
-        if (recorder) {
-          auto n_flush_avg_ = recorder->stat_cnt_.peek().avg_;
-          auto sz_flush_avg_ = recorder->stat_sz_.peek().avg_;
-          Log::info("Log to disk, average log per flush: %lld,"
-                        " average size per flush: %lld",
-                    n_flush_avg_, sz_flush_avg_);
-        }
-      }
     }
   }
+  for (auto& sp_recorder : recorders_) {
+    Log_info("write-ahead log, average records per flush: %lld, "
+             "average bytes per flush: %lld, average flush time: %lld us",
+             sp_recorder->stat_cnt_.peek().avg_,
+             sp_recorder->stat_sz_.peek().avg_,
+             sp_recorder->stat_flush_us_.peek().avg_);
+  }
 #ifdef CHECK_ISO
     for (auto service : services_) {
       this->tx_sched_->CheckDeltas();
@@ -206,6 +209,30 @@ void ServerWorker::WaitForShutdown() {
   Log_debug("exit %s", __FUNCTION__);
 }
 
+void ServerWorker::SetupLogging() {
+  auto config = Config::GetConfig();
+  string dir = config->log_path();
+  if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+    Log_fatal("cannot create log directory %s: %s",
+              dir.c_str(), strerror(errno));
+  }
+  // accepts are logged by the replication scheduler, prepares by the
+  // transaction scheduler if nothing replicates them.
+  auto sched = rep_sched_ ? rep_sched_ : tx_sched_;
+  string path = dir + "/" + site_info_->name + ".wal";
+  auto sp_recorder = std::make_shared<rrr::Recorder>(path.c_str(),
+                                                     config->log_flush_);
+  auto n = sp_recorder->replay([sched] (Marshal& m) {
+    sched->Recover(m);
+  });
+  Log_info("site %s recovered %d records from %s",
+           site_info_->name.c_str(), (int) n, path.c_str());
+  // callbacks run on the thread serving the rpcs.
+  svr_poll_mgr_->add(sp_recorder, 0);
+  sched->recorder_ = sp_recorder.get();
+  recorders_.push_back(sp_recorder);
+}
+
 void ServerWorker::SetupCommo() {
   verify(svr_poll_mgr_ != nullptr);
   if (tx_frame_) {
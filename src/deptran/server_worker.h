@@ -40,11 +40,13 @@ class ServerWorker {
 
   Communicator *tx_commo_ = nullptr;
   Communicator *rep_commo_ = nullptr;
+  vector<shared_ptr<rrr::Recorder>> recorders_{};
 
   void SetupHeartbeat();
   void PopTable();
   void SetupBase();
   void SetupService();
+  void SetupLogging();
   void SetupCommo();
   void RegisterWorkload();
   void ShutDown();
@@ -37,13 +37,7 @@ ClassicServiceImpl::ClassicServiceImpl(Scheduler* sched,
   piece_count_prepare_success_ = 0;
 #endif
 
-  if (Config::GetConfig()->do_logging()) {
-    verify(0); // TODO disable logging for now.
-    auto path = Config::GetConfig()->log_path();
-//    recorder_ = new Recorder(path);
-//    poll_mgr->add(recorder_);
-  }
-
+  recorder_ = sched->recorder_;
   this->RegisterStats();
 }
 
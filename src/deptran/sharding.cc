@@ -1,6 +1,9 @@
+#include <sys/mman.h>
+
 #include "constants.h"
 #include "sharding.h"
 #include "scheduler.h"
+#include "frame.h"
 
 // for tpca benchmark
 #include "bench/tpca/workload.h"
@@ -27,6 +30,30 @@
 
 namespace janus {
 
+thread_local uint64_t Sharding::num_foreign_row = 1;
+thread_local vector<uint32_t> Sharding::bound_foreign_index = {};
+thread_local uint32_t Sharding::self_primary_col = 0;
+thread_local map<uint32_t, std::pair<uint32_t, uint32_t> >
+    Sharding::prim_foreign_index = {};
+thread_local uint64_t Sharding::num_self_primary = 0;
+thread_local int Sharding::n_row_inserted_ = 0;
+thread_local bool Sharding::record_key = true;
+
+// a snapshot is this header, then every table of the partition: its name,
+// the kinds of its columns, and its rows. a row is its columns in schema
+// order, numbers as they are in memory, strings as their length and bytes.
+// it is read back by the same build, on the same machine.
+struct snapshot_header_t {
+  char magic[8];
+  uint32_t version;
+  uint32_t par_id;
+  uint64_t fingerprint;
+  uint32_t n_tables;
+};
+
+static const char snapshot_magic[8] = {'J', 'A', 'N', 'U', 'S', 'S', 'N', 'P'};
+static const uint32_t snapshot_version = 1;
+
 Sharding::Sharding() { }
 
 Sharding::Sharding(const Sharding &sharding)
@@ -40,6 +67,13 @@ Sharding::~Sharding() {
 
 void Sharding::BuildTableInfoPtr() {
   verify(tb_infos_.size() > 0);
+  // a copy still points at the values of the sharding it was copied from,
+  // every server populates its own.
+  for (auto &tbl_pair : tb_infos_) {
+    for (auto &col : tbl_pair.second.columns) {
+      col.values = nullptr;
+    }
+  }
   for (auto tbl_it = tb_infos_.begin(); tbl_it != tb_infos_.end(); tbl_it++ ) {
     auto &tbl = tbl_it->second;
     auto &columns = tbl.columns;
@@ -356,38 +390,338 @@ int Sharding::PopulateTable(tb_info_t *tb_info,
 
 // TODO this should be moved to per benchmark class
 int Sharding::PopulateTables(parid_t par_id) {
-  auto n_left = tb_infos_.size();
-  verify(n_left > 0);
-
-  do {
-    bool populated = false;
-    for (auto tb_it = tb_infos_.begin(); tb_it != tb_infos_.end(); tb_it++) {
-      tb_info_t *tb_info = &(tb_it->second);
-      verify(tb_it->first == tb_info->tb_name);
-
-      // TODO is this unnecessary?
-      auto it = tb_info->populated.find(par_id);
-      if (it == tb_info->populated.end()) {
-        tb_info->populated[par_id] = false;
-      }
+  verify(tb_infos_.size() > 0);
+
+  auto path = SnapshotPath(par_id);
+  if (!path.empty() && LoadSnapshot(path, par_id)) {
+    release_foreign_values();
+    return 0;
+  }
+
+  vector<tb_info_t *> left;
+  for (auto tb_it = tb_infos_.begin(); tb_it != tb_infos_.end(); tb_it++) {
+    tb_info_t *tb_info = &(tb_it->second);
+    verify(tb_it->first == tb_info->tb_name);
+    if (!tb_info->populated[par_id]) {
+      left.push_back(tb_info);
+    }
+  }
 
-      if (!tb_info->populated[par_id] &&
-          Ready2Populate(tb_info)) {
-        PopulateTable(tb_info, par_id);
-        tb_info->populated[par_id] = true;
-        // finish populate one table
-        n_left--;
-        populated = true;
+  // every round populates all tables whose foreign tables are done.
+  while (!left.empty()) {
+    vector<tb_info_t *> wave, rest;
+    for (auto tb_info : left) {
+      if (Ready2Populate(tb_info)) {
+        wave.push_back(tb_info);
+      } else {
+        rest.push_back(tb_info);
       }
     }
-    verify(populated);
-  } while (n_left > 0);
+    verify(!wave.empty());
+    PopulateWave(wave, par_id);
+    left.swap(rest);
+  }
 
+  if (!path.empty()) {
+    DumpSnapshot(path, par_id);
+  }
   release_foreign_values();
   return 0;
+}
+
+void Sharding::PopulateWave(const vector<tb_info_t *> &tb_infos,
+                            parid_t par_id) {
+  // largest first, so that the last table to start is a short one.
+  vector<tb_info_t *> todo(tb_infos);
+  std::sort(todo.begin(), todo.end(), [] (tb_info_t *a, tb_info_t *b) {
+    return a->num_records > b->num_records;
+  });
+  std::atomic<size_t> next(0);
+  auto populate = [this, &todo, &next, par_id] () {
+    for (size_t i = next++; i < todo.size(); i = next++) {
+      PopulateTable(todo[i], par_id);
+    }
+  };
+
+  size_t n_threads = std::min(todo.size(),
+      (size_t) Config::GetConfig()->n_populate_threads_);
+  if (n_threads <= 1) {
+    populate();
+  } else {
+    vector<std::thread> threads;
+    for (size_t i = 0; i < n_threads; i++) {
+      threads.emplace_back(populate);
+    }
+    for (auto &th : threads) {
+      th.join();
+    }
+  }
+  for (auto tb_info : todo) {
+    tb_info->populated[par_id] = true;
+  }
+}
+
+std::string Sharding::SnapshotPath(parid_t par_id) {
+  auto &dir = Config::GetConfig()->snapshot_dir_;
+  if (dir.empty()) {
+    return "";
+  }
+  if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+    Log_error("cannot create snapshot directory %s: %s",
+              dir.c_str(), strerror(errno));
+    return "";
+  }
+  return dir + "/partition_" + std::to_string(par_id) + ".snap";
+}
+
+// changes with anything that changes what gets populated.
+uint64_t Sharding::SnapshotFingerprint(parid_t par_id) {
+  auto config = Config::GetConfig();
+  std::string desc = std::to_string(config->benchmark()) + ","
+      + std::to_string(config->GetNumPartition()) + ","
+      + std::to_string(par_id);
+  for (auto &tbl_pair : tb_infos_) {
+    auto &tb_info = tbl_pair.second;
+    desc += ";" + tb_info.tb_name + ","
+        + std::to_string(tb_info.num_records) + ","
+        + std::to_string(tb_info.sharding_method);
+    for (auto &col : tb_info.columns) {
+      desc += "," + col.name + ":" + std::to_string(col.type)
+          + (col.is_primary ? "p" : "") + col.foreign_tbl_name
+          + "." + col.foreign_col_name;
+    }
+  }
+  // FNV-1a
+  uint64_t h = 14695981039346656037ULL;
+  for (unsigned char c : desc) {
+    h = (h ^ c) * 1099511628211ULL;
+  }
+  return h;
+}
+
+static void snapshot_rows(mdb::Table *tbl, vector<const mdb::Row *> &rows) {
+  switch (tbl->rtti()) {
+    case mdb::TBL_SORTED: {
+      auto cursor = ((mdb::SortedTable *) tbl)->all();
+      while (cursor.has_next()) {
+        rows.push_back(cursor.next());
+      }
+      break;
+    }
+    case mdb::TBL_UNSORTED: {
+      auto cursor = ((mdb::UnsortedTable *) tbl)->all();
+      while (cursor.has_next()) {
+        rows.push_back(cursor.next());
+      }
+      break;
+    }
+    case mdb::TBL_SNAPSHOT: {
+      auto cursor = ((mdb::SnapshotTable *) tbl)->all();
+      while (cursor.has_next()) {
+        rows.push_back(cursor.next());
+      }
+      break;
+    }
+    default:
+      verify(0);
+  }
+}
+
+void Sharding::DumpSnapshot(const std::string &path, parid_t par_id) {
+  // replicas of a partition may dump at the same time, each writes its
+  // own file and the last rename wins.
+  auto tmp_path = path + ".tmp" + std::to_string(tx_sched_->site_id_);
+  FILE *fp = fopen(tmp_path.c_str(), "w");
+  if (fp == nullptr) {
+    Log_error("cannot write snapshot %s: %s", tmp_path.c_str(),
+              strerror(errno));
+    return;
+  }
+  auto put = [fp] (const void *p, size_t n) {
+    verify(fwrite(p, 1, n, fp) == n);
+  };
+
+  auto &tables = tx_sched_->mdb_txn_mgr_->tables();
+  snapshot_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+  header.version = snapshot_version;
+  header.par_id = par_id;
+  header.fingerprint = SnapshotFingerprint(par_id);
+  header.n_tables = tables.size();
+  put(&header, sizeof(header));
+
+  vector<const mdb::Row *> rows;
+  for (auto &tbl_pair : tables) {
+    auto &name = tbl_pair.first;
+    mdb::Table *tbl = tbl_pair.second;
+    const mdb::Schema *schema = tbl->schema();
+    uint32_t len = name.size();
+    put(&len, sizeof(len));
+    put(name.data(), len);
+    uint32_t n_cols = schema->columns_count();
+    put(&n_cols, sizeof(n_cols));
+    for (auto col_it = schema->begin(); col_it != schema->end(); col_it++) {
+      uint8_t kind = col_it->type;
+      put(&kind, sizeof(kind));
+    }
+    rows.clear();
+    snapshot_rows(tbl, rows);
+    uint64_t n_rows = rows.size();
+    put(&n_rows, sizeof(n_rows));
+    for (auto row : rows) {
+      for (uint32_t i = 0; i < n_cols; i++) {
+        Value v = row->get_column(i);
+        switch (v.get_kind()) {
+          case Value::I32: {
+            i32 x = v.get_i32();
+            put(&x, sizeof(x));
+            break;
+          }
+          case Value::I64: {
+            i64 x = v.get_i64();
+            put(&x, sizeof(x));
+            break;
+          }
+          case Value::DOUBLE: {
+            double x = v.get_double();
+            put(&x, sizeof(x));
+            break;
+          }
+          case Value::STR: {
+            auto &str = v.get_str();
+            uint32_t str_len = str.size();
+            put(&str_len, sizeof(str_len));
+            put(str.data(), str_len);
+            break;
+          }
+          default:
+            verify(0);
+        }
+      }
+    }
+  }
+  verify(fclose(fp) == 0);
+  verify(rename(tmp_path.c_str(), path.c_str()) == 0);
+  Log_info("dumped snapshot of partition %d into %s", par_id, path.c_str());
+}
+
+bool Sharding::LoadSnapshot(const std::string &path, parid_t par_id) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  verify(fstat(fd, &st) == 0);
+  size_t size = st.st_size;
+  snapshot_header_t header;
+  if (size < sizeof(header)) {
+    close(fd);
+    return false;
+  }
+  char *base = (char *) mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  verify(base != MAP_FAILED);
+  madvise(base, size, MADV_SEQUENTIAL);
+
+  memcpy(&header, base, sizeof(header));
+  if (memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0 ||
+      header.version != snapshot_version ||
+      header.par_id != par_id ||
+      header.fingerprint != SnapshotFingerprint(par_id)) {
+    munmap(base, size);
+    Log_info("snapshot %s is of another configuration, populating tables",
+             path.c_str());
+    return false;
+  }
+
+  const char *p = base + sizeof(header);
+  const char *end = base + size;
+  auto check = [&p, end, &path] (size_t n) {
+    if (p + n > end) {
+      Log_fatal("snapshot %s is truncated", path.c_str());
+      verify(0);
+    }
+  };
+  auto get = [&p, &check] (void *dst, size_t n) {
+    check(n);
+    memcpy(dst, p, n);
+    p += n;
+  };
 
-  fprintf(stderr, "%s -- implement in subclass\n", __FUNCTION__);
-  verify(0);
+  vector<Value> row_data;
+  for (uint32_t t = 0; t < header.n_tables; t++) {
+    uint32_t len;
+    get(&len, sizeof(len));
+    check(len);
+    std::string name(p, len);
+    p += len;
+    mdb::Table *tbl = tx_sched_->get_table(name);
+    verify(tbl != nullptr);
+    const mdb::Schema *schema = tbl->schema();
+    uint32_t n_cols;
+    get(&n_cols, sizeof(n_cols));
+    verify(n_cols == schema->columns_count());
+    vector<Value::kind> kinds;
+    for (auto col_it = schema->begin(); col_it != schema->end(); col_it++) {
+      uint8_t kind;
+      get(&kind, sizeof(kind));
+      verify(kind == col_it->type);
+      kinds.push_back(col_it->type);
+    }
+    uint64_t n_rows;
+    get(&n_rows, sizeof(n_rows));
+    for (uint64_t r = 0; r < n_rows; r++) {
+      row_data.clear();
+      for (auto kind : kinds) {
+        switch (kind) {
+          case Value::I32: {
+            i32 x;
+            get(&x, sizeof(x));
+            row_data.push_back(Value(x));
+            break;
+          }
+          case Value::I64: {
+            i64 x;
+            get(&x, sizeof(x));
+            row_data.push_back(Value(x));
+            break;
+          }
+          case Value::DOUBLE: {
+            double x;
+            get(&x, sizeof(x));
+            row_data.push_back(Value(x));
+            break;
+          }
+          case Value::STR: {
+            uint32_t str_len;
+            get(&str_len, sizeof(str_len));
+            check(str_len);
+            // Row::create() copies the bytes out of the mapping.
+            mdb::blob b;
+            b.data = p;
+            b.len = str_len;
+            row_data.push_back(Value::borrow(b));
+            p += str_len;
+            break;
+          }
+          default:
+            verify(0);
+        }
+      }
+      auto row = frame_->CreateRow(schema, row_data);
+      tbl->insert(row);
+      SnapshotRowLoaded(name, row);
+    }
+  }
+  verify(p == end);
+  munmap(base, size);
+
+  for (auto &tbl_pair : tb_infos_) {
+    tbl_pair.second.populated[par_id] = true;
+  }
+  Log_info("loaded partition %d from snapshot %s", par_id, path.c_str());
+  return true;
 }
 
 
@@ -151,20 +151,21 @@ class Sharding {
   Scheduler *tx_sched_;
   Frame* frame_;
 
-  // below is used for table populater
+  // below is used for table populater, tables are populated side by side
+  // so every thread keeps its own.
 
   // number of all combination of foreign columns
-  uint64_t num_foreign_row = 1;
+  static thread_local uint64_t num_foreign_row;
   // the column index for foreign w_id and d_id.
-  vector<uint32_t> bound_foreign_index = {};
+  static thread_local vector<uint32_t> bound_foreign_index;
   // the index of column that is primary but not foreign
-  uint32_t self_primary_col = 0;
+  static thread_local uint32_t self_primary_col;
   // col index -> (0, number of records in foreign table or size of value vector)
-  map<uint32_t, std::pair<uint32_t, uint32_t> > prim_foreign_index = {};
-  uint64_t num_self_primary = 0;
+  static thread_local map<uint32_t, std::pair<uint32_t, uint32_t> > prim_foreign_index;
+  static thread_local uint64_t num_self_primary;
   // the number of row that have been inserted.
-  int n_row_inserted_ = 0;
-  bool record_key = true; // ?
+  static thread_local int n_row_inserted_;
+  static thread_local bool record_key; // ?
 
 
   void BuildTableInfoPtr();
@@ -200,6 +201,22 @@ class Sharding {
 
   virtual bool Ready2Populate(tb_info_t *tb_info);
 
+  // populate tables that do not depend on each other, on up to
+  // Config::n_populate_threads_ threads.
+  void PopulateWave(const vector<tb_info_t *> &tb_infos, parid_t par_id);
+
+  std::string SnapshotPath(parid_t par_id);
+
+  uint64_t SnapshotFingerprint(parid_t par_id);
+
+  bool LoadSnapshot(const std::string &path, parid_t par_id);
+
+  void DumpSnapshot(const std::string &path, parid_t par_id);
+
+  // called on every row loaded from a snapshot, to rebuild what the
+  // populater keeps outside the tables.
+  virtual void SnapshotRowLoaded(const std::string &tb_name, mdb::Row *row) {}
+
   void release_foreign_values();
 
   uint32_t PartitionFromKey(const MultiValue &key,
@@ -36,7 +36,7 @@ void TapirCommo::BroadcastFastAccept(parid_t par_id,
                                      cmdid_t cmd_id,
                                      vector<SimpleCommand>& cmds,
                                      const function<void(int32_t)>& cb) {
-  auto proxies = rpc_par_proxies_[par_id];
+  auto& proxies = rpc_par_proxies_[par_id];
   for (auto &p : proxies) {
     auto proxy = (ClassicProxy*) p.second;
     FutureAttr fuattr;
@@ -52,7 +52,7 @@ void TapirCommo::BroadcastFastAccept(parid_t par_id,
 void TapirCommo::BroadcastDecide(parid_t par_id,
                                  cmdid_t cmd_id,
                                  int32_t decision) {
-  auto proxies = rpc_par_proxies_[par_id];
+  auto& proxies = rpc_par_proxies_[par_id];
   for (auto &p : proxies) {
     auto proxy = (ClassicProxy*) p.second;
     FutureAttr fuattr;
@@ -66,7 +66,7 @@ void TapirCommo::BroadcastAccept(parid_t par_id,
                                  ballot_t ballot,
                                  int decision,
                                  const function<void(Future*)>& callback) {
-  auto proxies = rpc_par_proxies_[par_id];
+  auto& proxies = rpc_par_proxies_[par_id];
   for (auto &p: proxies) {
     auto proxy = (ClassicProxy*) p.second;
     FutureAttr fuattr;
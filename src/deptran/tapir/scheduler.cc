@@ -36,8 +36,6 @@ int SchedulerTapir::OnFastAccept(txid_t tx_id,
       auto col_id = pair2.first;
       auto ver_read = pair2.second;
       auto ver_now = row->get_column_ver(col_id);
-      verify(col_id < row->prepared_rver_.size());
-      verify(col_id < row->prepared_wver_.size());
       if (ver_read < ver_now) {
         // value has been updated. abort transaction.
         return REJECT;
@@ -64,11 +62,11 @@ int SchedulerTapir::OnFastAccept(txid_t tx_id,
       value.ver_ = ver_write;
       if (ver_write < row->max_prepared_rver(col_id)) {
         ret = RETRY;
-      } else if (ver_write < row->ver_[col_id]) {
+      } else if (ver_write < row->get_column_ver(col_id)) {
         ret = RETRY;
       }
       // record prepared write timestamp
-      row->insert_prepared_rver(col_id, ver_write);
+      row->insert_prepared_wver(col_id, ver_write);
       tx->prepared_wvers_[row][col_id] = ver_write;
     }
   }
@@ -140,4 +140,8 @@ mdb::Table *Tx::GetTable(const std::string &tbl_name) const {
   return sched_->get_table(tbl_name);
 }
 
+mdb::Table *Tx::GetTable(mdb::tblid_t tbl_id) const {
+  return sched_->get_table(tbl_id);
+}
+
 } // namespace janus
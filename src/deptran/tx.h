@@ -128,6 +128,8 @@ class Tx {
                                  int rs_context_id = 0);
 
   virtual mdb::Table *GetTable(const std::string &tbl_name) const;
+  // id from mdb::table_id(), for the pieces.
+  mdb::Table *GetTable(mdb::tblid_t tbl_id) const;
 
   virtual ~Tx();
 };
@@ -60,8 +60,9 @@ class TxnPieceDef {
   PieceCallbackHandler callback_{};
   sharder_t sharder_{};
   defer_t defer_{};
-  set<int32_t> input_vars_{};
-  set<int32_t> output_vars_{};
+  // sorted, checked on every readiness check so kept flat.
+  vector<int32_t> input_vars_{};
+  vector<int32_t> output_vars_{};
   vector<conf_id_t> conflicts_{};
   vector<string> conflicts_str() {
     // TODO
@@ -71,6 +72,10 @@ class TxnPieceDef {
 
 /**
 * This class holds all the hard-coded transactions pieces.
+*
+* Workloads fill regs_ in RegisterPrecedures(), then the owner calls Freeze().
+* A frozen registry answers get() from a dense array indexed by txn type and
+* piece id, since it is looked up for every dispatched piece.
 */
 class TxnRegistry {
  public:
@@ -81,7 +86,58 @@ class TxnRegistry {
    * return the piece definition, so maybe change a name?
    */
   TxnPieceDef& get(const txntype_t t_type, const innid_t p_type) {
-    return regs_[t_type][p_type];
+    if (frozen_) {
+      verify(t_type < txns_.size());
+      auto& txn = txns_[t_type];
+      innid_t i = p_type - txn.base_;
+      verify(p_type >= txn.base_ && i < txn.pieces_.size());
+      verify(txn.pieces_[i] != nullptr);
+      return *txn.pieces_[i];
+    }
+    auto it = regs_.find(t_type);
+    verify(it != regs_.end());
+    auto jt = it->second.find(p_type);
+    verify(jt != it->second.end());
+    return jt->second;
+  }
+
+  /*
+   * build the lookup arrays, regs_ must not change afterwards as they point
+   * into it.
+   */
+  void Freeze() {
+    verify(!frozen_);
+    txntype_t max_type = 0;
+    for (auto& pair : regs_) {
+      max_type = std::max(max_type, pair.first);
+    }
+    txns_.clear();
+    txns_.resize(regs_.empty() ? 0 : max_type + 1);
+    for (auto& pair : regs_) {
+      auto& pieces = pair.second;
+      if (pieces.empty()) {
+        continue;
+      }
+      auto& txn = txns_[pair.first];
+      txn.base_ = pieces.begin()->first;
+      innid_t span = pieces.rbegin()->first - txn.base_ + 1;
+      // piece ids are hand-picked constants, spread over a few thousands.
+      verify(span <= (1 << 16));
+      txn.pieces_.resize(span, nullptr);
+      for (auto& p : pieces) {
+        TxnPieceDef& def = p.second;
+        for (auto vars : {&def.input_vars_, &def.output_vars_}) {
+          std::sort(vars->begin(), vars->end());
+          vars->erase(std::unique(vars->begin(), vars->end()), vars->end());
+        }
+        txn.pieces_[p.first - txn.base_] = &def;
+      }
+    }
+    frozen_ = true;
+  }
+
+  bool frozen() const {
+    return frozen_;
   }
 
  public:
@@ -89,6 +145,14 @@ class TxnRegistry {
   // TxnRegistry() { }
   map<txntype_t, int> txn_types_{};
   map<txntype_t, map<innid_t, TxnPieceDef>> regs_{};
+
+ private:
+  struct txn_pieces_t {
+    innid_t base_{0};
+    vector<TxnPieceDef*> pieces_{};
+  };
+  bool frozen_{false};
+  vector<txn_pieces_t> txns_{};
 };
 
 } // namespace janus
@@ -73,8 +73,8 @@ class Workload {
             const ProcHandler& handler
   ) {
     auto& piece = txn_reg_->regs_[txn_type][inn_id];
-    piece.input_vars_ = ivars;
-    piece.output_vars_ = ovars;
+    piece.input_vars_.assign(ivars.begin(), ivars.end());
+    piece.output_vars_.assign(ovars.begin(), ovars.end());
     piece.conflicts_ = conflicts;
     piece.sharder_ = sharder;
     piece.defer_ = defer;
@@ -90,13 +90,20 @@ public:
         return false;
     }
 
+    // the hash of each column seeds the hash of the next one, so the
+    // order of the columns counts and equal columns do not cancel out, as
+    // they did when the column hashes were xor'ed.
     class hash {
     public:
+        // hash of the key up to column i, given v, the hash up to i - 1.
+        static uint32_t step(uint32_t v, int i, const blob& b) {
+            return (i == 0) ? stringhash32(b.data, b.len)
+                            : stringhash32(b.data, b.len, v);
+        }
         size_t operator() (const MultiBlob& mb) const {
-            size_t v = 0;
-            blob::hash h;
+            uint32_t v = 0;
             for (int i = 0; i < mb.count_; i++) {
-                v ^= h(mb.blobs_[i]);
+                v = step(v, i, mb.blobs_[i]);
             }
             return v;
         }
@@ -0,0 +1,513 @@
+#include <string.h>
+
+#include "row.h"
+#include "schema.h"
+#include "btree.h"
+
+namespace mdb {
+
+static inline void store_be(uint64_t v, int n, char* p) {
+    for (int i = n - 1; i >= 0; i--) {
+        p[i] = (char) (v & 0xff);
+        v >>= 8;
+    }
+}
+
+static inline uint64_t load_be64(const char* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | (uint8_t) p[i];
+    }
+    return v;
+}
+
+NormKey::NormKey(const MultiBlob& mb, const Schema* schema): len_(0) {
+    const std::vector<colid_t>& key_cols = schema->key_columns_id();
+    verify(mb.count() == (int) key_cols.size());
+    for (size_t i = 0; i < key_cols.size(); i++) {
+        append(mb[i], schema->get_column_info(key_cols[i])->type);
+    }
+}
+
+NormKey::NormKey(const Row* row): len_(0) {
+    const Schema* schema = row->schema();
+    for (colid_t col_id : schema->key_columns_id()) {
+        append(row->get_blob(col_id), schema->get_column_info(col_id)->type);
+    }
+}
+
+void NormKey::put(const void* p, int n) {
+    if (len_ + n <= inline_size) {
+        memcpy(buf_ + len_, p, n);
+    } else {
+        if (len_ <= inline_size) {
+            spill_.assign(buf_, len_);
+        }
+        spill_.append((const char *) p, n);
+    }
+    len_ += n;
+}
+
+void NormKey::append(const blob& b, int kind) {
+    char be[8];
+    switch (kind) {
+    case Value::I32:
+        {
+            verify(b.len == (int) sizeof(i32));
+            uint32_t u;
+            memcpy(&u, b.data, sizeof(u));
+            store_be(u ^ 0x80000000u, 4, be);
+            put(be, 4);
+        }
+        break;
+    case Value::I64:
+        {
+            verify(b.len == (int) sizeof(i64));
+            uint64_t u;
+            memcpy(&u, b.data, sizeof(u));
+            store_be(u ^ (1ull << 63), 8, be);
+            put(be, 8);
+        }
+        break;
+    case Value::DOUBLE:
+        {
+            verify(b.len == (int) sizeof(double));
+            double d;
+            memcpy(&d, b.data, sizeof(d));
+            if (d == 0) {
+                // -0 == 0
+                d = 0;
+            }
+            uint64_t u;
+            memcpy(&u, &d, sizeof(u));
+            u = (u >> 63) ? ~u : (u | (1ull << 63));
+            store_be(u, 8, be);
+            put(be, 8);
+        }
+        break;
+    case Value::STR:
+        {
+            static const char escaped_zero[] = {0, (char) 0xff};
+            static const char end[] = {0, 0};
+            const char* p = b.data;
+            const char* stop = b.data + b.len;
+            while (p < stop) {
+                const char* zero = (const char *) memchr(p, 0, stop - p);
+                if (zero == nullptr) {
+                    put(p, stop - p);
+                    break;
+                }
+                put(p, zero - p);
+                put(escaped_zero, 2);
+                p = zero + 1;
+            }
+            put(end, 2);
+        }
+        break;
+    default:
+        Log::fatal("unexpected column type %d", kind);
+        verify(0);
+    }
+}
+
+int NormKey::compare(const NormKey& o) const {
+    int cmp = memcmp(data(), o.data(), std::min(len_, o.len_));
+    if (cmp != 0) {
+        return (cmp < 0) ? -1 : 1;
+    }
+    if (len_ != o.len_) {
+        return (len_ < o.len_) ? -1 : 1;
+    }
+    return 0;
+}
+
+void NormKey::prefix(uint64_t* w) const {
+    char p[16] = {0};
+    memcpy(p, data(), std::min(len_, 16));
+    w[0] = load_be64(p);
+    w[1] = load_be64(p + 8);
+}
+
+
+const int BTree::leaf_cap;
+const int BTree::inner_cap;
+
+BTree::BTree(const Schema* schema): schema_(schema) {
+    int width = 0;
+    bool strings = false;
+    for (colid_t col_id : schema->key_columns_id()) {
+        switch (schema->get_column_info(col_id)->type) {
+        case Value::I32:
+            width += sizeof(i32);
+            break;
+        case Value::I64:
+        case Value::DOUBLE:
+            width += 8;
+            break;
+        default:
+            strings = true;
+        }
+    }
+    exact_ = !strings && width <= 16;
+    optimistic_ = !strings && width <= NormKey::inline_size;
+    first_ = last_ = new_leaf();
+    root_ = first_;
+}
+
+BTree::~BTree() {
+    for (auto leaf : all_leaves_) {
+        delete leaf;
+    }
+    for (auto inner : all_inners_) {
+        delete inner;
+    }
+}
+
+BTree::Leaf* BTree::new_leaf() {
+    Leaf* leaf;
+    if (free_leaves_.empty()) {
+        leaf = new Leaf;
+        all_leaves_.push_back(leaf);
+    } else {
+        leaf = free_leaves_.back();
+        free_leaves_.pop_back();
+    }
+    leaf->leaf = true;
+    leaf->n = 0;
+    leaf->parent = nullptr;
+    leaf->prev = nullptr;
+    leaf->next = nullptr;
+    return leaf;
+}
+
+BTree::Inner* BTree::new_inner() {
+    Inner* inner;
+    if (free_inners_.empty()) {
+        inner = new Inner;
+        all_inners_.push_back(inner);
+    } else {
+        inner = free_inners_.back();
+        free_inners_.pop_back();
+    }
+    inner->leaf = false;
+    inner->n = 0;
+    inner->parent = nullptr;
+    return inner;
+}
+
+void BTree::free_node(Node* node) {
+    if (node->leaf) {
+        free_leaves_.push_back((Leaf *) node);
+    } else {
+        free_inners_.push_back((Inner *) node);
+    }
+}
+
+void BTree::write_begin() {
+    lock_.lock();
+    version_.store(version_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void BTree::write_end() {
+    version_.store(version_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_release);
+    lock_.unlock();
+}
+
+int BTree::compare(const NormKey& key, const uint64_t* pre, const Leaf* leaf, int i) const {
+    for (int w = 0; w < 2; w++) {
+        if (pre[w] != leaf->pre[i][w]) {
+            return (pre[w] < leaf->pre[i][w]) ? -1 : 1;
+        }
+    }
+    if (exact_) {
+        return 0;
+    }
+    return key.compare(NormKey(leaf->rows[i]));
+}
+
+int BTree::search_leaf(const Leaf* leaf, const NormKey& key, const uint64_t* pre, bool upper) const {
+    // n is clamped for the optimistic searches, which may see it torn.
+    int lo = 0, hi = std::max(0, std::min((int) leaf->n, leaf_cap));
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = compare(key, pre, leaf, mid);
+        if (upper ? cmp >= 0 : cmp > 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+BTree::Leaf* BTree::descend(const NormKey& key, bool upper) const {
+    Node* node = root_;
+    // deeper than any tree can grow: a racing writer sent us in circles.
+    for (int depth = 0; depth < 64 && node != nullptr; depth++) {
+        if (node->leaf) {
+            return (Leaf *) node;
+        }
+        const Inner* inner = (const Inner *) node;
+        int lo = 0, hi = std::max(0, std::min((int) inner->n, inner_cap));
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            int cmp = key.compare(inner->keys[mid]);
+            if (upper ? cmp >= 0 : cmp > 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        node = inner->children[lo];
+    }
+    return nullptr;
+}
+
+BTree::iterator BTree::bound(const NormKey& key, bool upper) const {
+    uint64_t pre[2];
+    key.prefix(pre);
+    return read([&] () {
+        Leaf* leaf = descend(key, upper);
+        if (leaf == nullptr) {
+            return end();
+        }
+        return at(leaf, search_leaf(leaf, key, pre, upper));
+    });
+}
+
+BTree::iterator BTree::lower_bound(const NormKey& key) const {
+    return bound(key, false);
+}
+
+BTree::iterator BTree::upper_bound(const NormKey& key) const {
+    return bound(key, true);
+}
+
+std::pair<BTree::iterator, BTree::iterator> BTree::equal_range(const NormKey& key) const {
+    uint64_t pre[2];
+    key.prefix(pre);
+    return read([&] () {
+        Leaf* low = descend(key, false);
+        Leaf* high = descend(key, true);
+        if (low == nullptr || high == nullptr) {
+            return std::make_pair(end(), end());
+        }
+        return std::make_pair(at(low, search_leaf(low, key, pre, false)),
+                              at(high, search_leaf(high, key, pre, true)));
+    });
+}
+
+BTree::iterator BTree::seek(const Bound& b) const {
+    switch (b.kind) {
+    case Bound::BEGIN:
+        return begin();
+    case Bound::END:
+        return end();
+    case Bound::LOWER:
+        return lower_bound(b.key);
+    default:
+        return upper_bound(b.key);
+    }
+}
+
+Row* BTree::find(const NormKey& key) const {
+    uint64_t pre[2];
+    key.prefix(pre);
+    return read([&] () -> Row* {
+        Leaf* leaf = descend(key, false);
+        if (leaf == nullptr) {
+            return nullptr;
+        }
+        iterator it = at(leaf, search_leaf(leaf, key, pre, false));
+        if (it.leaf_ == nullptr || it.idx_ >= leaf_cap
+                || compare(key, pre, it.leaf_, it.idx_) != 0) {
+            return nullptr;
+        }
+        return it.leaf_->rows[it.idx_];
+    });
+}
+
+BTree::iterator BTree::find(const NormKey& key, const Row* row) const {
+    auto range = equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (*it == row) {
+            return it;
+        }
+    }
+    return end();
+}
+
+void BTree::insert(const NormKey& key, Row* row) {
+    uint64_t pre[2];
+    key.prefix(pre);
+    write_begin();
+    Leaf* leaf = descend(key, true);
+    int i = search_leaf(leaf, key, pre, true);
+    if (leaf->n == leaf_cap) {
+        split_leaf(leaf);
+        if (i > leaf->n) {
+            i -= leaf->n;
+            leaf = leaf->next;
+        }
+    }
+    int after = leaf->n - i;
+    memmove(leaf->pre + i + 1, leaf->pre + i, after * sizeof(leaf->pre[0]));
+    memmove(leaf->rows + i + 1, leaf->rows + i, after * sizeof(Row *));
+    leaf->pre[i][0] = pre[0];
+    leaf->pre[i][1] = pre[1];
+    leaf->rows[i] = row;
+    leaf->n++;
+    size_++;
+    write_end();
+}
+
+void BTree::split_leaf(Leaf* leaf) {
+    Leaf* right = new_leaf();
+    int half = leaf->n / 2;
+    int moved = leaf->n - half;
+    memcpy(right->pre, leaf->pre + half, moved * sizeof(leaf->pre[0]));
+    memcpy(right->rows, leaf->rows + half, moved * sizeof(Row *));
+    right->n = moved;
+    leaf->n = half;
+
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next != nullptr) {
+        leaf->next->prev = right;
+    } else {
+        last_ = right;
+    }
+    leaf->next = right;
+    insert_parent(leaf, NormKey(right->rows[0]), right);
+}
+
+int BTree::child_index(const Inner* parent, const Node* child) {
+    for (int i = 0; i <= parent->n; i++) {
+        if (parent->children[i] == child) {
+            return i;
+        }
+    }
+    verify(0);
+    return -1;
+}
+
+void BTree::insert_parent(Node* left, const NormKey& key, Node* right) {
+    Inner* parent = left->parent;
+    if (parent == nullptr) {
+        Inner* root = new_inner();
+        root->keys[0] = key;
+        root->children[0] = left;
+        root->children[1] = right;
+        root->n = 1;
+        left->parent = root;
+        right->parent = root;
+        root_ = root;
+        return;
+    }
+    if (parent->n == inner_cap) {
+        // keys[mid] moves up, the ones after it to the new sibling.
+        Inner* sibling = new_inner();
+        int mid = inner_cap / 2;
+        int moved = inner_cap - mid - 1;
+        NormKey up = parent->keys[mid];
+        for (int i = 0; i < moved; i++) {
+            sibling->keys[i] = parent->keys[mid + 1 + i];
+        }
+        for (int i = 0; i <= moved; i++) {
+            sibling->children[i] = parent->children[mid + 1 + i];
+            sibling->children[i]->parent = sibling;
+        }
+        sibling->n = moved;
+        parent->n = mid;
+        insert_parent(parent, up, sibling);
+        parent = left->parent;
+    }
+    int pos = child_index(parent, left);
+    for (int i = parent->n; i > pos; i--) {
+        parent->keys[i] = parent->keys[i - 1];
+        parent->children[i + 1] = parent->children[i];
+    }
+    parent->keys[pos] = key;
+    parent->children[pos + 1] = right;
+    right->parent = parent;
+    parent->n++;
+}
+
+void BTree::remove_child(Node* child) {
+    Inner* parent = child->parent;
+    int pos = child_index(parent, child);
+    free_node(child);
+    if (parent->n == 0) {
+        // it was the only child.
+        remove_child(parent);
+        return;
+    }
+    // the key on the left of the child goes with it, the first child takes
+    // the first key along.
+    for (int i = std::max(pos - 1, 0); i < parent->n - 1; i++) {
+        parent->keys[i] = parent->keys[i + 1];
+    }
+    for (int i = pos; i < parent->n; i++) {
+        parent->children[i] = parent->children[i + 1];
+    }
+    parent->n--;
+    if (parent == root_ && parent->n == 0) {
+        root_ = parent->children[0];
+        root_->parent = nullptr;
+        free_node(parent);
+    }
+}
+
+BTree::iterator BTree::erase(iterator it) {
+    verify(it.leaf_ != nullptr);
+    write_begin();
+    Leaf* leaf = it.leaf_;
+    int i = it.idx_;
+    int after = leaf->n - i - 1;
+    memmove(leaf->pre + i, leaf->pre + i + 1, after * sizeof(leaf->pre[0]));
+    memmove(leaf->rows + i, leaf->rows + i + 1, after * sizeof(Row *));
+    leaf->n--;
+    size_--;
+    iterator next;
+    if (leaf->n == 0 && leaf != root_) {
+        if (leaf->prev != nullptr) {
+            leaf->prev->next = leaf->next;
+        } else {
+            first_ = leaf->next;
+        }
+        if (leaf->next != nullptr) {
+            leaf->next->prev = leaf->prev;
+        } else {
+            last_ = leaf->prev;
+        }
+        next = iterator(this, leaf->next, 0);
+        remove_child(leaf);
+    } else {
+        next = at(leaf, i);
+    }
+    write_end();
+    return next;
+}
+
+void BTree::clear() {
+    write_begin();
+    free_leaves_ = all_leaves_;
+    free_inners_ = all_inners_;
+    first_ = last_ = new_leaf();
+    root_ = first_;
+    size_ = 0;
+    write_end();
+}
+
+int BTree::height() const {
+    int h = 1;
+    for (Node* node = root_; !node->leaf; node = ((Inner *) node)->children[0]) {
+        h++;
+    }
+    return h;
+}
+
+} // namespace mdb
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
+#include "blob.h"
+
+namespace mdb {
+
+class Row;
+class Schema;
+
+// A key in a form that memcmp orders the way SortedMultiKey::compare does:
+// the key columns one after the other, integers big-endian with the sign
+// bit flipped, doubles with the bits flipped the IEEE way, strings with
+// their 0 bytes escaped and ended by 0 0. Keys up to inline_size bytes
+// stay inline.
+class NormKey {
+public:
+    static const int inline_size = 48;
+
+    NormKey(): len_(0) {}
+    NormKey(const MultiBlob& mb, const Schema* schema);
+    // the key columns of the row.
+    explicit NormKey(const Row* row);
+
+    const char* data() const {
+        return (len_ <= inline_size) ? buf_ : spill_.data();
+    }
+    int size() const {
+        return len_;
+    }
+
+    // -1, 0, 1 as SortedMultiKey::compare.
+    int compare(const NormKey& o) const;
+
+    // the first 16 bytes as two big-endian words, zero padded: comparing
+    // the words compares the keys up to there.
+    void prefix(uint64_t* w) const;
+
+private:
+    void append(const blob& b, int kind);
+    void put(const void* p, int n);
+
+    char buf_[inline_size];
+    std::string spill_;
+    int len_;
+};
+
+// B+tree of the rows of a SortedTable, ordered by their keys. Rows with
+// equal keys stay in the order they came in, as in std::multimap.
+//
+// A leaf keeps the first 16 bytes of each key next to the row. When no key
+// of the schema is longer, as with all integer keys of tpcc, a search
+// never leaves the arrays of the nodes; otherwise keys with the same
+// prefix are told apart by the keys of the rows.
+//
+// Writers are serialized by a spinlock and move version_ to an odd number
+// while they change the tree. Searches of trees without string keys take
+// no lock: they run optimistically and start over if version_ moved under
+// them. Nodes are recycled but only freed with the tree, so a search
+// racing a writer may read a stale node but never a freed one. Walking the
+// rows found, as the Cursors do, needs the tree to hold still, just like
+// the iterators of std::multimap did.
+//
+// Leaves and inner nodes that become empty are unlinked; nodes are not
+// merged otherwise.
+class BTree: public NoCopy {
+public:
+    static const int leaf_cap = 32;
+    static const int inner_cap = 32;
+
+private:
+    struct Inner;
+
+    struct Node {
+        bool leaf;
+        // entries of a leaf, keys of an inner node.
+        int n;
+        Inner* parent;
+    };
+
+    struct Leaf: public Node {
+        uint64_t pre[leaf_cap][2];
+        Row* rows[leaf_cap];
+        Leaf* prev;
+        Leaf* next;
+    };
+
+    // every row under children[i] <= keys[i] <= every row under children[i + 1].
+    struct Inner: public Node {
+        NormKey keys[inner_cap];
+        Node* children[inner_cap + 1];
+    };
+
+public:
+
+    class iterator {
+        friend class BTree;
+        const BTree* tree_;
+        Leaf* leaf_;
+        int idx_;
+        iterator(const BTree* tree, Leaf* leaf, int idx): tree_(tree), leaf_(leaf), idx_(idx) {}
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Row* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Row* const* pointer;
+        typedef Row* reference;
+
+        iterator(): tree_(nullptr), leaf_(nullptr), idx_(0) {}
+
+        Row* operator* () const {
+            return leaf_->rows[idx_];
+        }
+        iterator& operator++ () {
+            if (++idx_ >= leaf_->n) {
+                leaf_ = leaf_->next;
+                idx_ = 0;
+            }
+            return *this;
+        }
+        iterator operator++ (int) {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+        iterator& operator-- () {
+            if (leaf_ == nullptr) {
+                leaf_ = tree_->last_;
+                idx_ = leaf_->n - 1;
+            } else if (idx_ == 0) {
+                leaf_ = leaf_->prev;
+                idx_ = leaf_->n - 1;
+            } else {
+                idx_--;
+            }
+            return *this;
+        }
+        iterator operator-- (int) {
+            iterator it = *this;
+            --*this;
+            return it;
+        }
+        bool operator== (const iterator& o) const {
+            return leaf_ == o.leaf_ && idx_ == o.idx_;
+        }
+        bool operator!= (const iterator& o) const {
+            return !(*this == o);
+        }
+    };
+
+    // one end of a range of rows: the first row, past the last row, or the
+    // lower or upper bound of a key. a range kept as its bounds can be
+    // found again after the tree changed, iterators would point astray.
+    struct Bound {
+        enum kind_t { BEGIN, END, LOWER, UPPER };
+        kind_t kind;
+        NormKey key;
+
+        explicit Bound(kind_t k): kind(k) {}
+        Bound(kind_t k, const NormKey& nk): kind(k), key(nk) {}
+    };
+
+    explicit BTree(const Schema* schema);
+    ~BTree();
+
+    iterator begin() const {
+        return at(first_, 0);
+    }
+    iterator end() const {
+        return iterator(this, nullptr, 0);
+    }
+    size_t size() const {
+        return size_;
+    }
+
+    // first row >= key, first row > key, both.
+    iterator lower_bound(const NormKey& key) const;
+    iterator upper_bound(const NormKey& key) const;
+    std::pair<iterator, iterator> equal_range(const NormKey& key) const;
+    iterator seek(const Bound& bound) const;
+
+    // the first row with the key, or nullptr. safe to call while another
+    // thread writes, on trees without string keys.
+    Row* find(const NormKey& key) const;
+    // where the row is, or end().
+    iterator find(const NormKey& key, const Row* row) const;
+
+    // after the rows with an equal key.
+    void insert(const NormKey& key, Row* row);
+    // the row after the erased one.
+    iterator erase(iterator it);
+    // drops every row, does not release them.
+    void clear();
+
+    int height() const;
+
+private:
+
+    iterator at(Leaf* leaf, int idx) const {
+        if (idx >= leaf->n) {
+            return iterator(this, leaf->next, 0);
+        }
+        return iterator(this, leaf, idx);
+    }
+
+    // -1, 0, 1 as key compares to entry i of the leaf.
+    int compare(const NormKey& key, const uint64_t* pre, const Leaf* leaf, int i) const;
+    // first entry > key (upper) or >= key of the leaf.
+    int search_leaf(const Leaf* leaf, const NormKey& key, const uint64_t* pre, bool upper) const;
+    // the leaf holding the bound, nullptr if a racing writer got in the way.
+    Leaf* descend(const NormKey& key, bool upper) const;
+    iterator bound(const NormKey& key, bool upper) const;
+
+    template <class F>
+    auto read(F f) const -> decltype(f()) {
+        if (!optimistic_) {
+            lock_.lock();
+            auto ret = f();
+            lock_.unlock();
+            return ret;
+        }
+        for (;;) {
+            uint64_t v = version_.load(std::memory_order_acquire);
+            if (v & 1) {
+                continue;
+            }
+            auto ret = f();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version_.load(std::memory_order_relaxed) == v) {
+                return ret;
+            }
+        }
+    }
+    void write_begin();
+    void write_end();
+
+    Leaf* new_leaf();
+    Inner* new_inner();
+    void free_node(Node* node);
+
+    void split_leaf(Leaf* leaf);
+    void insert_parent(Node* left, const NormKey& key, Node* right);
+    void remove_child(Node* child);
+    static int child_index(const Inner* parent, const Node* child);
+
+    const Schema* schema_;
+    // every key fits in the 16 bytes of the leaves.
+    bool exact_;
+    // no string keys, searches need no lock.
+    bool optimistic_;
+
+    Node* root_;
+    Leaf* first_;
+    Leaf* last_;
+    size_t size_ = 0;
+
+    mutable rrr::SpinLock lock_;
+    std::atomic<uint64_t> version_{0};
+
+    std::vector<Leaf*> all_leaves_, free_leaves_;
+    std::vector<Inner*> all_inners_, free_inners_;
+};
+
+} // namespace mdb
@@ -0,0 +1,131 @@
+#include "locking.h"
+
+namespace mdb {
+
+const uint64_t RWLock::WRITER;
+const lock_owner_t RWLock::NO_OWNER;
+const int RWLock::n_inline;
+const int RWLock::chunk_size;
+
+RWLock::Chunk::Chunk(): next(nullptr) {
+    for (auto& r : owners) {
+        r.store(NO_OWNER, std::memory_order_relaxed);
+    }
+}
+
+RWLock::~RWLock() {
+    Chunk* c = more_.load();
+    while (c != nullptr) {
+        Chunk* next = c->next.load();
+        delete c;
+        c = next;
+    }
+}
+
+RWLock& RWLock::operator= (const RWLock& o) {
+    if (this != &o) {
+        copy_from(o);
+    }
+    return *this;
+}
+
+// not atomic as a whole, for copying rows nobody else is locking.
+void RWLock::copy_from(const RWLock& o) {
+    for (auto& r : r_) {
+        r.store(NO_OWNER);
+    }
+    for (Chunk* c = more_.load(); c != nullptr; c = c->next.load()) {
+        for (auto& r : c->owners) {
+            r.store(NO_OWNER);
+        }
+    }
+    word_.store(0);
+    w_.store(NO_OWNER);
+    if (o.is_wlocked()) {
+        word_.store(WRITER);
+        w_.store(o.w_.load());
+    }
+    for (lock_owner_t r : o.rlock_owner()) {
+        add_reader(r);
+        word_.fetch_add(1);
+    }
+}
+
+std::atomic<lock_owner_t>* RWLock::find_reader(lock_owner_t o) {
+    for (auto& r : r_) {
+        if (r.load() == o) {
+            return &r;
+        }
+    }
+    for (Chunk* c = more_.load(); c != nullptr; c = c->next.load()) {
+        for (auto& r : c->owners) {
+            if (r.load() == o) {
+                return &r;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void RWLock::add_reader(lock_owner_t o) {
+    for (auto& r : r_) {
+        lock_owner_t empty = NO_OWNER;
+        if (r.compare_exchange_strong(empty, o)) {
+            return;
+        }
+    }
+    std::atomic<Chunk*>* link = &more_;
+    for (;;) {
+        Chunk* c = link->load();
+        if (c == nullptr) {
+            Chunk* fresh = new Chunk;
+            if (link->compare_exchange_strong(c, fresh)) {
+                c = fresh;
+            } else {
+                // another reader hung a chunk here first
+                delete fresh;
+            }
+        }
+        for (auto& r : c->owners) {
+            lock_owner_t empty = NO_OWNER;
+            if (r.compare_exchange_strong(empty, o)) {
+                return;
+            }
+        }
+        link = &c->next;
+    }
+}
+
+bool RWLock::remove_reader(lock_owner_t o) {
+    std::atomic<lock_owner_t>* r = find_reader(o);
+    if (r == nullptr) {
+        return false;
+    }
+    r->store(NO_OWNER);
+    return true;
+}
+
+std::vector<lock_owner_t> RWLock::rlock_owner() const {
+    std::vector<lock_owner_t> owners;
+    if (is_wlocked()) {
+        // the slot of an upgraded reader may not be cleared yet
+        return owners;
+    }
+    for (auto& r : r_) {
+        lock_owner_t o = r.load();
+        if (o != NO_OWNER) {
+            owners.push_back(o);
+        }
+    }
+    for (Chunk* c = more_.load(); c != nullptr; c = c->next.load()) {
+        for (auto& r : c->owners) {
+            lock_owner_t o = r.load();
+            if (o != NO_OWNER) {
+                owners.push_back(o);
+            }
+        }
+    }
+    return owners;
+}
+
+}
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <unordered_set>
+#include <atomic>
+#include <limits>
+#include <vector>
 
 #include "utils.h"
 
@@ -8,70 +10,115 @@ namespace mdb {
 
 typedef i64 lock_owner_t;
 
+// A reader-writer lock held by owners (txn ids) rather than threads.
+//
+// The state is one word: a writer bit and the number of read owners. The
+// owners themselves sit in a few inline slots, with chunks of more slots
+// hung off them when a row has many readers at once, so taking a shared
+// lock allocates nothing in the common case. Every operation is a CAS on
+// the word plus a CAS on a slot, which lets several threads lock rows
+// without a mutex around the lock table.
+//
+// Calls for one owner must not race each other (a txn locks its rows from
+// one thread at a time); calls for different owners may.
 class RWLock {
-    bool wlocked_;
-    lock_owner_t w_;    // write access owner
-    std::unordered_set<lock_owner_t> r_; // read access owner
+    static const uint64_t WRITER = 1ull << 63;
+    static const lock_owner_t NO_OWNER = std::numeric_limits<lock_owner_t>::min();
+    static const int n_inline = 3;
+    static const int chunk_size = 8;
+
+    struct Chunk {
+        std::atomic<lock_owner_t> owners[chunk_size];
+        std::atomic<Chunk*> next;
+        Chunk();
+    };
+
+    std::atomic<uint64_t> word_;
+    std::atomic<lock_owner_t> w_;    // write access owner
+    std::atomic<lock_owner_t> r_[n_inline]; // read access owners
+    std::atomic<Chunk*> more_;       // more read access owners
+
+    std::atomic<lock_owner_t>* find_reader(lock_owner_t o);
+    void add_reader(lock_owner_t o);
+    bool remove_reader(lock_owner_t o);
+    void copy_from(const RWLock& o);
 
 public:
 
-    RWLock(): wlocked_(false), w_(0) {}
+    RWLock(): word_(0), w_(NO_OWNER), more_(nullptr) {
+        for (auto& r : r_) {
+            r.store(NO_OWNER, std::memory_order_relaxed);
+        }
+    }
+    RWLock(const RWLock& o): RWLock() {
+        copy_from(o);
+    }
+    RWLock& operator= (const RWLock& o);
+    ~RWLock();
+
     bool is_wlocked() const {
-        assert(!wlocked_ || r_.empty());
-        return wlocked_;
+        return (word_.load() & WRITER) != 0;
     }
     bool is_rlocked() const {
-        assert(!wlocked_ || r_.empty());
-        return !r_.empty();
+        return (word_.load() & ~WRITER) != 0;
     }
     bool wlock_by(lock_owner_t o) {
-        if (wlocked_) {
-            return o == w_;
-        } else if (r_.empty()) {
-            wlocked_ = true;
-            w_ = o;
-            return true;
-        } else {
-            // already rlocked, check if can upgrade lock
-            auto it = r_.find(o);
-            if (it != r_.end() && r_.size() == 1) {
-                // lock upgrade
-                r_.erase(it);
-                wlocked_ = true;
-                w_ = o;
-                return true;
+        uint64_t w = word_.load();
+        for (;;) {
+            if (w & WRITER) {
+                return o == w_.load();
+            } else if (w == 0) {
+                if (word_.compare_exchange_weak(w, WRITER)) {
+                    w_.store(o);
+                    return true;
+                }
+            } else if (w == 1 && find_reader(o) != nullptr) {
+                // the only reader is o, lock upgrade
+                if (word_.compare_exchange_weak(w, WRITER)) {
+                    find_reader(o)->store(NO_OWNER);
+                    w_.store(o);
+                    return true;
+                }
             } else {
                 return false;
             }
         }
     }
     bool rlock_by(lock_owner_t o) {
-        if (wlocked_) {
-            return o == w_;
-        } else {
-            r_.insert(o);
+        if (find_reader(o) != nullptr) {
             return true;
         }
+        uint64_t w = word_.load();
+        for (;;) {
+            if (w & WRITER) {
+                // w_ is cleared before the writer bit, a stale read
+                // never names a past writer.
+                return o == w_.load();
+            } else if (word_.compare_exchange_weak(w, w + 1)) {
+                add_reader(o);
+                return true;
+            }
+        }
     }
     bool unlock_by(lock_owner_t o) {
         bool ret = false;
-        if (wlocked_ && o == w_) {
-            wlocked_ = false;
-            assert(r_.find(o) == r_.end());
+        if ((word_.load() & WRITER) && o == w_.load()) {
+            w_.store(NO_OWNER);
+            word_.fetch_and(~WRITER);
             ret = true;
         }
-        if (r_.erase(o) != 0) {
+        if (remove_reader(o)) {
+            word_.fetch_sub(1);
             ret = true;
         }
         return ret;
     }
     lock_owner_t wlock_owner() const {
-        verify(wlocked_);
-        return w_;
-    }
-    const std::unordered_set<lock_owner_t>& rlock_owner() const {
-        return r_;
+        verify(is_wlocked());
+        return w_.load();
     }
+    // a snapshot of the read access owners.
+    std::vector<lock_owner_t> rlock_owner() const;
 };
 
 }
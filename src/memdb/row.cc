@@ -86,30 +86,35 @@ void Row::make_sparse() {
 }
 
 Value Row::get_column(int column_id) const {
-    Value v;
     verify(schema_);
     const Schema::column_info* info = schema_->get_column_info(column_id);
     blob b = this->get_blob(column_id);
     verify(info != nullptr);
     switch (info->type) {
     case Value::I32:
-        v = Value(*((i32*) b.data));
-        break;
+        return Value(*((i32*) b.data));
     case Value::I64:
-        v = Value(*((i64*) b.data));
-        break;
+        return Value(*((i64*) b.data));
     case Value::DOUBLE:
-        v = Value(*((double*) b.data));
-        break;
+        return Value(*((double*) b.data));
     case Value::STR:
-        v = Value(std::string(b.data, b.len));
-        break;
+        return Value(std::string(b.data, b.len));
     default:
         Log::fatal("unexpected value type %d", info->type);
         verify(0);
         break;
     }
-    return v;
+    return Value();
+}
+
+Value Row::get_column_view(int column_id) const {
+    verify(schema_);
+    const Schema::column_info* info = schema_->get_column_info(column_id);
+    verify(info != nullptr);
+    if (info->type == Value::STR) {
+        return Value::borrow(this->get_blob(column_id));
+    }
+    return this->get_column(column_id);
 }
 
 MultiBlob Row::get_key() const {
@@ -300,7 +305,7 @@ Row* Row::create(Row* raw_row, const Schema* schema, const std::vector<const Val
             fixed_pos += sizeof(double);
             break;
         case Value::STR:
-            var_part_size += it->get_str().size();
+            var_part_size += it->get_blob().len;
             break;
         default:
             Log::fatal("unexpected value type %d", it->get_kind());
@@ -338,7 +343,7 @@ Row* Row::create(Row* raw_row, const Schema* schema, const std::vector<const Val
         for (auto& it: values) {
             if (it->get_kind() == Value::STR) {
                 it->write_binary(&row->dense_var_part_[var_pos]);
-                var_pos += it->get_str().size();
+                var_pos += it->get_blob().len;
                 row->dense_var_idx_[var_counter] = var_pos;
                 var_counter++;
             }
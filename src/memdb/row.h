@@ -6,6 +6,7 @@
 #include <vector>
 #include <string>
 #include <ctime>
+#include <cstring>
 
 #include "utils.h"
 #include "schema.h"
@@ -122,6 +123,13 @@ class Row: public RefCounted {
   }
   virtual MultiBlob get_key() const;
 
+  // a STR column is borrowed from the row rather than copied, for values
+  // that do not outlive it, see Value::borrow().
+  Value get_column_view(int column_id) const;
+  Value get_column_view(const std::string &col_name) const {
+    return get_column_view(schema_->get_column_id(col_name));
+  }
+
   blob get_blob(int column_id) const;
   blob get_blob(const std::string &col_name) const {
     return get_blob(schema_->get_column_id(col_name));
@@ -511,70 +519,125 @@ class FineLockedRow: public Row {
 
 
 // inherit from CoarseLockedRow since we need locking on commit phase, when doing 2 phase commit
+// A row with a version for each column. The versions are allocated in
+// the same block as the row, right after it.
+//
+// Tapir also tracks the versions that prepared txns read and write. They
+// go in a side table that exists only while the row has prepares in flight.
 class VersionedRow: public CoarseLockedRow {
+  struct prepared_ver_t {
+    colid_t column_id;
+    bool write;
+    version_t ver;
+  };
+  // nullptr while no prepare is in flight.
+  std::vector<prepared_ver_t> *prepared_ = nullptr;
+
+  version_t *vers() {
+    return reinterpret_cast<version_t *>(this + 1);
+  }
+  const version_t *vers() const {
+    return reinterpret_cast<const version_t *>(this + 1);
+  }
+
+  explicit VersionedRow(int n_columns) {
+    memset(vers(), 0, sizeof(version_t) * n_columns);
+  }
+
+  // room for the versions after the row.
+  static void *operator new(size_t size, int n_columns) {
+    return ::operator new(size + sizeof(version_t) * n_columns);
+  }
+  static void operator delete(void *p, int n_columns) {
+    ::operator delete(p);
+  }
+
+  void insert_prepared(colid_t column_id, bool write, version_t ver) {
+    if (prepared_ == nullptr) {
+      prepared_ = new std::vector<prepared_ver_t>;
+    }
+    prepared_->push_back({column_id, write, ver});
+  }
+
+  void remove_prepared(colid_t column_id, bool write, version_t ver) {
+    if (prepared_ == nullptr) {
+      return;
+    }
+    for (auto it = prepared_->begin(); it != prepared_->end(); it++) {
+      if (it->column_id == column_id && it->write == write && it->ver == ver) {
+        prepared_->erase(it);
+        break;
+      }
+    }
+    if (prepared_->empty()) {
+      delete prepared_;
+      prepared_ = nullptr;
+    }
+  }
+
  public:
-//  version_t *ver_ = nullptr;
-  std::vector<version_t> ver_{};
-  // only for tapir. TODO: extract
-  std::vector<list<version_t>> prepared_rver_{};
-  // only for tapir. TODO: extract
-  std::vector<list<version_t>> prepared_wver_{};
-  void init_ver(int n_columns) {
-//    ver_ = new version_t[n_columns];
-//    memset(ver_, 0, sizeof(version_t) * n_columns);
-    ver_.resize(n_columns, 0);
-    prepared_rver_.resize(n_columns, {});
-    prepared_wver_.resize(n_columns, {});
-  }
-
-  version_t max_prepared_rver(colid_t column_id) {
-    if (prepared_wver_[column_id].size() > 0) {
-      return prepared_wver_[column_id].back();
-    } else {
-      return 0;
+
+  static void operator delete(void *p) {
+    ::operator delete(p);
+  }
+
+  // the largest version a prepared txn read the column at, or 0.
+  version_t max_prepared_rver(colid_t column_id) const {
+    version_t ret = 0;
+    if (prepared_ != nullptr) {
+      for (auto &p : *prepared_) {
+        if (p.column_id == column_id && !p.write && p.ver > ret) {
+          ret = p.ver;
+        }
+      }
     }
+    return ret;
   }
 
-  version_t min_prepared_wver(colid_t column_id) {
-    if (prepared_rver_[column_id].size() > 0) {
-      return prepared_rver_[column_id].front();
-    } else {
-      return 0;
+  // the smallest version a prepared txn writes the column at, or 0.
+  version_t min_prepared_wver(colid_t column_id) const {
+    version_t ret = 0;
+    if (prepared_ != nullptr) {
+      for (auto &p : *prepared_) {
+        if (p.column_id == column_id && p.write && (ret == 0 || p.ver < ret)) {
+          ret = p.ver;
+        }
+      }
     }
+    return ret;
   }
 
   void insert_prepared_wver(colid_t column_id, version_t ver) {
-    prepared_wver_[column_id].push_back(ver);
-    prepared_rver_[column_id].sort(); // TODO optimize
+    insert_prepared(column_id, true, ver);
   }
 
   void remove_prepared_wver(colid_t column_id, version_t ver) {
-    prepared_wver_[column_id].remove(ver);
+    remove_prepared(column_id, true, ver);
   }
 
   void insert_prepared_rver(colid_t column_id, version_t ver) {
-    prepared_rver_[column_id].push_back(ver);
-    prepared_rver_[column_id].sort(); // TODO optimize
+    insert_prepared(column_id, false, ver);
   }
 
   void remove_prepared_rver(colid_t column_id, version_t ver) {
-    prepared_rver_[column_id].remove(ver);
+    remove_prepared(column_id, false, ver);
+  }
+
+  bool has_prepared() const {
+    return prepared_ != nullptr;
   }
 
  protected:
 
   // protected dtor as required by RefCounted
   ~VersionedRow() {
-//    delete[] ver_;
+    delete prepared_;
   }
 
   void copy_into(VersionedRow *row) const {
     this->CoarseLockedRow::copy_into((CoarseLockedRow *) row);
     int n_columns = schema_->columns_count();
-    row->init_ver(n_columns);
-//    memcpy(row->ver_, this->ver_, n_columns * sizeof(version_t));
-    row->ver_ = this->ver_;
-    verify(row->ver_.size() > 0);
+    memcpy(row->vers(), this->vers(), sizeof(version_t) * n_columns);
   }
 
  public:
@@ -584,21 +647,21 @@ class VersionedRow: public CoarseLockedRow {
   }
 
   version_t get_column_ver(colid_t column_id) const {
-    verify(ver_.size() > 0);
-    verify(column_id < ver_.size());
-    return ver_[column_id];
+    verify(column_id < schema_->columns_count());
+    return vers()[column_id];
   }
 
   void set_column_ver(colid_t column_id, version_t ver) {
-    ver_[column_id] = ver;
+    vers()[column_id] = ver;
   }
 
   void incr_column_ver(colid_t column_id) {
-    ver_[column_id] ++;
+    vers()[column_id] ++;
   }
 
   virtual Row *copy() const {
-    VersionedRow *row = new VersionedRow();
+    int n_columns = schema_->columns_count();
+    VersionedRow *row = new(n_columns) VersionedRow(n_columns);
     copy_into(row);
     return row;
   }
@@ -619,8 +682,8 @@ class VersionedRow: public CoarseLockedRow {
       fill_values_ptr(schema, values_ptr, *it, fill_counter);
       fill_counter++;
     }
-    VersionedRow *raw_row = new VersionedRow();
-    raw_row->init_ver(schema->columns_count());
+    int n_columns = schema->columns_count();
+    VersionedRow *raw_row = new(n_columns) VersionedRow(n_columns);
     return (VersionedRow *) Row::create(raw_row, schema, values_ptr);
   }
 };
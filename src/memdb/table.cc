@@ -78,44 +78,40 @@ int SortedMultiKey::compare(const SortedMultiKey& o) const {
 
 
 SortedTable::~SortedTable() {
-    for (auto& it: rows_) {
-        it.second->release();
+    for (Row* row: rows_) {
+        row->release();
     }
 }
 
 void SortedTable::clear() {
-    for (auto& it: rows_) {
-        it.second->release();
+    for (Row* row: rows_) {
+        row->release();
     }
     rows_.clear();
 }
 
 void SortedTable::remove(const SortedMultiKey& smk) {
-    auto query_range = rows_.equal_range(smk);
-    iterator it = query_range.first;
-    while (it != query_range.second) {
-        it = remove(it);
-    }
+    auto query_range = rows_.equal_range(NormKey(smk.get_multi_blob(), schema_));
+    remove(Cursor(query_range.first, query_range.second));
 }
 
 void SortedTable::remove(Row* row, bool do_free /* =? */) {
-    SortedMultiKey smk = SortedMultiKey(row->get_key(), schema_);
-    auto query_range = rows_.equal_range(smk);
-    iterator it = query_range.first;
-    while (it != query_range.second) {
-        if (it->second == row) {
-            it->second->set_table(nullptr);
-            it = remove(it, do_free);
-            break;
-        } else {
-            ++it;
-        }
+    iterator it = rows_.find(NormKey(row), row);
+    if (it != rows_.end()) {
+        row->set_table(nullptr);
+        remove(it, do_free);
     }
 }
 
 void SortedTable::remove(Cursor cur) {
+    // erasing moves the rows after it within their leaf, cur.end() would
+    // not stay put. count the rows instead.
+    int n = 0;
+    for (iterator it = cur.begin(); it != cur.end(); ++it) {
+        n++;
+    }
     iterator it = cur.begin();
-    while (it != cur.end()) {
+    for (int i = 0; i < n; i++) {
         it = this->remove(it);
     }
 }
@@ -123,7 +119,7 @@ void SortedTable::remove(Cursor cur) {
 SortedTable::iterator SortedTable::remove(iterator it, bool do_free /* =? */) {
     if (it != rows_.end()) {
         if (do_free) {
-            it->second->release();
+            (*it)->release();
         }
         return rows_.erase(it);
     } else {
@@ -132,49 +128,171 @@ SortedTable::iterator SortedTable::remove(iterator it, bool do_free /* =? */) {
 }
 
 UnsortedTable::~UnsortedTable() {
-    for (auto& it: rows_) {
-        it.second->release();
+    for (auto& slot: slots_) {
+        if (slot.row != nullptr) {
+            slot.row->release();
+        }
     }
 }
 
+uint32_t UnsortedTable::hash_row(const Row* row) const {
+    const std::vector<int>& key_cols = schema_->key_columns_id();
+    uint32_t v = 0;
+    for (size_t i = 0; i < key_cols.size(); i++) {
+        v = MultiBlob::hash::step(v, i, row->get_blob(key_cols[i]));
+    }
+    return v;
+}
+
+bool UnsortedTable::key_matches(const Row* row, const MultiBlob& key) const {
+    const std::vector<int>& key_cols = schema_->key_columns_id();
+    if (key.count() != (int) key_cols.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < key_cols.size(); i++) {
+        if (!(row->get_blob(key_cols[i]) == key[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ssize_t UnsortedTable::find(const MultiBlob& key, uint32_t hash, size_t pos) const {
+    if (slots_.empty()) {
+        return -1;
+    }
+    for (;; pos = (pos + 1) & mask()) {
+        const slot_t& slot = slots_[pos];
+        if (slot.row == nullptr) {
+            return -1;
+        }
+        if (slot.hash == hash && key_matches(slot.row, key)) {
+            return pos;
+        }
+    }
+}
+
+void UnsortedTable::place(uint32_t hash, Row* row) {
+    size_t pos = hash & mask();
+    while (slots_[pos].row != nullptr) {
+        pos = (pos + 1) & mask();
+    }
+    slots_[pos].hash = hash;
+    slots_[pos].row = row;
+}
+
+void UnsortedTable::grow() {
+    std::vector<slot_t> old(std::max<size_t>(16, slots_.size() * 2),
+                            slot_t{0, nullptr});
+    old.swap(slots_);
+    for (auto& slot: old) {
+        if (slot.row != nullptr) {
+            place(slot.hash, slot.row);
+        }
+    }
+}
+
+void UnsortedTable::insert(Row* row) {
+    verify(row->schema() == schema_);
+    row->set_table(this);
+    if ((n_rows_ + 1) * 4 > slots_.size() * 3) {
+        grow();
+    }
+    place(hash_row(row), row);
+    n_rows_++;
+}
+
+UnsortedTable::Cursor UnsortedTable::query(const MultiBlob& key) {
+    uint32_t hash = MultiBlob::hash()(key);
+    Row* first = nullptr;
+    std::vector<Row*> more;
+    for (ssize_t pos = find(key, hash, hash & mask());
+         pos >= 0;
+         pos = find(key, hash, (pos + 1) & mask())) {
+        if (first == nullptr) {
+            first = slots_[pos].row;
+        } else {
+            more.push_back(slots_[pos].row);
+        }
+    }
+    return Cursor(first, std::move(more));
+}
+
+void UnsortedTable::erase(size_t pos) {
+    size_t next = pos;
+    for (;;) {
+        next = (next + 1) & mask();
+        const slot_t& slot = slots_[next];
+        if (slot.row == nullptr) {
+            break;
+        }
+        // the row at next may take the free slot if that does not put it
+        // before its home slot.
+        size_t home = slot.hash & mask();
+        if (((next - home) & mask()) >= ((next - pos) & mask())) {
+            slots_[pos] = slot;
+            pos = next;
+        }
+    }
+    slots_[pos].hash = 0;
+    slots_[pos].row = nullptr;
+    n_rows_--;
+}
+
 void UnsortedTable::clear() {
-    for (auto& it: rows_) {
-        it.second->release();
+    for (auto& slot: slots_) {
+        if (slot.row != nullptr) {
+            slot.row->release();
+            slot.row = nullptr;
+            slot.hash = 0;
+        }
     }
-    rows_.clear();
+    n_rows_ = 0;
 }
 
 void UnsortedTable::remove(const MultiBlob& key) {
-    auto query_range = rows_.equal_range(key);
-    iterator it = query_range.first;
-    while (it != query_range.second) {
-        it = remove(it);
+    uint32_t hash = MultiBlob::hash()(key);
+    ssize_t pos;
+    // the shift of erase() may move a later duplicate into pos, start over
+    // from the home slot every time.
+    while ((pos = find(key, hash, hash & mask())) >= 0) {
+        Row* row = slots_[pos].row;
+        erase(pos);
+        row->release();
     }
 }
 
 void UnsortedTable::remove(Row* row, bool do_free /* =? */) {
-    auto query_range = rows_.equal_range(row->get_key());
-    iterator it = query_range.first;
-    while (it != query_range.second) {
-        if (it->second == row) {
-            it->second->set_table(nullptr);
-            it = remove(it, do_free);
+    if (slots_.empty()) {
+        return;
+    }
+    uint32_t hash = hash_row(row);
+    for (size_t pos = hash & mask();
+         slots_[pos].row != nullptr;
+         pos = (pos + 1) & mask()) {
+        if (slots_[pos].row == row) {
+            row->set_table(nullptr);
+            erase(pos);
+            if (do_free) {
+                row->release();
+            }
             break;
-        } else {
-            ++it;
         }
     }
 }
 
-UnsortedTable::iterator UnsortedTable::remove(iterator it, bool do_free /* =? */) {
-    if (it != rows_.end()) {
-        if (do_free) {
-            it->second->release();
+size_t UnsortedTable::max_chain() const {
+    size_t longest = 0, run = 0;
+    // twice around, so a run wrapping past the end is counted whole.
+    for (size_t i = 0; i < 2 * slots_.size(); i++) {
+        if (slots_[i & mask()].row != nullptr) {
+            run++;
+            longest = std::max(longest, run);
+        } else {
+            run = 0;
         }
-        return rows_.erase(it);
-    } else {
-        return rows_.end();
     }
+    return std::min(longest, n_rows_);
 }
 
 
@@ -260,9 +378,9 @@ IndexedTable::IndexedTable(std::string name, const IndexedSchema* schema): Sorte
 }
 
 IndexedTable::~IndexedTable() {
-    for (auto& it: rows_) {
+    for (Row* row: rows_) {
         // get rid of the index
-        Value ptr_value = it.second->get_column(index_column_id());
+        Value ptr_value = row->get_column(index_column_id());
         master_index* idx = (master_index *) ptr_value.get_i64();
         delete idx;
     }
@@ -309,7 +427,7 @@ void IndexedTable::remove(Index::Cursor idx_cursor) {
 IndexedTable::iterator IndexedTable::remove(iterator it, bool do_free /* =? */) {
     if (it != rows_.end()) {
         if (do_free) {
-            Row* row = it->second;
+            Row* row = *it;
             Value ptr_value = row->get_column(index_column_id());
             master_index* idx = (master_index *) ptr_value.get_i64();
             destroy_secondary_indices(idx);
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 #include <unordered_map>
 
 #include "value.h"
@@ -9,6 +10,7 @@
 #include "schema.h"
 #include "utils.h"
 #include "blob.h"
+#include "btree.h"
 
 #include "snapshot.h"
 
@@ -84,34 +86,62 @@ public:
 
 class SortedTable: public Table {
 protected:
-    typedef std::multimap<SortedMultiKey, Row*>::const_iterator iterator;
-    typedef std::multimap<SortedMultiKey, Row*>::const_reverse_iterator reverse_iterator;
+    typedef BTree::iterator iterator;
+    typedef std::reverse_iterator<BTree::iterator> reverse_iterator;
 
     virtual iterator remove(iterator it, bool do_free = true);
 
     // indexed by key values
-    std::multimap<SortedMultiKey, Row*> rows_;
+    BTree rows_;
 public:
 
+    // a range of rows. a Cursor made from the bounds of a query finds them
+    // again on reset(), so it stays good across changes of the table, as the
+    // iterators of std::multimap did.
     class Cursor: public Enumerator<const Row*> {
         iterator begin_, end_, next_;
         reverse_iterator r_begin_, r_end_, r_next_;
         int count_;
         bool reverse_;
+        const BTree* tree_;
+        BTree::Bound low_, high_;
+
+        void seek() {
+            begin_ = tree_->seek(low_);
+            end_ = tree_->seek(high_);
+            if (reverse_) {
+                r_begin_ = reverse_iterator(end_);
+                r_end_ = reverse_iterator(begin_);
+                r_next_ = r_begin_;
+            } else {
+                next_ = begin_;
+            }
+            count_ = -1;
+        }
     public:
-        Cursor(const iterator& begin, const iterator& end): count_(-1), reverse_(false) {
+        Cursor(const iterator& begin, const iterator& end)
+                : count_(-1), reverse_(false), tree_(nullptr),
+                  low_(BTree::Bound::BEGIN), high_(BTree::Bound::END) {
             begin_ = begin;
             end_ = end;
             next_ = begin;
         }
-        Cursor(const reverse_iterator& begin, const reverse_iterator& end): count_(-1), reverse_(true) {
+        Cursor(const reverse_iterator& begin, const reverse_iterator& end)
+                : count_(-1), reverse_(true), tree_(nullptr),
+                  low_(BTree::Bound::BEGIN), high_(BTree::Bound::END) {
             r_begin_ = begin;
             r_end_ = end;
             r_next_ = begin;
         }
+        Cursor(const BTree* tree, const BTree::Bound& low, const BTree::Bound& high, bool reverse)
+                : count_(-1), reverse_(reverse), tree_(tree), low_(low), high_(high) {
+            seek();
+        }
 
         void reset() {
-            if (reverse_) {
+            if (tree_ != nullptr) {
+                seek();
+            } else if (reverse_) {
                 r_next_ = r_begin_;
             } else {
                 next_ = begin_;
@@ -144,11 +174,11 @@ public:
             Row* row = nullptr;
             if (reverse_) {
                 verify(r_next_ != r_end_);
-                row = r_next_->second;
+                row = *r_next_;
                 ++r_next_;
             } else {
                 verify(next_ != end_);
-                row = next_->second;
+                row = *next_;
                 ++next_;
             }
             return row;
@@ -172,7 +202,7 @@ public:
 
     virtual uint64_t size() {return rows_.size();}
 
-    SortedTable(std::string name, const Schema* schema): Table(name, schema) {}
+    SortedTable(std::string name, const Schema* schema): Table(name, schema), rows_(schema) {}
 
     ~SortedTable();
 
@@ -181,10 +211,9 @@ public:
     }
 
     void insert(Row* row) {
-        SortedMultiKey key = SortedMultiKey(row->get_key(), schema_);
         verify(row->schema() == schema_);
         row->set_table(this);
-        insert_into_map(rows_, key, row);
+        rows_.insert(NormKey(row), row);
     }
 
     Cursor query(const Value& kv) {
@@ -194,10 +223,9 @@ public:
         return query(SortedMultiKey(mb, schema_));
     }
     Cursor query(const SortedMultiKey& smk) {
-        auto first = rows_.begin();
-        auto last = rows_.rbegin();
-        auto range = rows_.equal_range(smk);
-        return Cursor(range.first, range.second);
+        NormKey key(smk.get_multi_blob(), schema_);
+        return Cursor(&rows_, BTree::Bound(BTree::Bound::LOWER, key),
+                      BTree::Bound(BTree::Bound::UPPER, key), false);
     }
 
     Cursor query_lt(const Value& kv, symbol_t order = symbol_t::ORD_ASC) {
@@ -208,12 +236,9 @@ public:
     }
     Cursor query_lt(const SortedMultiKey& smk, symbol_t order = symbol_t::ORD_ASC) {
         verify(order == symbol_t::ORD_ASC || order == symbol_t::ORD_DESC || order == symbol_t::ORD_ANY);
-        auto bound = rows_.lower_bound(smk);
-        if (order == symbol_t::ORD_DESC) {
-            return Cursor(reverse_iterator(bound), rows_.rend());
-        } else {
-            return Cursor(rows_.begin(), bound);
-        }
+        return Cursor(&rows_, BTree::Bound(BTree::Bound::BEGIN),
+                      BTree::Bound(BTree::Bound::LOWER, NormKey(smk.get_multi_blob(), schema_)),
+                      order == symbol_t::ORD_DESC);
     }
 
     Cursor query_gt(const Value& kv, symbol_t order = symbol_t::ORD_ASC) {
@@ -224,12 +249,8 @@ public:
     }
     Cursor query_gt(const SortedMultiKey& smk, symbol_t order = symbol_t::ORD_ASC) {
         verify(order == symbol_t::ORD_ASC || order == symbol_t::ORD_DESC || order == symbol_t::ORD_ANY);
-        auto bound = rows_.upper_bound(smk);
-        if (order == symbol_t::ORD_DESC) {
-            return Cursor(rows_.rbegin(), reverse_iterator(bound));
-        } else {
-            return Cursor(bound, rows_.end());
-        }
+        return Cursor(&rows_, BTree::Bound(BTree::Bound::UPPER, NormKey(smk.get_multi_blob(), schema_)),
+                      BTree::Bound(BTree::Bound::END), order == symbol_t::ORD_DESC);
     }
 
     // (low, high) not inclusive
@@ -242,22 +263,15 @@ public:
     Cursor query_in(const SortedMultiKey& low, const SortedMultiKey& high, symbol_t order = symbol_t::ORD_ASC) {
         verify(order == symbol_t::ORD_ASC || order == symbol_t::ORD_DESC || order == symbol_t::ORD_ANY);
         verify(low < high);
-        auto low_bound = rows_.upper_bound(low);
-        auto high_bound = rows_.lower_bound(high);
-        if (order == symbol_t::ORD_DESC) {
-            return Cursor(reverse_iterator(high_bound), reverse_iterator(low_bound));
-        } else {
-            return Cursor(low_bound, high_bound);
-        }
+        return Cursor(&rows_, BTree::Bound(BTree::Bound::UPPER, NormKey(low.get_multi_blob(), schema_)),
+                      BTree::Bound(BTree::Bound::LOWER, NormKey(high.get_multi_blob(), schema_)),
+                      order == symbol_t::ORD_DESC);
     }
 
     Cursor all(symbol_t order = symbol_t::ORD_ASC) const {
         verify(order == symbol_t::ORD_ASC || order == symbol_t::ORD_DESC || order == symbol_t::ORD_ANY);
-        if (order == symbol_t::ORD_DESC) {
-            return Cursor(rows_.rbegin(), rows_.rend());
-        } else {
-            return Cursor(std::begin(rows_), std::end(rows_));
-        }
+        return Cursor(&rows_, BTree::Bound(BTree::Bound::BEGIN),
+                      BTree::Bound(BTree::Bound::END), order == symbol_t::ORD_DESC);
     }
 
     void clear();
@@ -274,41 +288,84 @@ public:
 };
 
 
+// Open addressing with linear probing over a flat array of slots. A slot
+// keeps the hash of the row's key next to the row, four slots to a cache
+// line, so a probe compares keys only on a full hash match. Rows with the
+// same key are allowed, they sit in the same probe chain.
 class UnsortedTable: public Table {
-    typedef std::unordered_multimap<MultiBlob, Row*, MultiBlob::hash>::const_iterator iterator;
-
 public:
 
+    struct slot_t {
+        uint32_t hash;
+        // nullptr for a free slot.
+        Row* row;
+    };
+
     class Cursor: public Enumerator<const Row*> {
-        iterator begin_, end_, next_;
-        int count_;
+        // all(): walk the slots, skipping the free ones.
+        const slot_t* slots_;
+        size_t n_slots_;
+        bool scan_;
+        // query(): the matching rows, collected when the cursor is made. a
+        //   unique key has at most one, more_ only holds duplicates.
+        Row* first_;
+        std::vector<Row*> more_;
+        size_t next_;
+
+        size_t n_matches() const {
+            return (first_ == nullptr) ? 0 : 1 + more_.size();
+        }
+        void skip_free() {
+            while (next_ < n_slots_ && slots_[next_].row == nullptr) {
+                next_++;
+            }
+        }
     public:
-        Cursor(const iterator& begin, const iterator& end): begin_(begin), end_(end), next_(begin), count_(-1) {}
+        Cursor(const slot_t* slots, size_t n_slots)
+                : slots_(slots), n_slots_(n_slots), scan_(true),
+                  first_(nullptr), next_(0) {
+            skip_free();
+        }
+        Cursor(Row* first, std::vector<Row*>&& more)
+                : slots_(nullptr), n_slots_(0), scan_(false),
+                  first_(first), more_(std::move(more)), next_(0) {}
 
         void reset() {
-            next_ = begin_;
+            next_ = 0;
+            if (scan_) {
+                skip_free();
+            }
         }
 
         bool has_next() {
-            return next_ != end_;
+            return next_ < (scan_ ? n_slots_ : n_matches());
         }
         operator bool () {
             return has_next();
         }
         Row* next() {
-            verify(next_ != end_);
-            Row* row = next_->second;
-            ++next_;
+            verify(has_next());
+            Row* row;
+            if (scan_) {
+                row = slots_[next_++].row;
+                skip_free();
+            } else {
+                row = (next_ == 0) ? first_ : more_[next_ - 1];
+                next_++;
+            }
             return row;
         }
         int count() {
-            if (count_ < 0) {
-                count_ = 0;
-                for (auto it = begin_; it != end_; ++it) {
-                    count_++;
+            if (!scan_) {
+                return n_matches();
+            }
+            int n = 0;
+            for (size_t i = 0; i < n_slots_; i++) {
+                if (slots_[i].row != nullptr) {
+                    n++;
                 }
             }
-            return count_;
+            return n;
         }
     };
 
@@ -320,22 +377,18 @@ public:
         return TBL_UNSORTED;
     }
 
-    void insert(Row* row) {
-        MultiBlob key = row->get_key();
-        verify(row->schema() == schema_);
-        row->set_table(this);
-        insert_into_map(rows_, key, row);
+    virtual uint64_t size() {
+        return n_rows_;
     }
 
+    void insert(Row* row);
+
     Cursor query(const Value& kv) {
         return query(kv.get_blob());
     }
-    Cursor query(const MultiBlob& key) {
-        auto range = rows_.equal_range(key);
-        return Cursor(range.first, range.second);
-    }
+    Cursor query(const MultiBlob& key);
     Cursor all() const {
-        return Cursor(std::begin(rows_), std::end(rows_));
+        return Cursor(slots_.data(), slots_.size());
     }
 
     void clear();
@@ -346,12 +399,29 @@ public:
     void remove(const MultiBlob& key);
     void remove(Row* row, bool do_free = true);
 
+    // longest run of occupied slots, the worst probe of a lookup.
+    size_t max_chain() const;
+
 private:
 
-    iterator remove(iterator it, bool do_free = true);
+    // the same hash as MultiBlob::hash of the row's key.
+    uint32_t hash_row(const Row* row) const;
+    bool key_matches(const Row* row, const MultiBlob& key) const;
+    // slot of the first row with the key from pos on, or -1.
+    ssize_t find(const MultiBlob& key, uint32_t hash, size_t pos) const;
+    void place(uint32_t hash, Row* row);
+    // frees slot pos, shifting back the rows after it in the probe chain
+    // so no chain is left with a hole.
+    void erase(size_t pos);
+    void grow();
 
-    // indexed by key values
-    std::unordered_multimap<MultiBlob, Row*, MultiBlob::hash> rows_;
+    size_t mask() const {
+        return slots_.size() - 1;
+    }
+
+    // a power of two, at most 3/4 full.
+    std::vector<slot_t> slots_;
+    size_t n_rows_ = 0;
 };
 
 
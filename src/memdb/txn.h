@@ -246,6 +246,8 @@ class Txn: public NoCopy {
 
 class TxnMgr: public NoCopy {
   std::map<std::string, Table *> tables_;
+  // indexed by table_id()
+  std::vector<Table *> tables_by_id_;
 
  public:
 
@@ -267,6 +269,15 @@ class TxnMgr: public NoCopy {
   void reg_table(const std::string &tbl_name, Table *tbl) {
     verify(tables_.find(tbl_name) == tables_.end());
     insert_into_map(tables_, tbl_name, tbl);
+    tblid_t tbl_id = table_id(tbl_name);
+    if (tbl_id >= (tblid_t) tables_by_id_.size()) {
+      tables_by_id_.resize(tbl_id + 1, nullptr);
+    }
+    tables_by_id_[tbl_id] = tbl;
+  }
+
+  const std::map<std::string, Table *> &tables() const {
+    return tables_;
   }
 
   Table *get_table(const std::string &tbl_name) const {
@@ -278,6 +289,13 @@ class TxnMgr: public NoCopy {
     }
   }
 
+  Table *get_table(tblid_t tbl_id) const {
+    if (tbl_id >= (tblid_t) tables_by_id_.size()) {
+      return nullptr;
+    }
+    return tables_by_id_[tbl_id];
+  }
+
   UnsortedTable *get_unsorted_table(const std::string &tbl_name) const;
   SortedTable *get_sorted_table(const std::string &tbl_name) const;
   SnapshotTable *get_snapshot_table(const std::string &tbl_name) const;
@@ -1,5 +1,7 @@
 #include <unistd.h>
 
+#include <mutex>
+
 #include "MurmurHash3.h"
 #include "xxhash.h"
 
@@ -7,6 +9,19 @@
 
 namespace mdb {
 
+tblid_t table_id(const std::string& tbl_name) {
+    static std::mutex mtx;
+    static std::unordered_map<std::string, tblid_t> ids;
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = ids.find(tbl_name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    tblid_t id = ids.size();
+    ids[tbl_name] = id;
+    return id;
+}
+
 uint32_t stringhash32(const void* data, int len) {
     uint32_t hash_value;
     static int seed = getpid();
@@ -15,6 +30,10 @@ uint32_t stringhash32(const void* data, int len) {
     return hash_value;
 }
 
+uint32_t stringhash32(const void* data, int len, uint32_t seed) {
+    return XXH32(data, len, seed);
+}
+
 uint64_t stringhash64(const void* data, int len) {
     uint64_t hash_value[2];
     static int seed = getpid();
@@ -19,6 +19,7 @@ using base::format_decimal;
 
 typedef uint64_t version_t;
 typedef int colid_t;
+typedef int tblid_t;
 
 typedef enum {
     NONE,
@@ -49,7 +50,13 @@ typedef enum {
     OCC_LAZY,
 } symbol_t;
 
+// ids of the table names of the process, dense and starting from 0. a
+// name has the same id in every TxnMgr, resolve it once and keep the id.
+tblid_t table_id(const std::string& tbl_name);
+
 uint32_t stringhash32(const void* data, int len);
+// with the given seed instead of the one of the process.
+uint32_t stringhash32(const void* data, int len, uint32_t seed);
 
 inline uint32_t stringhash32(const std::string& str) {
     return stringhash32(&str[0], str.size());
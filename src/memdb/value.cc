@@ -1,4 +1,5 @@
 #include <sstream>
+#include <algorithm>
 
 #include "value.h"
 
@@ -41,15 +42,19 @@ int Value::compare(const Value& o) const {
         }
         break;
 
-    case STR:
-        if (*p_str_ < *o.p_str_) {
+    case STR: {
+        // byte-wise, as std::string compares.
+        size_t n = str_size(), o_n = o.str_size();
+        int r = memcmp(str_data(), o.str_data(), std::min(n, o_n));
+        if (r < 0 || (r == 0 && n < o_n)) {
             return -1;
-        } else if (*p_str_ == *o.p_str_) {
+        } else if (r == 0 && n == o_n) {
             return 0;
         } else {
             return 1;
         }
         break;
+    }
 
     default:
         Log::fatal("unexpected value type %d", k_);
@@ -73,7 +78,7 @@ void Value::write_binary(char* buf) const {
         memcpy(buf, &double_, sizeof(double));
         break;
     case Value::STR:
-        memcpy(buf, &((*p_str_)[0]), p_str_->size());
+        memcpy(buf, str_data(), str_size());
         break;
     default:
         Log::fatal("cannot write_binary() on value type %d", k_);
@@ -98,8 +103,8 @@ blob Value::get_blob() const {
         b.len = sizeof(double);
         break;
     case Value::STR:
-        b.data = &((*p_str_)[0]);
-        b.len = p_str_->size();
+        b.data = str_data();
+        b.len = str_size();
         break;
     default:
         Log::fatal("cannot get_blob() on value type %d", k_);
@@ -124,7 +129,8 @@ std::ostream& operator<< (std::ostream& o, const Value& v) {
         o << "DOUBLE:" << v.double_;
         break;
     case Value::STR:
-        o << "STR:" << *v.p_str_;
+        o << "STR:";
+        o.write(v.str_data(), v.str_size());
         break;
     default:
         Log::fatal("unexpected value type %d", v.k_);
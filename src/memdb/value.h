@@ -25,40 +25,63 @@ public:
     explicit Value(i32 v): k_(I32), i32_(v) {}
     explicit Value(i64 v): k_(I64), i64_(v) {}
     explicit Value(double v): k_(DOUBLE), double_(v) {}
-    explicit Value(const std::string& s): k_(STR), p_str_(new std::string(s)) {}
-    explicit Value(const char* str): k_(STR), p_str_(new std::string(str)) {}
+    explicit Value(const std::string& s): k_(STR) {
+        new (&str_) std::string(s);
+    }
+    explicit Value(std::string&& s): k_(STR) {
+        new (&str_) std::string(std::move(s));
+    }
+    explicit Value(const char* str): k_(STR) {
+        new (&str_) std::string(str);
+    }
 
-    Value(const Value& o) {
-        k_ = o.k_;
-        i32_ = o.i32_;
-        i64_ = o.i64_;
-        double_ = o.double_;
-        if (k_ == STR) {
-            p_str_ = new std::string(*o.p_str_);
-        }
+    /**
+     * A STR value that points to bytes it does not own, e.g. a column of a
+     * row handed to Row::create(). The bytes must outlive the value and
+     * whatever it is moved into; a copy owns its own string. get_str() is
+     * not available on it, read it with get_blob().
+     */
+    static Value borrow(const blob& b) {
+        Value v;
+        v.k_ = STR;
+        v.borrowed_ = true;
+        v.view_.data = b.data;
+        v.view_.len = b.len;
+        return v;
+    }
+
+    // ver_ stays with the object, copies and moves only take the data.
+    Value(const Value& o): k_(UNKNOWN) {
+        copy_from(o);
+    }
+
+    Value(Value&& o) noexcept: k_(UNKNOWN) {
+        move_from(o);
     }
 
     ~Value() {
-        if (k_ == STR) {
-            delete p_str_;
-        }
+        clear();
     }
 
     const Value& operator= (const Value& o) {
         if (this != &o) {
-            if (k_ == STR) {
-                delete p_str_;
-            }
-            k_ = o.k_;
-            i32_ = o.i32_;
-            i64_ = o.i64_;
-            double_ = o.double_;
-            if (k_ == STR) {
-                p_str_ = new std::string(*o.p_str_);
+            if (is_owned_str() && o.is_owned_str()) {
+                // reuses the capacity we have.
+                str_ = o.str_;
+            } else {
+                clear();
+                copy_from(o);
             }
         }
         return *this;
     }
+    const Value& operator= (Value&& o) noexcept {
+        if (this != &o) {
+            clear();
+            move_from(o);
+        }
+        return *this;
+    }
     const Value& operator= (i32 v) {
         this->set_i32(v);
         return *this;
@@ -133,8 +156,12 @@ public:
     }
 
     const std::string& get_str() const {
-        verify(k_ == STR);
-        return *p_str_;
+        verify(k_ == STR && !borrowed_);
+        return str_;
+    }
+
+    bool is_borrowed() const {
+        return borrowed_;
     }
 
     void set_i32(i32 v) {
@@ -164,10 +191,20 @@ public:
     void set_str(const std::string& str) {
         if (k_ == UNKNOWN) {
             k_ = STR;
-            p_str_ = new std::string(str);
+            new (&str_) std::string(str);
+        } else {
+            verify(k_ == STR && !borrowed_);
+            str_ = str;
+        }
+    }
+
+    void set_str(std::string&& str) {
+        if (k_ == UNKNOWN) {
+            k_ = STR;
+            new (&str_) std::string(std::move(str));
         } else {
-            verify(k_ == STR);
-            *p_str_ = str;
+            verify(k_ == STR && !borrowed_);
+            str_ = std::move(str);
         }
     }
 
@@ -177,13 +214,78 @@ public:
 
 private:
     kind k_;
+    bool borrowed_ = false;
+
+    struct view_t {
+        const char* data;
+        int len;
+    };
 
+    // strings live in place, short ones in the inline buffer of
+    // std::string, so most values never touch the heap.
     union {
         i32 i32_;
         i64 i64_;
         double double_;
-        std::string* p_str_;
+        std::string str_;
+        view_t view_;
     };
+
+    bool is_owned_str() const {
+        return k_ == STR && !borrowed_;
+    }
+
+    const char* str_data() const {
+        return borrowed_ ? view_.data : str_.data();
+    }
+
+    size_t str_size() const {
+        return borrowed_ ? view_.len : str_.size();
+    }
+
+    // only called on an UNKNOWN value.
+    void copy_from(const Value& o) {
+        switch (o.k_) {
+        case I32:
+            i32_ = o.i32_;
+            break;
+        case I64:
+            i64_ = o.i64_;
+            break;
+        case DOUBLE:
+            double_ = o.double_;
+            break;
+        case STR:
+            new (&str_) std::string(o.str_data(), o.str_size());
+            break;
+        default:
+            break;
+        }
+        k_ = o.k_;
+    }
+
+    // only called on an UNKNOWN value, leaves o UNKNOWN.
+    void move_from(Value& o) {
+        if (o.is_owned_str()) {
+            new (&str_) std::string(std::move(o.str_));
+            k_ = STR;
+        } else if (o.k_ == STR) {
+            view_ = o.view_;
+            k_ = STR;
+            borrowed_ = true;
+        } else {
+            copy_from(o);
+        }
+        o.clear();
+    }
+
+    void clear() {
+        if (is_owned_str()) {
+            str_.~basic_string();
+        }
+        k_ = UNKNOWN;
+        borrowed_ = false;
+    }
 };
 
 std::ostream& operator<< (std::ostream& o, const Value& v);
@@ -156,14 +156,13 @@ size_t SparseInt::dump(i64 val, char* buf) {
         buf[0] |= 0xFC;
         return 7;
     } else if (-36028797018963968LL <= val && val <= 36028797018963967LL) {
-        buf[1] = pv[7];
-        buf[2] = pv[6];
-        buf[3] = pv[5];
-        buf[4] = pv[4];
-        buf[5] = pv[3];
-        buf[6] = pv[2];
-        buf[7] = pv[1];
-        buf[8] = pv[0];
+        buf[1] = pv[6];
+        buf[2] = pv[5];
+        buf[3] = pv[4];
+        buf[4] = pv[3];
+        buf[5] = pv[2];
+        buf[6] = pv[1];
+        buf[7] = pv[0];
         buf[0] = 0xFE;
         return 8;
     } else {
@@ -219,6 +218,14 @@ i64 SparseInt::load_i64(const char* buf) {
                 pv[i] = 0xFF;
             }
         }
+    } else if (bsize == 8) {
+        // 7 bytes after the 0xFE, sign extended
+        for (int i = 0; i < 7; i++) {
+            pv[i] = buf[7 - i];
+        }
+        if (pv[6] & 0x80) {
+            pv[7] = 0xFF;
+        }
     } else {
         for (int i = 0; i < 8; i++) {
             pv[i] = buf[8 - i];
@@ -3,6 +3,7 @@
 #include <cstdio>
 #include <cinttypes>
 #include <string>
+#include <atomic>
 #include <functional>
 
 #include "basetypes.hpp"
@@ -70,13 +71,15 @@ erase(Container& l,
 
 class Job {
  public:
+  // set by PollMgr::remove, the poll thread holding the job drops it.
+  std::atomic<bool> removed_{false};
   virtual bool Ready() = 0;
   virtual void Work() = 0;
   virtual bool Done() = 0;
   virtual ~Job(){};
 };
 
-class OneTimeJob : Job {
+class OneTimeJob : public Job {
  public:
   OneTimeJob(std::function<void()> func) : func_(func) {
   }
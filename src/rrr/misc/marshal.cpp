@@ -15,6 +15,11 @@ static Counter g_marshal_in_stat[12];
 static Counter g_marshal_in_stat_cumulative[12];
 static Counter g_marshal_out_stat[12];
 static Counter g_marshal_out_stat_cumulative[12];
+static Counter g_marshal_in_syscall;
+static Counter g_marshal_out_syscall;
+static Counter g_marshal_copy_bytes;
+static Counter g_marshal_share_bytes;
+static Counter g_marshal_rpc;
 static uint64_t g_marshal_stat_report_time = 0;
 static const uint64_t g_marshal_stat_report_interval = 1000 * 1000 * 1000;
 
@@ -54,9 +59,25 @@ static void stat_marshal_report() {
         }
         Log::info("* MARSHAL OUT (cumulative): %s", ostr.str().c_str());
     }
+    {
+        i64 n_rpc = g_marshal_rpc.peek_next();
+        if (n_rpc > 0) {
+            Log::info("* MARSHAL PER RPC: read=%.2lf writev=%.2lf copied=%.1lf shared=%.1lf",
+                      double(g_marshal_in_syscall.peek_next()) / n_rpc,
+                      double(g_marshal_out_syscall.peek_next()) / n_rpc,
+                      double(g_marshal_copy_bytes.peek_next()) / n_rpc,
+                      double(g_marshal_share_bytes.peek_next()) / n_rpc);
+        }
+        g_marshal_in_syscall.reset();
+        g_marshal_out_syscall.reset();
+        g_marshal_copy_bytes.reset();
+        g_marshal_share_bytes.reset();
+        g_marshal_rpc.reset();
+    }
 }
 
 void stat_marshal_in(int fd, const void* buf, size_t nbytes, ssize_t ret) {
+    g_marshal_in_syscall.next();
     if (ret == -1) {
         g_marshal_in_stat[0].next();
     } else if (ret < 16) {
@@ -91,6 +112,7 @@ void stat_marshal_in(int fd, const void* buf, size_t nbytes, ssize_t ret) {
 }
 
 void stat_marshal_out(int fd, const void* buf, size_t nbytes, ssize_t ret) {
+    g_marshal_out_syscall.next();
     if (ret == -1) {
         g_marshal_out_stat[0].next();
     } else if (ret < 16) {
@@ -124,6 +146,18 @@ void stat_marshal_out(int fd, const void* buf, size_t nbytes, ssize_t ret) {
     }
 }
 
+void stat_marshal_copy(size_t nbytes) {
+    g_marshal_copy_bytes.next(nbytes);
+}
+
+void stat_marshal_share(size_t nbytes) {
+    g_marshal_share_bytes.next(nbytes);
+}
+
+void stat_marshal_rpc() {
+    g_marshal_rpc.next();
+}
+
 #endif // RPC_STATISTICS
 
 /**
@@ -132,6 +166,12 @@ void stat_marshal_out(int fd, const void* buf, size_t nbytes, ssize_t ret) {
  */
 const size_t Marshal::raw_bytes::min_size = 8192;
 
+/**
+ * Sharing a chunk costs an allocation, and the next write has to start a
+ * new 8kb chunk after it, so small slices are cheaper to copy.
+ */
+const size_t Marshal::min_share_size = 1024;
+
 Marshal::~Marshal() {
     chunk* chnk = head_;
     while (chnk != nullptr) {
@@ -153,6 +193,38 @@ size_t Marshal::content_size_slow() const {
     return sz;
 }
 
+void Marshal::append_chunk(chunk* chnk) {
+    assert(tail_ == nullptr || tail_->next == nullptr);
+
+    if (tail_ != nullptr && !tail_->fully_written()) {
+        if (tail_->content_size() > 0) {
+            tail_->seal();
+        } else {
+            // an empty tail would be stuck in the middle, drop it instead.
+            chunk* prev = nullptr;
+            if (head_ != tail_) {
+                prev = head_;
+                while (prev->next != tail_) {
+                    prev = prev->next;
+                }
+            }
+            delete tail_;
+            tail_ = prev;
+            if (prev == nullptr) {
+                head_ = nullptr;
+            } else {
+                prev->next = nullptr;
+            }
+        }
+    }
+    if (head_ == nullptr) {
+        head_ = tail_ = chnk;
+    } else {
+        tail_->next = chnk;
+        tail_ = chnk;
+    }
+}
+
 size_t Marshal::write(const void* p, size_t n) {
     assert(tail_ == nullptr || tail_->next == nullptr);
 
@@ -269,27 +341,22 @@ size_t Marshal::read_from_marshal(Marshal& m, size_t n) {
     assert(m.content_size() >= n);   // require m.content_size() >= n > 0
     size_t n_fetch = 0;
 
-    if ((head_ == nullptr && tail_ == nullptr) || tail_->fully_written()) {
+    if (n >= min_share_size || tail_ == nullptr || tail_->fully_written()) {
         // efficiently copy data by only copying pointers
         while (n_fetch < n) {
-            // NOTE: The copied chunk is shared by 2 Marshal objects. Be careful
-            //       that only one Marshal should be able to write to it! For the
-            //       given 2 use cases, it works.
+            // NOTE: The copied chunk is shared by 2 Marshal objects. It is
+            //       sealed, so only m may write more into it.
             chunk* chnk = m.head_->shared_copy();
             if (n_fetch + chnk->content_size() > n) {
                 // only fetch enough bytes we need
                 chnk->write_idx -= (n_fetch + chnk->content_size()) - n;
+                chnk->seal();
             }
             size_t cnt = chnk->content_size();
             assert(cnt > 0);
             n_fetch += cnt;
             verify(m.head_->discard(cnt) == cnt);
-            if (head_ == nullptr) {
-                head_ = tail_ = chnk;
-            } else {
-                tail_->next = chnk;
-                tail_ = chnk;
-            }
+            append_chunk(chnk);
             if (m.head_->fully_read()) {
                 if (m.tail_ == m.head_) {
                     // deleted the only chunk
@@ -304,11 +371,14 @@ size_t Marshal::read_from_marshal(Marshal& m, size_t n) {
         content_size_ += n_fetch;
         verify(m.content_size_ >= n_fetch);
         m.content_size_ -= n_fetch;
+#ifdef RPC_STATISTICS
+        stat_marshal_share(n_fetch);
+#endif // RPC_STATISTICS
 
     } else {
 
         // number of bytes that need to be copied
-        size_t copy_n = std::min(tail_->data->size - tail_->write_idx, n);
+        size_t copy_n = std::min(tail_->end_idx - tail_->write_idx, n);
         char* buf = new char[copy_n];
         n_fetch = m.read(buf, copy_n);
         verify(n_fetch == copy_n);
@@ -326,26 +396,93 @@ size_t Marshal::read_from_marshal(Marshal& m, size_t n) {
     return n_fetch;
 }
 
+size_t Marshal::write_external(const void* p, size_t n,
+                               std::shared_ptr<const void> holder) {
+    if (n == 0) {
+        return 0;
+    }
+    append_chunk(new chunk(p, n, std::move(holder)));
+    write_cnt_ += n;
+    content_size_ += n;
+    assert(content_size_ == content_size_slow());
+#ifdef RPC_STATISTICS
+    stat_marshal_share(n);
+#endif // RPC_STATISTICS
+    return n;
+}
+
+size_t Marshal::write_shared(const Marshal& m) {
+    if (m.content_size() < min_share_size) {
+        size_t n_copy = 0;
+        for (chunk* chnk = m.head_; chnk != nullptr; chnk = chnk->next) {
+            if (chnk->content_size() > 0) {
+                n_copy += write(chnk->data->ptr + chnk->read_idx,
+                                chnk->content_size());
+            }
+        }
+        return n_copy;
+    }
+    size_t n_shared = 0;
+    for (chunk* chnk = m.head_; chnk != nullptr; chnk = chnk->next) {
+        size_t cnt = chnk->content_size();
+        if (cnt > 0) {
+            append_chunk(chnk->shared_copy());
+            n_shared += cnt;
+        }
+    }
+    write_cnt_ += n_shared;
+    content_size_ += n_shared;
+    assert(content_size_ == content_size_slow());
+#ifdef RPC_STATISTICS
+    stat_marshal_share(n_shared);
+#endif // RPC_STATISTICS
+    return n_shared;
+}
 
 size_t Marshal::write_to_fd(int fd) {
     size_t n_write = 0;
     while (!empty()) {
-        int cnt = head_->write_to_fd(fd);
-        if (head_->fully_read()) {
-            if (head_ == tail_) {
-                tail_ = nullptr;
+        struct iovec iov[max_iov];
+        int n_iov = 0;
+        size_t n_bytes = 0;
+        for (chunk* chnk = head_; chnk != nullptr && n_iov < max_iov;
+             chnk = chnk->next) {
+            size_t sz = chnk->content_size();
+            if (sz > 0) {
+                iov[n_iov].iov_base = chnk->data->ptr + chnk->read_idx;
+                iov[n_iov].iov_len = sz;
+                n_iov++;
+                n_bytes += sz;
             }
-            chunk* chnk = head_;
-            head_ = head_->next;
-            delete chnk;
         }
+        ssize_t cnt = ::writev(fd, iov, n_iov);
+
+#ifdef RPC_STATISTICS
+        stat_marshal_out(fd, iov[0].iov_base, n_bytes, cnt);
+#endif // RPC_STATISTICS
+
         if (cnt <= 0) {
-            // currently there's no data available, so stop
             break;
         }
+        size_t left = cnt;
+        while (left > 0) {
+            left -= head_->discard(left);
+            if (head_->fully_read()) {
+                if (head_ == tail_) {
+                    tail_ = nullptr;
+                }
+                chunk* chnk = head_;
+                head_ = head_->next;
+                delete chnk;
+            }
+        }
         assert(content_size_ >= (size_t) cnt);
         content_size_ -= cnt;
         n_write += cnt;
+        if ((size_t) cnt < n_bytes) {
+            // the socket buffer is full, retrying now would only fail.
+            break;
+        }
     }
     assert(content_size_ == content_size_slow());
     return n_write;
@@ -9,9 +9,12 @@
 #include <unordered_set>
 #include <limits>
 
+#include <memory>
+
 #include <inttypes.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/uio.h>
 
 #include "base/all.hpp"
 
@@ -20,6 +23,11 @@ namespace rrr {
 #ifdef RPC_STATISTICS
 void stat_marshal_in(int fd, const void* buf, size_t nbytes, ssize_t ret);
 void stat_marshal_out(int fd, const void* buf, size_t nbytes, ssize_t ret);
+// bytes memcpy'd into a marshal, and bytes appended by reference instead.
+void stat_marshal_copy(size_t nbytes);
+void stat_marshal_share(size_t nbytes);
+// one rpc request or reply has been packed, for the per-rpc averages.
+void stat_marshal_rpc();
 #endif // RPC_STATISTICS
 
 // not thread safe, for better performance
@@ -27,6 +35,8 @@ class Marshal: public NoCopy {
   struct raw_bytes: public RefCounted {
     char *ptr = nullptr;
     size_t size = 0;
+    // set if ptr is memory owned by someone else, kept alive by the holder.
+    std::shared_ptr<const void> holder{};
     static const size_t min_size;
 
     raw_bytes(size_t sz = min_size) {
@@ -37,10 +47,21 @@ class Marshal: public NoCopy {
       size = std::max(n, min_size);
       ptr = new char[size];
       memcpy(ptr, p, n);
+#ifdef RPC_STATISTICS
+      stat_marshal_copy(n);
+#endif // RPC_STATISTICS
+    }
+    raw_bytes(const void *p, size_t n, std::shared_ptr<const void> h)
+        : ptr((char *) p), size(n), holder(std::move(h)) {
+      verify(holder);
     }
     raw_bytes(const raw_bytes &) = delete;
     raw_bytes &operator=(const raw_bytes &) = delete;
-    ~raw_bytes() { delete[] ptr; }
+    ~raw_bytes() {
+      if (!holder) {
+        delete[] ptr;
+      }
+    }
   };
 
   struct chunk: public NoCopy {
@@ -49,8 +70,8 @@ class Marshal: public NoCopy {
 
     chunk(raw_bytes *dt, size_t rd_idx, size_t wr_idx)
         : data((raw_bytes *) dt->ref_copy()), read_idx(rd_idx),
-          write_idx(wr_idx), next(nullptr) {
-      assert(write_idx <= data->size);
+          write_idx(wr_idx), end_idx(wr_idx), next(nullptr) {
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
     }
 
@@ -59,56 +80,73 @@ class Marshal: public NoCopy {
     raw_bytes *data;
     size_t read_idx;
     size_t write_idx;
+    // the chunk takes no more writes past this, data->size unless sealed.
+    size_t end_idx;
     chunk *next;
 
-    chunk() : data(new raw_bytes), read_idx(0), write_idx(0), next(nullptr) { }
+    chunk()
+        : data(new raw_bytes), read_idx(0), write_idx(0),
+          end_idx(data->size), next(nullptr) { }
     chunk(const void *p, size_t n)
         : data(new raw_bytes(p, n)), read_idx(0),
-          write_idx(n), next(nullptr) { }
+          write_idx(n), end_idx(data->size), next(nullptr) { }
+    // wraps external memory, nothing is copied.
+    chunk(const void *p, size_t n, std::shared_ptr<const void> holder)
+        : data(new raw_bytes(p, n, std::move(holder))), read_idx(0),
+          write_idx(n), end_idx(n), next(nullptr) { }
     chunk(const chunk&) = delete;
     chunk& operator=(const chunk&) = delete;
     ~chunk() { data->release(); }
 
-    // NOTE: This function is only intended for Marshal::read_from_marshal.
+    // A sealed chunk referring to the same bytes. The copy never writes into
+    // the shared raw_bytes, so the original can keep filling it.
     chunk *shared_copy() const {
       return new chunk(data, read_idx, write_idx);
     }
 
+    // stop writing into this chunk, the following data goes to a new one.
+    void seal() {
+      end_idx = write_idx;
+    }
+
     size_t content_size() const {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
       return write_idx - read_idx;
     }
 
     char *set_bookmark() {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
 
       char *p = &data->ptr[write_idx];
       write_idx++;
 
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
       return p;
     }
 
     size_t write(const void *p, size_t n) {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
 
-      size_t n_write = std::min(n, data->size - write_idx);
+      size_t n_write = std::min(n, end_idx - write_idx);
       if (n_write > 0) {
         memcpy(data->ptr + write_idx, p, n_write);
+#ifdef RPC_STATISTICS
+        stat_marshal_copy(n_write);
+#endif // RPC_STATISTICS
       }
       write_idx += n_write;
 
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
       return n_write;
     }
 
     size_t read(void *p, size_t n) {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
 
       size_t n_read = std::min(n, write_idx - read_idx);
@@ -117,13 +155,13 @@ class Marshal: public NoCopy {
       }
       read_idx += n_read;
 
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
       return n_read;
     }
 
     size_t peek(void *p, size_t n) const {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
 
       size_t n_peek = std::min(n, write_idx - read_idx);
@@ -135,43 +173,27 @@ class Marshal: public NoCopy {
     }
 
     size_t discard(size_t n) {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
 
       size_t n_discard = std::min(n, write_idx - read_idx);
       read_idx += n_discard;
 
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
       return n_discard;
     }
 
-    int write_to_fd(int fd) {
-      assert(write_idx <= data->size);
-      int cnt = ::write(fd, data->ptr + read_idx, write_idx - read_idx);
-
-#ifdef RPC_STATISTICS
-      stat_marshal_out(fd, data->ptr + write_idx, data->size - write_idx, cnt);
-#endif // RPC_STATISTICS
-
-      if (cnt > 0) {
-        read_idx += cnt;
-      }
-
-      assert(write_idx <= data->size);
-      return cnt;
-    }
-
     int read_from_fd(int fd) {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
 
       int cnt = 0;
-      if (write_idx < data->size) {
-        cnt = ::read(fd, data->ptr + write_idx, data->size - write_idx);
+      if (write_idx < end_idx) {
+        cnt = ::read(fd, data->ptr + write_idx, end_idx - write_idx);
 
 #ifdef RPC_STATISTICS
-        stat_marshal_in(fd, data->ptr + write_idx, data->size - write_idx, cnt);
+        stat_marshal_in(fd, data->ptr + write_idx, end_idx - write_idx, cnt);
 #endif // RPC_STATISTICS
 
         if (cnt > 0) {
@@ -179,23 +201,23 @@ class Marshal: public NoCopy {
         }
       }
 
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
       return cnt;
     }
 
     // check if it is not possible to write to the chunk anymore.
     bool fully_written() const {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
-      return write_idx == data->size;
+      return write_idx == end_idx;
     }
 
     // check if it is not possible to read any data even if retry later
     bool fully_read() const {
-      assert(write_idx <= data->size);
+      assert(write_idx <= end_idx);
       assert(read_idx <= write_idx);
-      return read_idx == data->size;
+      return read_idx == end_idx;
     }
   };
 
@@ -207,8 +229,17 @@ class Marshal: public NoCopy {
   // for debugging purpose
   size_t content_size_slow() const;
 
+  // link a chunk after the tail, sealing the tail so nothing is written
+  // into the middle of the list.
+  void append_chunk(chunk *chnk);
+
  public:
 
+  static const int max_iov = 64;
+  // smaller contents are copied rather than shared by read_from_marshal
+  // and write_shared.
+  static const size_t min_share_size;
+
   struct bookmark: public NoCopy {
     size_t size;
     char **ptr;
@@ -245,6 +276,19 @@ class Marshal: public NoCopy {
   // Use case 2: In Python extension, buffer message in Marshal object, and send to network.
   size_t read_from_marshal(Marshal &m, size_t n);
 
+  /**
+   * Append n bytes at p without copying them. The holder keeps the memory
+   * alive, it is released once the bytes have been read or sent.
+   */
+  size_t write_external(const void *p, size_t n,
+                        std::shared_ptr<const void> holder);
+  /**
+   * Append the content of m, which is left untouched. Unless it is small,
+   * the content is not copied, the chunks of m are referenced instead.
+   */
+  size_t write_shared(const Marshal &m);
+
+  // send as much as possible, gathering up to max_iov chunks per writev.
   size_t write_to_fd(int fd);
 
   bookmark *set_bookmark(size_t n);
@@ -539,7 +583,8 @@ inline rrr::Marshal &operator>>(rrr::Marshal &m, std::map<K, V> &v) {
     K key;
     V value;
     m >> key >> value;
-    insert_into_map(v, key, value);
+    // marshalled in order, each goes right at the end.
+    v.emplace_hint(v.end(), std::move(key), std::move(value));
   }
   return m;
 }
@@ -566,7 +611,7 @@ inline rrr::Marshal &operator>>(rrr::Marshal &m, std::unordered_map<K, V> &v) {
     K key;
     V value;
     m >> key >> value;
-    insert_into_map(v, key, value);
+    v.emplace(std::move(key), std::move(value));
   }
   return m;
 }
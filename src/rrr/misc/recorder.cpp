@@ -1,6 +1,9 @@
 /*
  *
- * Here is how it works, there is a queue, a flush thread, and a callback thread.
+ * Here is how it works, there is a queue, a flush thread, and a callback
+ * job. Submitters append to the queue; the flush thread takes the whole
+ * queue as one group, writes and syncs it, and hands it to the callback
+ * job, which runs on a poll thread.
  *
  */
 
@@ -11,6 +14,7 @@
 #include <unistd.h>
 
 #include <chrono>
+#include <algorithm>
 
 #include "base/logging.hpp"
 #include "stat.hpp"
@@ -18,61 +22,92 @@
 
 namespace rrr {
 
-Recorder::Recorder(const char *path) {
+Recorder::Recorder(const char *path, int policy)
+        : path_(path), policy_(policy) {
     Log::debug("disk log into %s", path);
 
-    fd_ = open(path, O_RDWR | O_CREAT, 0644);
-    if (errno == EINVAL) {
-	Log::error("Open record file failed, are"
-		   " yo2u trying to write into a tmpfs?");
+    int flags = O_RDWR | O_CREAT;
+    if (policy_ == FLUSH_DIRECT) {
+        flags |= O_DIRECT | O_DSYNC;
+    }
+    fd_ = open(path, flags, 0644);
+    if (fd_ < 0 && errno == EINVAL && policy_ == FLUSH_DIRECT) {
+	Log::error("Open record file with O_DIRECT failed, are"
+		   " you trying to write into a tmpfs? use fdatasync instead.");
+	policy_ = FLUSH_FDATASYNC;
 	fd_ = open(path, O_RDWR | O_CREAT, 0644);
     }
-    if (fd_ <= 0) {
+    if (fd_ < 0) {
 	Log::error("Open record file failed, errno:"
 		   " %d, %s", errno, strerror(errno));
-	verify(fd_ > 0);
+	verify(fd_ >= 0);
+    }
+
+    // drop a record torn by a crash, new ones go right after the last
+    //   complete one.
+    file_off_ = scan(std::function<void(Marshal&)>());
+    verify(ftruncate(fd_, file_off_) == 0);
+    if (policy_ == FLUSH_DIRECT && file_off_ % block_size > 0) {
+        tail_.resize(file_off_ % block_size);
+        int fd = open(path, O_RDONLY);
+        verify(pread(fd, &tail_[0], tail_.size(),
+                     file_off_ - tail_.size()) == (ssize_t) tail_.size());
+        close(fd);
     }
 
     flush_reqs_ = new std::list<io_req_t*>();
     callback_reqs_ = new std::list<io_req_t*>();
 
-
     th_flush_ = new std::thread(&Recorder::flush_loop, this);
-
-    timer_.start();
-
-//    th_flush_ = new std::thread([this] () {
-//	    this->flush_loop();
-//	});
-    //    th_pool_ = new base::ThreadPool(1);
 }
 
-void Recorder::flush_loop() {
-    while (true) {
-        mtx_cd_flush_.lock();
-
-//        auto now = std::chrono::system_clock::now();
-        cd_flush_.wait(mtx_cd_flush_);
-        flush_buf();
-        mtx_cd_flush_.unlock();
+off_t Recorder::scan(const std::function<void(Marshal&)> &f) {
+    // O_DIRECT reads need aligned buffers, read through another fd.
+    int fd = open(path_.c_str(), O_RDONLY);
+    verify(fd >= 0);
+    std::string buf;
+    char chunk[64 * 1024];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+        buf.append(chunk, n);
     }
+    verify(n == 0);
+    close(fd);
+
+    size_t off = 0;
+    while (off + sizeof(uint32_t) <= buf.size()) {
+        uint32_t len;
+        memcpy(&len, buf.data() + off, sizeof(len));
+        // zeros are the padding of the last O_DIRECT block.
+        if (len == 0 || off + sizeof(len) + len > buf.size()) {
+            break;
+        }
+        if (f) {
+            Marshal m;
+            m.write(buf.data() + off + sizeof(len), len);
+            f(m);
+        }
+        off += sizeof(len) + len;
+    }
+    return off;
 }
 
-//void Recorder::submit(const std::string &buf) {
-//    std::function<void(void)> empty_func;
-//    submit(buf, empty_func);
-//}
+size_t Recorder::replay(const std::function<void(Marshal&)> &f) {
+    size_t n = 0;
+    scan([&n, &f] (Marshal& m) {
+        n++;
+        f(m);
+    });
+    return n;
+}
 
 void Recorder::submit(const std::string &buf,
 		      const std::function<void(void)> &cb) {
 
     io_req_t *req = new io_req_t(buf, cb);
-    ScopedLock(this->mtx_);
+    ScopedLock sl(mtx_);
     flush_reqs_->push_back(req);
-
-//    if (cb) {
-//        cd_flush_.notify_one();
-//    }
+    cd_flush_.signal();
 }
 
 void Recorder::submit(Marshal &m,
@@ -82,53 +117,98 @@ void Recorder::submit(Marshal &m,
     req->second = cb;
 
     s.resize(m.content_size());
-    m.write((void*)s.data(), m.content_size());
+    m.read((void*)s.data(), m.content_size());
 
-    ScopedLock(this->mtx_);
+    ScopedLock sl(mtx_);
     flush_reqs_->push_back(req);
+    cd_flush_.signal();
 }
 
-void Recorder::flush_buf() {
+void Recorder::flush_loop() {
     mtx_.lock();
+    while (!stop_) {
+        if (flush_reqs_->empty()) {
+            cd_flush_.wait(mtx_);
+            continue;
+        }
+        // everything queued so far makes one group.
+        auto reqs = flush_reqs_;
+        flush_reqs_ = new std::list<io_req_t*>;
+        mtx_.unlock();
 
-    int cnt_flush = 0;
-    int sz_flush = 0;
-
-    int sz = flush_reqs_->size();
-    auto reqs = flush_reqs_;
+        flush_buf(*reqs);
 
-    if (sz > 0) {
-	flush_reqs_ = new std::list<io_req_t*>;
+        mtx_.lock();
+        n_callbacks_ += reqs->size();
+        callback_reqs_->splice(callback_reqs_->end(), *reqs);
+        delete reqs;
     }
-
     mtx_.unlock();
+}
 
-    if (sz == 0) {
-	return;
+void Recorder::write_all(const char *buf, size_t n, off_t off) {
+    while (n > 0) {
+        ssize_t ret = pwrite(fd_, buf, n, off);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            Log::error("write to record file failed, errno: %d, %s",
+                       errno, strerror(errno));
+            verify(0);
+        }
+        buf += ret;
+        off += ret;
+        n -= ret;
     }
+}
 
-    for (auto &p: *reqs) {
-	std::string &s = p->first;
-	int ret = write(fd_, s.data(), s.size());
-	verify(ret == s.size());
-        cnt_flush ++;
-        sz_flush += ret;
+void Recorder::flush_buf(std::list<io_req_t*> &reqs) {
+    Timer timer;
+    timer.start();
+
+    std::string buf;
+    if (policy_ == FLUSH_DIRECT) {
+        buf = tail_;
+    }
+    for (auto &p: reqs) {
+        std::string &s = p->first;
+        uint32_t len = s.size();
+        verify(len > 0);
+        buf.append((const char*) &len, sizeof(len));
+        buf.append(s);
     }
+    size_t sz_flush = buf.size() - tail_.size();
+
+    if (policy_ == FLUSH_DIRECT) {
+        // rewrite the partial block we ended with last time, zero padded.
+        off_t off = file_off_ - tail_.size();
+        size_t n = (buf.size() + block_size - 1) / block_size * block_size;
+        if (direct_buf_size_ < n) {
+            free(direct_buf_);
+            direct_buf_size_ = std::max(n, 2 * direct_buf_size_);
+            verify(posix_memalign((void**) &direct_buf_, block_size,
+                                  direct_buf_size_) == 0);
+        }
+        memcpy(direct_buf_, buf.data(), buf.size());
+        memset(direct_buf_ + buf.size(), 0, n - buf.size());
+        write_all(direct_buf_, n, off);
+        file_off_ = off + buf.size();
+        tail_ = buf.substr(buf.size() - file_off_ % block_size);
+    } else {
+        write_all(buf.data(), buf.size(), file_off_);
+        file_off_ += buf.size();
 #ifndef __APPLE__
-    fdatasync(fd_);
+        if (policy_ == FLUSH_FDATASYNC) {
+            fdatasync(fd_);
+        }
 #endif
+    }
 
-    stat_cnt_.sample(cnt_flush);
+    timer.stop();
+    stat_cnt_.sample(reqs.size());
     stat_sz_.sample(sz_flush);
-
-    // push to call back reqs.
-
-    mtx_.lock();
-    callback_reqs_->insert(callback_reqs_->end(),
-                           reqs->begin(), reqs->end());
-    mtx_.unlock();
-    return;
-
+    stat_flush_us_.sample(timer.elapsed() * 1000000);
 }
 
 void Recorder::invoke_cb() {
@@ -137,6 +217,7 @@ void Recorder::invoke_cb() {
     auto reqs = callback_reqs_;
     if (sz > 0) {
         callback_reqs_ = new std::list<io_req_t*>;
+        n_callbacks_ -= sz;
     }
     mtx_.unlock();
 
@@ -155,6 +236,20 @@ void Recorder::invoke_cb() {
 }
 
 Recorder::~Recorder() {
+    mtx_.lock();
+    stop_ = true;
+    cd_flush_.signal();
+    mtx_.unlock();
+    th_flush_->join();
+    delete th_flush_;
+    close(fd_);
+    free(direct_buf_);
+    for (auto reqs : {flush_reqs_, callback_reqs_}) {
+        for (auto p : *reqs) {
+            delete p;
+        }
+        delete reqs;
+    }
 }
 
 } // namespace rrr
@@ -1,81 +1,105 @@
-
 #pragma once
 
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 
 #include "base/misc.hpp"
 #include "base/threading.hpp"
 #include "marshal.hpp"
+#include "stat.hpp"
 
 namespace rrr {
 
+/**
+ * Write-ahead log with group commit. Records submitted while the flush
+ * thread is busy with a write are flushed together in its next write, so
+ * a group is as large as what arrives during one flush: a single record
+ * when idle, hundreds under load.
+ *
+ * Callbacks of durable records are called by Work(), add the recorder to
+ * the PollMgr whose thread should run them.
+ *
+ * On disk every record is its length (4 bytes) followed by the bytes.
+ */
 class Recorder : public FrequentJob {
-private:
-    int fd_;
-    //    string path_ = "deptran_recorder";
-
-    Mutex mtx_;
-    Timer timer_;  
-
-//    io_context_t ctx_;
-//    std::map<uint8_t*, std::function<void(void)>> callbacks_;
-
 public:
-
-    uint64_t batch_time_ = 10 * 1000; // 10ms
+    enum FlushPolicy {
+        FLUSH_NONE = 0,      // write, leave it to the page cache.
+        FLUSH_FDATASYNC = 1, // write, then fdatasync.
+        FLUSH_DIRECT = 2     // O_DIRECT | O_DSYNC write of whole blocks.
+    };
+    static const size_t block_size = 4096;
 
     typedef std::pair<std::string, std::function<void(void)> > io_req_t;
 
+private:
+    int fd_;
+    std::string path_;
+    int policy_;
+    // end of the valid records.
+    off_t file_off_ = 0;
+    // O_DIRECT only: the bytes of the last, partial block, rewritten
+    //   together with the next group.
+    std::string tail_;
+    char *direct_buf_ = nullptr;
+    size_t direct_buf_size_ = 0;
+
+    Mutex mtx_;
     std::list<io_req_t*> *flush_reqs_;
     std::list<io_req_t*> *callback_reqs_;
+    std::atomic<int> n_callbacks_{0};
 
-    Mutex mtx_cd_flush_;
     CondVar cd_flush_;
+    bool stop_ = false;
     std::thread *th_flush_;
 
+    off_t scan(const std::function<void(Marshal&)> &f);
+    void write_all(const char *buf, size_t n, off_t off);
+
+public:
+
     AvgStat stat_cnt_;
     AvgStat stat_sz_;
+    AvgStat stat_flush_us_;
 
-    Recorder(const char *path);
+    Recorder(const char *path, int policy = FLUSH_FDATASYNC);
     Recorder(const Recorder&) = delete;
     Recorder& operator=(const Recorder&) = delete;
-    //    void submit(const std::string &buf);
 
-    void submit(const std::string &buf, 
+    /**
+     * Call f on every record in the log, oldest first. A record torn by a
+     * crash ends the log, it was never acknowledged.
+     * @return number of records.
+     */
+    size_t replay(const std::function<void(Marshal&)> &f);
+
+    void submit(const std::string &buf,
 		const std::function<void(void)> &cb = std::function<void(void)>());
 
     void submit(Marshal &m,
                 const std::function<void(void)> &cb = std::function<void(void)>());
 
-    void flush_buf();
-
-    void callback(std::vector<std::pair<std::string, 
-		  std::function<void(void)> > > *reqs);
+    // write one group, called by the flush thread.
+    void flush_buf(std::list<io_req_t*> &reqs);
 
     void invoke_cb();
 
     void flush_loop();
 
-    void run() {
-        // callback for successful flushed requests. 
-        invoke_cb();
-
-        if (timer_.elapsed() * 1000000 > batch_time_) {
-        //if (true) {
-            // trigger the flush thread to do the dirty work.
-            cd_flush_.signal();
-            timer_.start();
+    void Work() override {
+        // callback for successful flushed requests.
+        if (n_callbacks_.load(std::memory_order_acquire) > 0) {
+            invoke_cb();
         }
     }
 
-    void set_batch(uint64_t time) {
-        batch_time_ = time; 
+    int policy() {
+        return policy_;
     }
-    
+
     ~Recorder();
 };
 
 } // namespace rrr
-
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
 namespace rrr {
 
 class AvgStat {
@@ -43,4 +47,107 @@ public:
     }
 };
 
+/**
+ * Log-linear histogram of non-negative integers, the layout of
+ * HdrHistogram. Values below 2^sub_bits get a bucket each, above that
+ * every power of two is cut into 2^(sub_bits - 1) buckets, so a bucket is
+ * at most 1/64 of the values it holds wide. The size is fixed whatever
+ * is recorded, and histograms merge by adding their counts.
+ *
+ * Recording and draining are lock-free and may run on different threads.
+ */
+class Histogram {
+public:
+    static const int sub_bits = 7;
+    // larger values are counted in the last bucket.
+    static const int max_bits = 36;
+    static const int n_buckets =
+        (1 << sub_bits) + (max_bits - sub_bits) * (1 << (sub_bits - 1));
+
+private:
+    std::atomic<int64_t> counts_[n_buckets];
+    std::atomic<int64_t> max_;
+
+public:
+    Histogram(): max_(0) {
+        for (auto& c : counts_) {
+            c.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static int bucket(int64_t v) {
+        if (v < (1 << sub_bits)) {
+            return v < 0 ? 0 : (int) v;
+        }
+        int e = 63 - __builtin_clzll(v);
+        if (e >= max_bits) {
+            return n_buckets - 1;
+        }
+        int shift = e - sub_bits + 1;
+        return (1 << sub_bits) + (shift - 1) * (1 << (sub_bits - 1))
+            + (int) (v >> shift) - (1 << (sub_bits - 1));
+    }
+
+    // the middle of the values in bucket i.
+    static int64_t value(int i) {
+        if (i < (1 << sub_bits)) {
+            return i;
+        }
+        int j = i - (1 << sub_bits);
+        int shift = j / (1 << (sub_bits - 1)) + 1;
+        int64_t lowest = ((int64_t) ((1 << (sub_bits - 1))
+                                     + j % (1 << (sub_bits - 1)))) << shift;
+        return lowest + ((((int64_t) 1) << shift) - 1) / 2;
+    }
+
+    /**
+     * The value below which fraction p of the counts are, from counts
+     * laid out as the buckets. Never above max.
+     */
+    static int64_t percentile(const std::vector<int64_t>& counts,
+                              int64_t max, double p) {
+        int64_t n = 0;
+        for (auto c : counts) {
+            n += c;
+        }
+        if (n == 0) {
+            return 0;
+        }
+        int64_t rank = (int64_t) (p * n + 0.999999);
+        rank = rank < 1 ? 1 : rank;
+        int64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                int64_t v = value(i);
+                return v < max ? v : max;
+            }
+        }
+        return max;
+    }
+
+    void record(int64_t v) {
+        counts_[bucket(v)].fetch_add(1, std::memory_order_relaxed);
+        int64_t m = max_.load(std::memory_order_relaxed);
+        while (v > m && !max_.compare_exchange_weak(
+                           m, v, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * Move everything recorded so far into counts, which has n_buckets
+     * entries, and start over.
+     * @return the largest value recorded.
+     */
+    int64_t drain(int64_t* counts) {
+        for (int i = 0; i < n_buckets; i++) {
+            // most buckets stay empty, do not write their cache lines.
+            if (counts_[i].load(std::memory_order_relaxed) != 0) {
+                counts[i] += counts_[i].exchange(0, std::memory_order_relaxed);
+            }
+        }
+        return max_.exchange(0, std::memory_order_relaxed);
+    }
+};
+
 } // namespace rrr
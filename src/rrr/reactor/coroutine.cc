@@ -2,17 +2,115 @@
 
 #include <functional>
 #include <iostream>
+#include <sys/mman.h>
 #include "../base/all.hpp"
 #include "coroutine.h"
 #include "reactor.h"
 
 namespace rrr {
 
+namespace {
+
+struct StackPool {
+  std::vector<boost::context::stack_context> stacks_{};
+  ~StackPool() {
+    for (auto& sctx : stacks_) {
+      ::munmap(static_cast<char*>(sctx.sp) - sctx.size, sctx.size);
+    }
+  }
+};
+
+StackPool& ThreadStackPool() {
+  static thread_local StackPool pool;
+  return pool;
+}
+
+std::vector<std::unique_ptr<CoroutineWorker>>& ThreadWorkerPool() {
+  // idle workers return their stacks when destroyed at thread exit, so the
+  // stack pool has to be constructed first to be destroyed after them.
+  ThreadStackPool();
+  static thread_local std::vector<std::unique_ptr<CoroutineWorker>> pool;
+  return pool;
+}
+
+} // namespace
+
+boost::context::stack_context PooledProtectedStack::allocate() {
+  const std::size_t page_size = boost::context::stack_traits::page_size();
+  const std::size_t pages = (size_ + page_size - 1) / page_size;
+  // one more page at the bottom as guard page.
+  const std::size_t size = (pages + 1) * page_size;
+  auto& stacks = ThreadStackPool().stacks_;
+  if (!stacks.empty() && stacks.back().size == size) {
+    auto sctx = stacks.back();
+    stacks.pop_back();
+    return sctx;
+  }
+  void* vp = ::mmap(0, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANON, -1, 0);
+  if (vp == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  verify(::mprotect(vp, page_size, PROT_NONE) == 0);
+  boost::context::stack_context sctx;
+  sctx.size = size;
+  sctx.sp = static_cast<char*>(vp) + sctx.size;
+  return sctx;
+}
+
+void PooledProtectedStack::deallocate(boost::context::stack_context& sctx) {
+  verify(sctx.sp);
+  auto& stacks = ThreadStackPool().stacks_;
+  if (stacks.size() < MAX_POOLED) {
+    stacks.push_back(sctx);
+  } else {
+    ::munmap(static_cast<char*>(sctx.sp) - sctx.size, sctx.size);
+  }
+}
+
+CoroutineWorker::CoroutineWorker()
+    : boost_coro_task_(PooledProtectedStack(),
+                       std::bind(&CoroutineWorker::Loop,
+                                 this,
+                                 std::placeholders::_1)) {
+#ifdef USE_BOOST_COROUTINE1
+  boost_coro_task_();
+#endif
+}
+
+void CoroutineWorker::Loop(boost_coro_yield_t& yield) {
+  while (true) {
+    // idle until a coroutine is handed over.
+    yield();
+    verify(p_coro_);
+    p_coro_->BoostRunWrapper(yield);
+    p_coro_ = nullptr;
+  }
+}
+
+std::unique_ptr<CoroutineWorker> CoroutineWorker::Get() {
+  auto& pool = ThreadWorkerPool();
+  if (pool.empty()) {
+    return std::unique_ptr<CoroutineWorker>(new CoroutineWorker());
+  }
+  auto up_worker = std::move(pool.back());
+  pool.pop_back();
+  return up_worker;
+}
+
+void CoroutineWorker::Put(std::unique_ptr<CoroutineWorker> up_worker) {
+  verify(up_worker->p_coro_ == nullptr);
+  auto& pool = ThreadWorkerPool();
+  if (pool.size() < MAX_POOLED) {
+    pool.push_back(std::move(up_worker));
+  }
+}
+
 Coroutine::Coroutine(std::function<void()> func) : func_(std::move(func)), status_(INIT) {
 }
 
 Coroutine::~Coroutine() {
-  verify(up_boost_coro_task_ != nullptr);
+  verify(!is_linked());
 //  verify(0);
 }
 
@@ -26,21 +124,23 @@ void Coroutine::BoostRunWrapper(boost_coro_yield_t& yield) {
   func_();
   func_ = {};
   boost_coro_yield_.reset();
+  status_ = FINISHED;
 }
 
 void Coroutine::Run() {
-  verify(!up_boost_coro_task_);
+  verify(!up_worker_);
   verify(status_ == INIT);
   status_ = STARTED;
   auto reactor = Reactor::GetReactor();
 //  reactor->coros_;
   auto sz = reactor->coros_.size();
   verify(sz > 0);
-  up_boost_coro_task_ = make_unique<boost_coro_task_t>(
-      std::bind(&Coroutine::BoostRunWrapper, this, std::placeholders::_1));
-#ifdef USE_BOOST_COROUTINE1
-  (*up_boost_coro_task_)();
-#endif
+  up_worker_ = CoroutineWorker::Get();
+  up_worker_->p_coro_ = this;
+  up_worker_->boost_coro_task_();
+  if (Finished()) {
+    CoroutineWorker::Put(std::move(up_worker_));
+  }
 }
 
 void Coroutine::Yield() {
@@ -52,9 +152,12 @@ void Coroutine::Yield() {
 
 void Coroutine::Continue() {
   verify(status_ == PAUSED);
-  verify(up_boost_coro_task_);
+  verify(up_worker_);
   status_ = RESUMED;
-  (*up_boost_coro_task_)();
+  up_worker_->boost_coro_task_();
+  if (Finished()) {
+    CoroutineWorker::Put(std::move(up_worker_));
+  }
   // some events might have been triggered from last coroutine,
   // but you have to manually call the scheduler to loop.
 }
@@ -14,6 +14,10 @@
 #endif
 
 #include <boost/optional.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/context/stack_context.hpp>
+#include <boost/context/stack_traits.hpp>
+#include <vector>
 
 //#include <experimental/coroutine>
 
@@ -31,8 +35,127 @@ typedef boost::coroutines2::coroutine<void()> coro_t;
     typedef boost::coroutines::symmetric_coroutine<void()> coro_t;
 #endif
 
+/**
+ * Coroutine stacks with a guard page at the bottom, the same layout as
+ * boost::context::protected_fixedsize_stack. Freed stacks go back to a
+ * per-thread free list instead of being unmapped, so mmap and mprotect
+ * only happen when the pool grows.
+ */
+class PooledProtectedStack {
+ public:
+  // stacks kept per thread, beyond this they are unmapped.
+  static const size_t MAX_POOLED = 1024;
+
+  std::size_t size_;
+
+  PooledProtectedStack(
+      std::size_t size = boost::context::stack_traits::default_size())
+      : size_(size) {
+  }
+
+  boost::context::stack_context allocate();
+  void deallocate(boost::context::stack_context& sctx);
+};
+
+/**
+ * Allocator for std::allocate_shared that recycles single objects (and
+ * the shared_ptr control block they come with) through a per-thread free
+ * list. Used for Coroutine, which is created for every incoming RPC.
+ */
+template <typename T>
+class PooledAllocator {
+ public:
+  typedef T value_type;
+  static const size_t MAX_POOLED = 1024;
+
+  template <typename U>
+  struct rebind {
+    typedef PooledAllocator<U> other;
+  };
+
+  PooledAllocator() = default;
+  template <typename U>
+  PooledAllocator(const PooledAllocator<U>&) {}
+
+  T* allocate(std::size_t n) {
+    if (FreeListGone()) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    auto& blocks = FreeList().blocks_;
+    if (n == 1 && !blocks.empty()) {
+      auto p = blocks.back();
+      blocks.pop_back();
+      return static_cast<T*>(p);
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    if (FreeListGone()) {
+      ::operator delete(p);
+      return;
+    }
+    auto& blocks = FreeList().blocks_;
+    if (n == 1 && blocks.size() < MAX_POOLED) {
+      blocks.push_back(p);
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+  bool operator==(const PooledAllocator&) const { return true; }
+  bool operator!=(const PooledAllocator&) const { return false; }
+
+ private:
+  struct Blocks {
+    std::vector<void*> blocks_{};
+    ~Blocks() {
+      for (auto p : blocks_) {
+        ::operator delete(p);
+      }
+      FreeListGone() = true;
+    }
+  };
+
+  // thread locals created before the free list, e.g. the reactor and the
+  //   events that still refer to coroutines, are destroyed after it.
+  static bool& FreeListGone() {
+    static thread_local bool gone = false;
+    return gone;
+  }
+
+  static Blocks& FreeList() {
+    static thread_local Blocks blocks;
+    return blocks;
+  }
+};
+
+class Coroutine;
+/**
+ * A boost coroutine with its own stack that runs one rrr::Coroutine after
+ * another. Idle workers wait in a per-thread pool, so starting a coroutine
+ * neither creates a boost coroutine nor allocates a stack, and finishing
+ * one does not unwind it.
+ */
+class CoroutineWorker {
+ public:
+  // idle workers kept per thread, beyond this they are destroyed.
+  static const size_t MAX_POOLED = 1024;
+
+  Coroutine* p_coro_{nullptr};
+  // declared last, it starts running Loop as soon as it is constructed.
+  boost_coro_task_t boost_coro_task_;
+
+  CoroutineWorker();
+  void Loop(boost_coro_yield_t& yield);
+
+  static std::unique_ptr<CoroutineWorker> Get();
+  static void Put(std::unique_ptr<CoroutineWorker> up_worker);
+};
+
 class Reactor;
-class Coroutine {
+// linked into the reactor's list of live coroutines.
+class Coroutine : public boost::intrusive::list_base_hook<> {
  public:
   static std::shared_ptr<Coroutine> CurrentCoroutine();
   // the argument cannot be a reference because it could be declared on stack.
@@ -43,8 +166,11 @@ class Coroutine {
   Status status_ = INIT; //
   std::function<void()> func_{};
 
-  std::unique_ptr<boost_coro_task_t> up_boost_coro_task_{};
+  // handed back to the pool as soon as the coroutine finishes.
+  std::unique_ptr<CoroutineWorker> up_worker_{};
   boost::optional<boost_coro_yield_t&> boost_coro_yield_{};
+  // the reactor's reference, held while the coroutine is linked.
+  std::shared_ptr<Coroutine> sp_self_{};
 
   Coroutine() = delete;
   Coroutine(std::function<void()> func);
@@ -170,13 +170,14 @@ class Epoll {
     return 0;
   }
 
-  void Wait() {
+  // @param timeout_ms how long to block when there is no event.
+  void Wait(int timeout_ms = 1) {
     const int max_nev = 100;
 #ifdef USE_KQUEUE
     struct kevent evlist[max_nev];
     struct timespec timeout;
-    timeout.tv_sec = 0;
-    timeout.tv_nsec = 50 * 1000 * 1000; // 0.05 sec
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000 * 1000;
 
     int nev = kevent(poll_fd_, nullptr, 0, evlist, max_nev, &timeout);
 
@@ -199,8 +200,7 @@ class Epoll {
 
 #else
     struct epoll_event evlist[max_nev];
-    int timeout = 1; // milli, 0.001 sec
-    int nev = epoll_wait(poll_fd_, evlist, max_nev, timeout);
+    int nev = epoll_wait(poll_fd_, evlist, max_nev, timeout_ms);
     for (int i = 0; i < nev; i++) {
       Pollable* poll = (Pollable *) evlist[i].data.ptr;
       verify(poll != nullptr);
@@ -3,12 +3,14 @@
 #include "event.h"
 #include "reactor.h"
 #include "epoll_wrapper.h"
+#include "timer_wheel.h"
 
 namespace rrr {
 
 void Event::Wait() {
   if (IsReady()) {
     status_ = DONE; // does not need to wait.
+    Reactor::GetReactor()->RetireEvent(*this);
     return;
   } else {
     verify(status_ == INIT);
@@ -26,47 +28,85 @@ void Event::Wait() {
   }
 }
 
-bool Event::Test() {
+bool Event::Wait(uint64_t timeout) {
   if (IsReady()) {
-    if (status_ == INIT) {
-      // wait has not been called, do nothing until wait happens.
-      status_ = DONE;
-    } else if (status_ == WAIT) {
-      auto sp_coro = wp_coro_.lock();
-      verify(sp_coro);
-      verify(status_ != DEBUG);
-//      auto sched = Reactor::GetReactor();
-//      verify(sched.get() == _dbg_p_scheduler_);
-//      verify(sched->__debug_set_all_coro_.count(sp_coro.get()) > 0);
-//      verify(sched->coros_.count(sp_coro) > 0);
-      status_ = READY;
-    } else {
-      // TODO could be a multi condition event?
-      Log_debug("event status not init or wait");
-      verify(0);
+    Wait();
+    return true;
+  }
+  auto reactor = Reactor::GetReactor();
+  auto sp_timer = reactor->AddTimer(timeout, [this] () {
+    if (status_ == WAIT) {
+      status_ = TIMEOUT;
+      Reactor::GetReactor()->ReadyEvent(*this);
     }
+  });
+  Wait();
+  sp_timer->Cancel();
+  return status_ != TIMEOUT;
+}
+
+bool Event::Test() {
+  if (IsReady()) {
+    Trigger();
     return true;
   }
   return false;
 }
 
+void Event::Trigger() {
+  if (status_ == TIMEOUT) {
+    // too late, the waiting coroutine has given up.
+    return;
+  } else if (status_ == INIT) {
+    // wait has not been called, do nothing until wait happens.
+    status_ = DONE;
+    Reactor::GetReactor()->RetireEvent(*this);
+  } else if (status_ == WAIT) {
+    status_ = READY;
+    Reactor::GetReactor()->ReadyEvent(*this);
+  } else {
+    // TODO could be a multi condition event?
+    Log_debug("event status not init or wait");
+    verify(0);
+  }
+}
+
 Event::Event() {
   auto coro = Coroutine::CurrentCoroutine();
 //  verify(coro);
   wp_coro_ = coro;
 }
 
+TimeoutEvent::TimeoutEvent(uint64_t wait_us)
+    : Event(), wakeup_time_(Time::now() + wait_us) {
+}
+
+void TimeoutEvent::Wait() {
+  std::shared_ptr<TimerEntry> sp_timer;
+  auto now = Time::now();
+  if (now < wakeup_time_) {
+    sp_timer = Reactor::GetReactor()->AddTimer(wakeup_time_ - now, [this] () {
+      expired_ = true;
+      Test();
+    });
+  }
+  Event::Wait();
+  if (sp_timer) {
+    sp_timer->Cancel();
+  }
+}
+
+bool TimeoutEvent::IsReady() {
+  return expired_ || Time::now() >= wakeup_time_;
+}
+
 bool IntEvent::TestTrigger() {
+  if (status_ == TIMEOUT) {
+    return false;
+  }
   verify(status_ <= WAIT);
   if (value_ == target_) {
-    if (status_ == INIT) {
-      // do nothing until wait happens.
-      status_ = DONE;
-    } else if (status_ == WAIT) {
-      status_ = READY;
-    } else {
-      verify(0);
-    }
+    Trigger();
     return true;
   }
   return false;
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <memory>
+#include <list>
 #include "../base/all.hpp"
 
 namespace rrr {
@@ -11,7 +12,8 @@ class Reactor;
 class Coroutine;
 class Event {
  public:
-  enum EventStatus { INIT = 0, WAIT = 1, READY = 2, DONE = 3, DEBUG};
+  enum EventStatus { INIT = 0, WAIT = 1, READY = 2, DONE = 3, TIMEOUT = 4,
+                     DEBUG};
   EventStatus status_{INIT};
   void* _dbg_p_scheduler_{nullptr};
   uint64_t type_{0};
@@ -22,13 +24,43 @@ class Event {
   // When the stack that contains the event frees, the event frees.
   std::weak_ptr<Coroutine> wp_coro_{};
 
+  // Set when the event is owned by the reactor (see Reactor::CreateSpEvent),
+  //   so that the reactor can drop its reference in O(1) once it fires.
+  bool owned_by_reactor_{false};
+  std::list<shared_ptr<Event>>::iterator it_owner_{};
+
   virtual void Wait();
+  /**
+   * Wait for at most timeout microseconds.
+   * @return false if the wait timed out. A timed out event ignores later
+   * triggers, so whoever triggers it must keep it alive, e.g. through
+   * Reactor::CreateSpEvent.
+   */
+  bool Wait(uint64_t timeout);
   virtual bool Test();
   virtual bool IsReady() { return false; }
 
   friend Reactor;
  protected:
   Event();
+  // move the event out of INIT/WAIT once it is ready; a waiting coroutine
+  //   is put on the reactor's ready queue.
+  void Trigger();
+};
+
+/**
+ * Becomes ready after a given number of microseconds, driven by the
+ * reactor's timer wheel instead of a sleeping thread.
+ */
+class TimeoutEvent : public Event {
+ public:
+  uint64_t wakeup_time_{0};
+  bool expired_{false};
+
+  TimeoutEvent(uint64_t wait_us);
+  using Event::Wait;
+  void Wait() override;
+  bool IsReady() override;
 };
 
 class IntEvent : public Event {
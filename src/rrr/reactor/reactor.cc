@@ -25,9 +25,8 @@ std::shared_ptr<Coroutine> Coroutine::CurrentCoroutine() {
 std::shared_ptr<Coroutine>
 Coroutine::CreateRun(std::function<void()> func) {
   auto& reactor = *Reactor::GetReactor();
-  auto coro = reactor.CreateRunCoroutine(func);
+  auto coro = reactor.CreateRunCoroutine(std::move(func));
   // some events might be triggered in the last coroutine.
-  verify(reactor.coros_.size() > 0);
   reactor.Loop();
   return coro;
 }
@@ -46,20 +45,19 @@ Reactor::GetReactor() {
  * @return
  */
 std::shared_ptr<Coroutine>
-Reactor::CreateRunCoroutine(const std::function<void()> func) {
-  std::shared_ptr<Coroutine> sp_coro = std::make_shared<Coroutine>(func);
+Reactor::CreateRunCoroutine(std::function<void()> func) {
+  std::shared_ptr<Coroutine> sp_coro = std::allocate_shared<Coroutine>(
+      PooledAllocator<Coroutine>(), std::move(func));
 //  __debug_set_all_coro_.insert(sp_coro.get());
 //  verify(!curr_coro_); // Create a coroutine from another?
 //  verify(!sp_running_coro_th_); // disallows nested coroutines
   auto sp_old_coro = sp_running_coro_th_;
   sp_running_coro_th_ = sp_coro;
   verify(sp_coro);
-  auto pair = coros_.insert(sp_coro);
-  verify(pair.second);
-  verify(coros_.size() > 0);
+  LinkCoro(sp_coro);
   sp_coro->Run();
   if (sp_coro->Finished()) {
-    coros_.erase(sp_coro);
+    UnlinkCoro(*sp_coro);
   }
   // yielded or finished, reset to old coro.
   sp_running_coro_th_ = sp_old_coro;
@@ -69,28 +67,72 @@ Reactor::CreateRunCoroutine(const std::function<void()> func) {
 //  be careful this could be called from different coroutines.
 void Reactor::Loop(bool infinite) {
   do {
-    std::vector<shared_ptr<Event>> ready_events;
-    for (auto it = events_.begin(); it != events_.end();) {
-      Event& event = **it;
-      if (event.status_ == Event::READY) {
-        ready_events.push_back(std::move(*it));
-        it = events_.erase(it);
-      } else if (event.status_ == Event::DONE) {
-        it = events_.erase(it);
-      } else {
-        it ++;
+    // keep fired events alive until their coroutines have been resumed.
+    std::list<shared_ptr<Event>> fired_events;
+    fired_events.swap(fired_events_);
+    if (has_posted_.load(std::memory_order_acquire)) {
+      std::vector<std::function<void()>> posted;
+      posted_l_.lock();
+      posted.swap(posted_);
+      has_posted_.store(false, std::memory_order_relaxed);
+      posted_l_.unlock();
+      for (auto& func : posted) {
+        func();
       }
     }
-    for (auto& up_ev: ready_events) {
-      auto& event = *up_ev;
-      auto sp_coro = event.wp_coro_.lock();
-      verify(sp_coro);
-      verify(coros_.find(sp_coro) != coros_.end());
+    if (timers_.size() > 0) {
+      timers_.Advance(Time::now());
+    }
+    while (!ready_coros_.empty()) {
+      auto sp_coro = std::move(ready_coros_.front());
+      ready_coros_.pop_front();
+      verify(sp_coro->is_linked());
       ContinueCoro(sp_coro);
     }
   } while (infinite);
 }
 
+std::shared_ptr<TimerEntry>
+Reactor::AddTimer(uint64_t timeout, std::function<void()> func) {
+  auto now = Time::now();
+  return timers_.Add(now, now + timeout, std::move(func));
+}
+
+int Reactor::NextTimeoutMs(int max_ms) {
+  if (timers_.size() == 0) {
+    return max_ms;
+  }
+  auto timeout = timers_.NextTimeout(Time::now());
+  if (timeout < 0) {
+    return max_ms;
+  }
+  // round up, waking up early would only spin.
+  auto ms = (timeout + 999) / 1000;
+  return ms < max_ms ? (int) ms : max_ms;
+}
+
+void Reactor::ReadyEvent(Event& ev) {
+  verify(ev.status_ == Event::READY || ev.status_ == Event::TIMEOUT);
+  auto sp_coro = ev.wp_coro_.lock();
+  verify(sp_coro);
+  ready_coros_.push_back(std::move(sp_coro));
+  RetireEvent(ev);
+}
+
+void Reactor::RetireEvent(Event& ev) {
+  if (ev.owned_by_reactor_) {
+    ev.owned_by_reactor_ = false;
+    fired_events_.splice(fired_events_.end(), events_, ev.it_owner_);
+  }
+}
+
+void Reactor::Post(std::function<void()> func) {
+  posted_l_.lock();
+  posted_.push_back(std::move(func));
+  has_posted_.store(true, std::memory_order_release);
+  posted_l_.unlock();
+}
+
 void Reactor::ContinueCoro(std::shared_ptr<Coroutine> sp_coro) {
 //  verify(!sp_running_coro_th_); // disallow nested coros
   auto sp_old_coro = sp_running_coro_th_;
@@ -98,11 +140,24 @@ void Reactor::ContinueCoro(std::shared_ptr<Coroutine> sp_coro) {
   verify(!sp_running_coro_th_->Finished());
   sp_running_coro_th_->Continue();
   if (sp_running_coro_th_->Finished()) {
-    coros_.erase(sp_running_coro_th_);
+    UnlinkCoro(*sp_running_coro_th_);
   }
   sp_running_coro_th_ = sp_old_coro;
 }
 
+void Reactor::LinkCoro(std::shared_ptr<Coroutine> sp_coro) {
+  verify(!sp_coro->is_linked());
+  coros_.push_back(*sp_coro);
+  sp_coro->sp_self_ = std::move(sp_coro);
+}
+
+void Reactor::UnlinkCoro(Coroutine& coro) {
+  verify(coro.is_linked());
+  coros_.erase(coros_.iterator_to(coro));
+  // may free the coroutine, do it last.
+  auto sp_coro = std::move(coro.sp_self_);
+}
+
 // TODO PollThread -> Reactor
 // TODO PollMgr -> ReactorFactory
 class PollMgr::PollThread {
@@ -116,14 +171,25 @@ class PollMgr::PollThread {
   std::unordered_map<int, int> mode_; // fd->mode
   std::unordered_set<Pollable*> poll_set_;
 
-  std::set<std::shared_ptr<Job>> set_sp_jobs_;
+  // jobs submitted from any thread, as lock-free stacks drained by the
+  // poll thread. Jobs in job_inbox_ may still be stolen by a sibling.
+  struct JobNode {
+    std::shared_ptr<Job> sp_job_;
+    JobNode* next_;
+  };
+  std::atomic<JobNode*> job_inbox_{nullptr};
+  std::atomic<JobNode*> pinned_job_inbox_{nullptr};
+  std::atomic<int> n_queued_jobs_{0};
+  // only touched by the poll thread itself.
+  std::list<std::shared_ptr<Job>> jobs_;
 
   std::unordered_set<Pollable*> pending_remove_;
   SpinLock pending_remove_l_;
-  SpinLock lock_job_;
 
+  PollMgr* poll_mgr_{nullptr};
   pthread_t th_;
   bool stop_flag_;
+  bool joined_{false};
 
   static void* start_poll_loop(void* arg) {
     PollThread* thiz = (PollThread*) arg;
@@ -135,24 +201,82 @@ class PollMgr::PollThread {
   void poll_loop();
 
   void start(PollMgr* poll_mgr) {
+    poll_mgr_ = poll_mgr;
     Pthread_create(&th_, nullptr, PollMgr::PollThread::start_poll_loop, this);
   }
 
+  void join() {
+    if (!joined_) {
+      stop_flag_ = true;
+      Pthread_join(th_, nullptr);
+      joined_ = true;
+    }
+  }
+
+  static void PushJob(std::atomic<JobNode*>& inbox,
+                      std::shared_ptr<Job> sp_job) {
+    auto node = new JobNode{std::move(sp_job), nullptr};
+    node->next_ = inbox.load(std::memory_order_relaxed);
+    while (!inbox.compare_exchange_weak(node->next_,
+                                        node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  // move every job of an inbox to jobs_, in submission order.
+  int TakeJobs(std::atomic<JobNode*>& inbox) {
+    auto node = inbox.exchange(nullptr, std::memory_order_acquire);
+    auto pos = jobs_.end();
+    int n = 0;
+    while (node != nullptr) {
+      pos = jobs_.insert(pos, std::move(node->sp_job_));
+      auto next = node->next_;
+      delete node;
+      node = next;
+      n++;
+    }
+    return n;
+  }
+
+  void StealJobs() {
+    PollThread* victim = nullptr;
+    int max_queued = JOB_STEAL_THRESHOLD;
+    for (int i = 0; i < poll_mgr_->n_threads_; i++) {
+      auto& sibling = poll_mgr_->poll_threads_[i];
+      auto n_queued = sibling.n_queued_jobs_.load(std::memory_order_relaxed);
+      if (&sibling != this && n_queued > max_queued) {
+        victim = &sibling;
+        max_queued = n_queued;
+      }
+    }
+    if (victim != nullptr) {
+      int n = TakeJobs(victim->job_inbox_);
+      victim->n_queued_jobs_ -= n;
+      Log_debug("poll thread stole %d queued jobs", n);
+    }
+  }
+
   void TriggerJob() {
-    lock_job_.lock();
-    auto it = set_sp_jobs_.begin();
-    while (it != set_sp_jobs_.end()) {
+    TakeJobs(pinned_job_inbox_);
+    n_queued_jobs_ -= TakeJobs(job_inbox_);
+    StealJobs();
+    auto it = jobs_.begin();
+    while (it != jobs_.end()) {
       auto sp_job = *it;
+      if (sp_job->removed_) {
+        it = jobs_.erase(it);
+        continue;
+      }
       if (sp_job->Ready()) {
         Coroutine::CreateRun([sp_job]() {sp_job->Work();});
       }
       if (sp_job->Done()) {
-        it = set_sp_jobs_.erase(it);
+        it = jobs_.erase(it);
       } else {
         it++;
       }
     }
-    lock_job_.unlock();
   }
 
  public:
@@ -161,8 +285,7 @@ class PollMgr::PollThread {
   }
 
   ~PollThread() {
-    stop_flag_ = true;
-    Pthread_join(th_, nullptr);
+    join();
 
     // when stopping, release anything registered in pollmgr
     for (auto& it: poll_set_) {
@@ -171,14 +294,15 @@ class PollMgr::PollThread {
     for (auto& it: pending_remove_) {
       it->release();
     }
+    TakeJobs(pinned_job_inbox_);
+    TakeJobs(job_inbox_);
   }
 
   void add(Pollable*);
   void remove(Pollable*);
   void update_mode(Pollable*, int new_mode);
 
-  void add(std::shared_ptr<Job>);
-  void remove(std::shared_ptr<Job>);
+  void add(std::shared_ptr<Job>, bool pinned);
 };
 
 PollMgr::PollMgr(int n_threads /* =... */)
@@ -191,6 +315,13 @@ PollMgr::PollMgr(int n_threads /* =... */)
 }
 
 PollMgr::~PollMgr() {
+  // stop all threads before destroying any, they steal from each other.
+  for (int i = 0; i < n_threads_; i++) {
+    poll_threads_[i].stop_flag_ = true;
+  }
+  for (int i = 0; i < n_threads_; i++) {
+    poll_threads_[i].join();
+  }
   delete[] poll_threads_;
   //Log_debug("rrr::PollMgr: destroyed");
 }
@@ -198,7 +329,9 @@ PollMgr::~PollMgr() {
 void PollMgr::PollThread::poll_loop() {
   while (!stop_flag_) {
     TriggerJob();
-    poll_.Wait();
+    // wake up for the next coroutine timer, but keep polling the frequent
+    // jobs at least every millisecond.
+    poll_.Wait(Reactor::GetReactor()->NextTimeoutMs(1));
     TriggerJob();
     // after each poll loop, remove uninterested pollables
     pending_remove_l_.lock();
@@ -224,16 +357,13 @@ void PollMgr::PollThread::poll_loop() {
   }
 }
 
-void PollMgr::PollThread::add(std::shared_ptr<Job> sp_job) {
-  lock_job_.lock();
-  set_sp_jobs_.insert(sp_job);
-  lock_job_.unlock();
-}
-
-void PollMgr::PollThread::remove(std::shared_ptr<Job> sp_job) {
-  lock_job_.lock();
-  set_sp_jobs_.erase(sp_job);
-  lock_job_.unlock();
+void PollMgr::PollThread::add(std::shared_ptr<Job> sp_job, bool pinned) {
+  if (pinned) {
+    PushJob(pinned_job_inbox_, std::move(sp_job));
+  } else {
+    n_queued_jobs_++;
+    PushJob(job_inbox_, std::move(sp_job));
+  }
 }
 
 void PollMgr::PollThread::add(Pollable* poll) {
@@ -333,14 +463,19 @@ void PollMgr::update_mode(Pollable* poll, int new_mode) {
   }
 }
 
-void PollMgr::add(std::shared_ptr<Job> fjob) {
-  int tid = 0;
-  poll_threads_[tid].add(fjob);
+void PollMgr::add(std::shared_ptr<Job> fjob, int thread_id) {
+  verify(!fjob->removed_);
+  if (thread_id >= 0) {
+    poll_threads_[thread_id % n_threads_].add(fjob, true);
+  } else {
+    int tid = next_job_thread_++ % n_threads_;
+    poll_threads_[tid].add(fjob, false);
+  }
 }
 
 void PollMgr::remove(std::shared_ptr<Job> fjob) {
-  int tid = 0;
-  poll_threads_[tid].remove(fjob);
+  // the job may have moved to another thread, let its holder drop it.
+  fjob->removed_ = true;
 }
 
 } // namespace rrr
@@ -2,10 +2,14 @@
 #include <set>
 #include <unordered_map>
 #include <list>
+#include <deque>
+#include <vector>
+#include <atomic>
 #include "base/misc.hpp"
 #include "event.h"
 #include "coroutine.h"
 #include "epoll_wrapper.h"
+#include "timer_wheel.h"
 
 namespace rrr {
 
@@ -24,9 +28,26 @@ class Reactor {
    * coroutine? Or should an event belong to a coroutine?
    */
   std::list<std::shared_ptr<Event>> events_{};
-  std::set<std::shared_ptr<Coroutine>> coros_{};
+  /**
+   * Events that have fired (READY or DONE). They are released on the next
+   * Loop, after the coroutines waiting on them have been resumed.
+   */
+  std::list<std::shared_ptr<Event>> fired_events_{};
+  /**
+   * Coroutines whose event became READY, in the order they fired. Loop only
+   * drains this queue, so its cost does not depend on how many events are
+   * still waiting.
+   */
+  std::deque<std::shared_ptr<Coroutine>> ready_coros_{};
+  // coroutines not finished yet, each holds itself through sp_self_.
+  boost::intrusive::list<Coroutine> coros_{};
+  TimerWheel timers_{};
 //  std::set<Coroutine*> __debug_set_all_coro_{};
   std::unordered_map<uint64_t, std::function<void(Event&)>> processors_{};
+  // functions handed over by other threads, run by the next Loop.
+  SpinLock posted_l_{};
+  std::vector<std::function<void()>> posted_{};
+  std::atomic<bool> has_posted_{false};
 
   /**
    * @param ev. is usually allocated on coroutine stack. memory managed by user.
@@ -34,17 +55,40 @@ class Reactor {
   std::shared_ptr<Coroutine> CreateRunCoroutine(std::function<void()> func);
   void Loop(bool infinite = false);
   void ContinueCoro(std::shared_ptr<Coroutine> sp_coro);
+  void LinkCoro(std::shared_ptr<Coroutine> sp_coro);
+  void UnlinkCoro(Coroutine& coro);
+  /**
+   * Run func from this reactor's Loop after timeout microseconds.
+   * @return a handle to cancel the timer.
+   */
+  std::shared_ptr<TimerEntry> AddTimer(uint64_t timeout,
+                                       std::function<void()> func);
+  // milliseconds until the next timer is due, at most max_ms.
+  int NextTimeoutMs(int max_ms);
+  // called by an event when it turns READY, schedules the waiting coroutine.
+  void ReadyEvent(Event& ev);
+  // called by an event once it has fired, drops the reactor's ownership.
+  void RetireEvent(Event& ev);
+  /**
+   * Run func from this reactor's Loop. Unlike the rest of the reactor, this
+   * can be called from any thread, e.g. to trigger an event that a
+   * coroutine of this reactor waits on.
+   */
+  void Post(std::function<void()> func);
 
   ~Reactor() {
 //    verify(0);
+    while (!coros_.empty()) {
+      UnlinkCoro(coros_.front());
+    }
   }
 
   template <typename Ev, typename... Args>
   static shared_ptr<Ev> CreateSpEvent(Args&&... args) {
     auto& events = GetReactor()->events_;
     auto p_ev = make_shared<Ev>(args...);
-    // TODO push them into a wait queue when they actually wait.
-    events.push_back(p_ev);
+    p_ev->it_owner_ = events.insert(events.end(), p_ev);
+    p_ev->owned_by_reactor_ = true;
     return p_ev;
   }
 
@@ -60,6 +104,9 @@ class PollMgr: public rrr::RefCounted {
 
     PollThread* poll_threads_;
     const int n_threads_;
+    // a poll thread steals the queued jobs of a sibling that has more than
+    // this many of them waiting.
+    static const int JOB_STEAL_THRESHOLD = 16;
 
 protected:
 
@@ -77,8 +124,16 @@ public:
     void update_mode(Pollable*, int new_mode);
     
     // Frequent Job
-    void add(std::shared_ptr<Job> sp_job);
+    /**
+     * Without a thread id, jobs are spread round-robin over the poll
+     * threads and may be stolen by an idle thread while still queued.
+     * A job given a thread id always runs on that thread.
+     */
+    void add(std::shared_ptr<Job> sp_job, int thread_id = -1);
     void remove(std::shared_ptr<Job> sp_job);
+
+private:
+    std::atomic<uint32_t> next_job_thread_{0};
 };
 
 } // namespace rrr
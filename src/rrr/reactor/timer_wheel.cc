@@ -0,0 +1,119 @@
+#include "timer_wheel.h"
+
+namespace rrr {
+
+TimerWheel::TimerWheel(uint64_t tick_us) : tick_us_(tick_us) {
+  verify(tick_us_ > 0);
+}
+
+std::shared_ptr<TimerEntry> TimerWheel::Add(uint64_t now,
+                                            uint64_t deadline,
+                                            std::function<void()> func) {
+  verify(func);
+  if (n_timers_ == 0) {
+    // nothing to cascade, skip the idle ticks.
+    current_tick_ = now / tick_us_;
+  }
+  auto sp_timer = std::make_shared<TimerEntry>();
+  sp_timer->deadline_ = deadline;
+  // round up so that a timer never fires before its deadline.
+  sp_timer->expire_tick_ = (deadline + tick_us_ - 1) / tick_us_;
+  sp_timer->func_ = std::move(func);
+  Place(sp_timer);
+  n_timers_++;
+  return sp_timer;
+}
+
+void TimerWheel::Place(std::shared_ptr<TimerEntry> sp_timer) {
+  uint64_t expire = sp_timer->expire_tick_;
+  if (expire < current_tick_) {
+    expire = current_tick_;
+  }
+  uint64_t delta = expire - current_tick_;
+  if (delta < ROOT_SIZE) {
+    root_[expire & ROOT_MASK].push_back(std::move(sp_timer));
+    return;
+  }
+  int shift = ROOT_BITS;
+  for (int level = 0; level < N_LEVEL - 1; level++) {
+    if (delta < (1ull << (shift + LEVEL_BITS))) {
+      levels_[level][(expire >> shift) & LEVEL_MASK].push_back(
+          std::move(sp_timer));
+      return;
+    }
+    shift += LEVEL_BITS;
+  }
+  // out of range, park it in the farthest slot of the top wheel; it is
+  // placed again when that slot cascades.
+  shift -= LEVEL_BITS;
+  expire = current_tick_ + (1ull << (shift + LEVEL_BITS)) - 1;
+  levels_[N_LEVEL - 2][(expire >> shift) & LEVEL_MASK].push_back(
+      std::move(sp_timer));
+}
+
+void TimerWheel::Cascade(int level) {
+  int shift = ROOT_BITS + level * LEVEL_BITS;
+  slot_t timers;
+  timers.swap(levels_[level][(current_tick_ >> shift) & LEVEL_MASK]);
+  for (auto& sp_timer : timers) {
+    if (sp_timer->Cancelled()) {
+      n_timers_--;
+    } else {
+      Place(std::move(sp_timer));
+    }
+  }
+}
+
+int TimerWheel::Advance(uint64_t now) {
+  uint64_t target = now / tick_us_;
+  int n_fired = 0;
+  while (current_tick_ <= target) {
+    if (n_timers_ == 0) {
+      current_tick_ = target + 1;
+      break;
+    }
+    auto idx = current_tick_ & ROOT_MASK;
+    if (idx == 0) {
+      // the root wheel wrapped around, pull timers down from the wheels
+      // above, as far up as they wrapped around too.
+      for (int level = 0; level < N_LEVEL - 1; level++) {
+        Cascade(level);
+        int shift = ROOT_BITS + level * LEVEL_BITS;
+        if (((current_tick_ >> shift) & LEVEL_MASK) != 0) {
+          break;
+        }
+      }
+    }
+    slot_t expired;
+    expired.swap(root_[idx]);
+    // timers added by the callbacks below go to later ticks.
+    current_tick_++;
+    for (auto& sp_timer : expired) {
+      n_timers_--;
+      if (sp_timer->Cancelled()) {
+        continue;
+      }
+      auto func = std::move(sp_timer->func_);
+      sp_timer->func_ = {};
+      func();
+      n_fired++;
+    }
+  }
+  return n_fired;
+}
+
+int64_t TimerWheel::NextTimeout(uint64_t now) {
+  if (n_timers_ == 0) {
+    return -1;
+  }
+  uint64_t tick = current_tick_;
+  // a tick at the start of the root wheel may have to cascade, so never
+  // look past it.
+  while ((tick & ROOT_MASK) != 0 && root_[tick & ROOT_MASK].empty()) {
+    tick++;
+  }
+  uint64_t t = tick * tick_us_;
+  return t > now ? t - now : 0;
+}
+
+} // namespace rrr
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <functional>
+#include "../base/all.hpp"
+
+namespace rrr {
+
+/**
+ * A timer registered in a TimerWheel. Cancelled timers are not unlinked
+ * from the wheel, they are dropped when their slot is reached.
+ */
+class TimerEntry {
+ public:
+  uint64_t deadline_{0}; // in microseconds, same clock as rrr::Time::now()
+  uint64_t expire_tick_{0};
+  std::function<void()> func_{};
+
+  bool Cancelled() {
+    return !func_;
+  }
+
+  void Cancel() {
+    func_ = {};
+  }
+};
+
+/**
+ * Hierarchical timing wheel (Varghese & Lauck), in the same layout as the
+ * old Linux kernel timers: one 256-slot wheel of ticks and three 64-slot
+ * wheels above it, which cascade down when the lower wheel wraps around.
+ * Adding and cancelling a timer is O(1); advancing is O(1) per tick plus
+ * the timers that fire or cascade. With the default 1ms tick the wheels
+ * span about 18 hours, later deadlines are parked in the top wheel and
+ * re-cascaded until they are in range.
+ *
+ * Not thread safe, each reactor owns its own wheel.
+ */
+class TimerWheel {
+ public:
+  static const int N_LEVEL = 4;
+  static const int ROOT_BITS = 8;
+  static const int LEVEL_BITS = 6;
+  static const uint64_t ROOT_SIZE = 1 << ROOT_BITS;
+  static const uint64_t LEVEL_SIZE = 1 << LEVEL_BITS;
+  static const uint64_t ROOT_MASK = ROOT_SIZE - 1;
+  static const uint64_t LEVEL_MASK = LEVEL_SIZE - 1;
+
+  typedef std::list<std::shared_ptr<TimerEntry>> slot_t;
+
+  explicit TimerWheel(uint64_t tick_us = 1000);
+
+  /**
+   * @param now current time, in microseconds.
+   * @param deadline time the timer should fire at, in microseconds.
+   * @return a handle that can be used to cancel the timer.
+   */
+  std::shared_ptr<TimerEntry> Add(uint64_t now,
+                                  uint64_t deadline,
+                                  std::function<void()> func);
+
+  /**
+   * Fire every timer whose deadline is not later than now.
+   * @return number of timers fired.
+   */
+  int Advance(uint64_t now);
+
+  /**
+   * @return microseconds until the wheel needs to be advanced again, or -1
+   * if there is no timer. This may be earlier than the next deadline when
+   * a higher wheel has to cascade.
+   */
+  int64_t NextTimeout(uint64_t now);
+
+  // number of timers in the wheel, including cancelled ones not yet dropped.
+  size_t size() {
+    return n_timers_;
+  }
+
+ protected:
+  uint64_t tick_us_;
+  // the next tick to be processed.
+  uint64_t current_tick_{0};
+  size_t n_timers_{0};
+  slot_t root_[ROOT_SIZE]{};
+  slot_t levels_[N_LEVEL - 1][LEVEL_SIZE]{};
+
+  void Place(std::shared_ptr<TimerEntry> sp_timer);
+  // move the timers in the current slot of a higher wheel one level down.
+  void Cascade(int level);
+};
+
+} // namespace rrr
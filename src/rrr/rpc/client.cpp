@@ -1,4 +1,5 @@
 #include <string>
+#include <algorithm>
 #include <memory>
 
 #include <errno.h>
@@ -16,57 +17,176 @@ using namespace std;
 
 namespace rrr {
 
+void Future::reset(i64 xid, const FutureAttr& attr) {
+  refcnt_.store(1, std::memory_order_relaxed);
+  xid_ = xid;
+  error_code_ = 0;
+  attr_ = attr;
+  // drop what the last user left unread.
+  char buf[256];
+  while (!reply_.empty()) {
+    reply_.read(buf, std::min(sizeof(buf), reply_.content_size()));
+  }
+  state_.store(PENDING);
+  coro_waiter_.store(nullptr);
+}
+
+int Future::release() {
+  int r = refcnt_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+  verify(r >= 0);
+  if (r == 0) {
+    pool_->put(this);
+  }
+  return r;
+}
+
+void Future::wake() {
+  CoroWaiter* w = coro_waiter_.exchange(nullptr);
+  if (w != nullptr) {
+    // the waiter stays suspended until its event is set, so w is valid
+    // up to here.
+    auto ev = w->ev;
+    if (w->reactor == Reactor::GetReactor()) {
+      ev->Set(1);
+    } else {
+      w->reactor->Post([ev] () {
+        ev->Set(1);
+      });
+    }
+  }
+  if (pool_->n_thread_waiters_.load() > 0) {
+    ScopedLock sl(pool_->wait_m_);
+    pool_->wait_cv_.bcast();
+  }
+}
+
+void Future::notify_ready() {
+  int expected = PENDING;
+  if (!state_.compare_exchange_strong(expected, READY)) {
+    // timed out already.
+    return;
+  }
+  wake();
+  if (attr_.callback != nullptr) {
+    attr_.callback(this);
+  }
+}
+
+void Future::time_out() {
+  int expected = PENDING;
+  if (state_.compare_exchange_strong(expected, TIMED_OUT)) {
+    error_code_ = ETIMEDOUT;
+    wake();
+  }
+}
+
+void Future::coro_wait(double sec) {
+  auto reactor = Reactor::GetReactor();
+  IntEvent ev;
+  CoroWaiter w{reactor, &ev};
+  CoroWaiter* expected = nullptr;
+  // one coroutine at a time.
+  verify(coro_waiter_.compare_exchange_strong(expected, &w));
+  if (state_.load() != PENDING) {
+    // woken up in the meantime, unless wake() has not taken us yet.
+    expected = &w;
+    if (coro_waiter_.compare_exchange_strong(expected, nullptr)) {
+      return;
+    }
+  }
+  std::shared_ptr<TimerEntry> sp_timer;
+  if (sec >= 0) {
+    sp_timer = reactor->AddTimer(sec * 1000 * 1000, [this] () {
+      time_out();
+    });
+  }
+  ev.Wait();
+  if (sp_timer) {
+    sp_timer->Cancel();
+  }
+}
+
 void Future::wait() {
-  Pthread_mutex_lock(&ready_m_);
-  while (!ready_ && !timed_out_) {
-    Pthread_cond_wait(&ready_cond_, &ready_m_);
+  if (state_.load() != PENDING) {
+    return;
+  }
+  if (Coroutine::CurrentCoroutine()) {
+    coro_wait(-1);
+    return;
+  }
+  pool_->n_thread_waiters_++;
+  pool_->wait_m_.lock();
+  while (state_.load() == PENDING) {
+    pool_->wait_cv_.wait(pool_->wait_m_);
   }
-  Pthread_mutex_unlock(&ready_m_);
+  pool_->wait_m_.unlock();
+  pool_->n_thread_waiters_--;
 }
 
 void Future::timed_wait(double sec) {
-  Pthread_mutex_lock(&ready_m_);
-  while (!ready_ && !timed_out_) {
-    int full_sec = (int) sec;
-    int nsec = int((sec - full_sec) * 1000 * 1000 * 1000);
-    struct timeval tv;
-    gettimeofday(&tv, nullptr);
-    timespec abstime;
-    abstime.tv_sec = tv.tv_sec + full_sec;
-    abstime.tv_nsec = tv.tv_usec * 1000 + nsec;
-    if (abstime.tv_nsec > 1000 * 1000 * 1000) {
-      abstime.tv_nsec -= 1000 * 1000 * 1000;
-      abstime.tv_sec += 1;
-    }
+  if (state_.load() == PENDING) {
     Log::debug("wait for %lf", sec);
-    int ret = pthread_cond_timedwait(&ready_cond_, &ready_m_, &abstime);
-    if (ret == ETIMEDOUT) {
-      timed_out_ = true;
+    if (Coroutine::CurrentCoroutine()) {
+      coro_wait(sec);
     } else {
-      verify(ret == 0);
+      Timer t;
+      t.start();
+      pool_->n_thread_waiters_++;
+      pool_->wait_m_.lock();
+      while (state_.load() == PENDING) {
+        double left = sec - t.elapsed();
+        if (left <= 0) {
+          break;
+        }
+        int ret = pool_->wait_cv_.timed_wait(pool_->wait_m_, left);
+        verify(ret == 0 || ret == ETIMEDOUT);
+      }
+      pool_->wait_m_.unlock();
+      pool_->n_thread_waiters_--;
+      time_out();
     }
   }
-  Pthread_mutex_unlock(&ready_m_);
-  if (timed_out_) {
-    error_code_ = ETIMEDOUT;
+  if (state_.load() == TIMED_OUT) {
     if (attr_.callback != nullptr) {
       attr_.callback(this);
     }
   }
 }
 
-void Future::notify_ready() {
-  Pthread_mutex_lock(&ready_m_);
-  if (!timed_out_) {
-    ready_ = true;
-  }
-  Pthread_cond_signal(&ready_cond_);
-  Pthread_mutex_unlock(&ready_m_);
-  if (ready_ && attr_.callback != nullptr) {
-//    Coroutine::CreateRun([this]() {
-//      this->attr_.callback(this);
-//    });
-        attr_.callback(this);
+Future* FuturePool::get(i64 xid, const FutureAttr& attr) {
+  Future* fu = nullptr;
+  l_.lock();
+  if (!free_.empty()) {
+    fu = free_.back();
+    free_.pop_back();
+  }
+  l_.unlock();
+  if (fu == nullptr) {
+    fu = new Future(shared_from_this());
+  }
+  fu->reset(xid, attr);
+  return fu;
+}
+
+void FuturePool::put(Future* fu) {
+  l_.lock();
+  if (!closed_ && free_.size() < max_free) {
+    free_.push_back(fu);
+    fu = nullptr;
+  }
+  l_.unlock();
+  // may free the pool, do it last.
+  delete fu;
+}
+
+void FuturePool::close() {
+  std::vector<Future*> futures;
+  l_.lock();
+  closed_ = true;
+  futures.swap(free_);
+  l_.unlock();
+  for (auto fu : futures) {
+    delete fu;
   }
 }
 
@@ -243,7 +363,7 @@ Future* Client::begin_request(i32 rpc_id, const FutureAttr& attr /* =... */) {
     return nullptr;
   }
 
-  Future* fu = new Future(xid_counter_.next(), attr);
+  Future* fu = fu_pool_->get(xid_counter_.next(), attr);
   pending_fu_l_.lock();
   pending_fu_[fu->xid_] = fu;
   pending_fu_l_.unlock();
@@ -267,7 +387,7 @@ Future* Client::begin_request(i32 rpc_id, const FutureAttr& attr /* =... */) {
   *this << rpc_id;
 
   // one ref is already in pending_fu_
-  return (Future*) fu->ref_copy();
+  return fu->ref_copy();
 }
 
 void Client::end_request() {
@@ -279,6 +399,10 @@ void Client::end_request() {
     bmark_ = nullptr;
   }
 
+#ifdef RPC_STATISTICS
+  stat_marshal_rpc();
+#endif // RPC_STATISTICS
+
   // always enable write events since the code above gauranteed there
   // will be some data to send
   pollmgr_->update_mode(this, Pollable::READ | Pollable::WRITE);
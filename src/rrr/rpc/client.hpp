@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <vector>
 #include <unordered_map>
 
 #include "misc/marshal.hpp"
@@ -18,43 +21,71 @@ struct FutureAttr {
     std::function<void(Future*)> callback;
 };
 
-class Future: public RefCounted {
+class FuturePool;
+
+/**
+ * The reply of one request. Waiting for it suspends the calling coroutine,
+ * or blocks the calling thread when there is none; Client::handle_read
+ * resumes the waiter once the reply is in. A future has no lock of its
+ * own: its state is an atomic, blocked threads share the condvar of the
+ * connection, and futures are recycled through the free-list of their
+ * connection.
+ */
+class Future: public NoCopy {
     friend class Client;
+    friend class FuturePool;
 
+    enum {
+        PENDING, READY, TIMED_OUT
+    };
+
+    // a coroutine suspended in wait(), lives on the coroutine's stack.
+    struct CoroWaiter {
+        std::shared_ptr<Reactor> reactor;
+        IntEvent* ev;
+    };
+
+    std::atomic<int> refcnt_;
     i64 xid_;
     i32 error_code_;
 
     FutureAttr attr_;
     Marshal reply_;
 
-    bool ready_;
-    bool timed_out_;
-    pthread_cond_t ready_cond_;
-    pthread_mutex_t ready_m_;
+    std::atomic<int> state_;
+    std::atomic<CoroWaiter*> coro_waiter_;
 
-    void notify_ready();
-
-protected:
+    // the free-list this future goes back to.
+    std::shared_ptr<FuturePool> pool_;
 
-    // protected destructor as required by RefCounted.
-    ~Future() {
-        Pthread_mutex_destroy(&ready_m_);
-        Pthread_cond_destroy(&ready_cond_);
+    Future(const std::shared_ptr<FuturePool>& pool)
+            : refcnt_(1), xid_(0), error_code_(0), state_(PENDING),
+              coro_waiter_(nullptr), pool_(pool) {
     }
 
+    ~Future() { }
+
+    void reset(i64 xid, const FutureAttr& attr);
+
+    // only the one moving the state out of PENDING wakes up the waiters.
+    void wake();
+    void notify_ready();
+    void time_out();
+
+    void coro_wait(double sec);
+
 public:
 
-    Future(i64 xid, const FutureAttr& attr = FutureAttr())
-            : xid_(xid), error_code_(0), attr_(attr), ready_(false), timed_out_(false) {
-        Pthread_mutex_init(&ready_m_, nullptr);
-        Pthread_cond_init(&ready_cond_, nullptr);
+    Future* ref_copy() {
+        refcnt_.fetch_add(1, std::memory_order_relaxed);
+        return this;
     }
 
+    // the last release puts the future back to its free-list.
+    int release();
+
     bool ready() {
-        Pthread_mutex_lock(&ready_m_);
-        bool r = ready_;
-        Pthread_mutex_unlock(&ready_m_);
-        return r;
+        return state_.load() == READY;
     }
 
     // wait till reply done
@@ -79,6 +110,36 @@ public:
     }
 };
 
+/**
+ * Free-list of the futures of one connection.
+ */
+class FuturePool: public NoCopy,
+                  public std::enable_shared_from_this<FuturePool> {
+    friend class Future;
+
+    SpinLock l_;
+    std::vector<Future*> free_;
+    bool closed_;
+
+    // shared by all threads (not coroutines) waiting on a future of ours.
+    Mutex wait_m_;
+    CondVar wait_cv_;
+    std::atomic<int> n_thread_waiters_;
+
+public:
+
+    // idle futures kept for reuse, the rest are freed.
+    static const size_t max_free = 1024;
+
+    FuturePool(): closed_(false), n_thread_waiters_(0) { }
+
+    Future* get(i64 xid, const FutureAttr& attr);
+    void put(Future* fu);
+
+    // free the idle futures, futures still in use free themselves.
+    void close();
+};
+
 class FutureGroup {
 private:
     std::vector<Future*> futures_;
@@ -123,6 +184,7 @@ class Client: public Pollable {
 
     Counter xid_counter_;
     std::unordered_map<i64, Future*> pending_fu_;
+    std::shared_ptr<FuturePool> fu_pool_;
 
     SpinLock pending_fu_l_;
     SpinLock out_l_;
@@ -136,11 +198,13 @@ protected:
 
     virtual ~Client() {
         invalidate_pending_futures();
+        fu_pool_->close();
     }
 
 public:
 
-    Client(PollMgr* pollmgr): pollmgr_(pollmgr), sock_(-1), status_(NEW), bmark_(nullptr) { }
+    Client(PollMgr* pollmgr): pollmgr_(pollmgr), sock_(-1), status_(NEW), bmark_(nullptr),
+                              fu_pool_(std::make_shared<FuturePool>()) { }
 
     /**
      * Start a new request. Must be paired with end_request(), even if nullptr returned.
@@ -122,6 +122,10 @@ void ServerConnection::end_reply() {
         bmark_ = nullptr;
     }
 
+#ifdef RPC_STATISTICS
+    stat_marshal_rpc();
+#endif // RPC_STATISTICS
+
     // always enable write events since the code above gauranteed there
     // will be some data to send
     server_->pollmgr_->update_mode(this, Pollable::READ | Pollable::WRITE);
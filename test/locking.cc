@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "rrr/rrr.hpp"
+#include "memdb/locking.h"
+
+using namespace std;
+using namespace rrr;
+using namespace mdb;
+
+TEST(RWLockTest, basic) {
+  RWLock l;
+  ASSERT_FALSE(l.is_rlocked());
+  ASSERT_TRUE(l.rlock_by(1));
+  ASSERT_TRUE(l.rlock_by(1));
+  ASSERT_TRUE(l.rlock_by(2));
+  ASSERT_TRUE(l.is_rlocked());
+  ASSERT_FALSE(l.wlock_by(1));
+  ASSERT_TRUE(l.unlock_by(2));
+  ASSERT_FALSE(l.unlock_by(2));
+  // the only reader upgrades
+  ASSERT_TRUE(l.wlock_by(1));
+  ASSERT_TRUE(l.is_wlocked());
+  ASSERT_FALSE(l.is_rlocked());
+  ASSERT_EQ(l.wlock_owner(), 1);
+  ASSERT_TRUE(l.rlock_by(1));
+  ASSERT_TRUE(l.wlock_by(1));
+  ASSERT_FALSE(l.rlock_by(2));
+  ASSERT_FALSE(l.wlock_by(2));
+  ASSERT_TRUE(l.rlock_owner().empty());
+  ASSERT_TRUE(l.unlock_by(1));
+  ASSERT_FALSE(l.is_wlocked());
+  ASSERT_FALSE(l.is_rlocked());
+  ASSERT_TRUE(l.wlock_by(2));
+  ASSERT_TRUE(l.unlock_by(2));
+}
+
+TEST(RWLockTest, many_readers) {
+  RWLock l;
+  for (lock_owner_t o = 0; o < 50; o++) {
+    ASSERT_TRUE(l.rlock_by(o));
+  }
+  auto owners = l.rlock_owner();
+  sort(owners.begin(), owners.end());
+  ASSERT_EQ(owners.size(), 50);
+  for (lock_owner_t o = 0; o < 50; o++) {
+    ASSERT_EQ(owners[o], o);
+  }
+  RWLock copy(l);
+  for (lock_owner_t o = 0; o < 49; o++) {
+    ASSERT_TRUE(l.unlock_by(o));
+  }
+  ASSERT_TRUE(l.wlock_by(49));
+  ASSERT_FALSE(copy.wlock_by(49));
+  ASSERT_EQ(copy.rlock_owner().size(), 50);
+  copy = l;
+  ASSERT_EQ(copy.wlock_owner(), 49);
+  ASSERT_TRUE(copy.unlock_by(49));
+  ASSERT_FALSE(copy.is_wlocked());
+  ASSERT_FALSE(copy.is_rlocked());
+}
+
+// threads lock one row for their own owners and check that a writer is
+// never in with anyone else.
+TEST(RWLockTest, threads) {
+  const int n_threads = 4, n_ops = 100000;
+  RWLock l;
+  atomic<int> readers(0), writers(0), bad(0), n_writes(0);
+  vector<thread> threads;
+  for (int t = 0; t < n_threads; t++) {
+    threads.emplace_back([&, t] () {
+      for (int i = 0; i < n_ops; i++) {
+        lock_owner_t o = (lock_owner_t) t * n_ops + i;
+        if (i % 8 == 0) {
+          if (l.wlock_by(o)) {
+            if (writers++ != 0 || readers != 0) {
+              bad++;
+            }
+            n_writes++;
+            writers--;
+            ASSERT_TRUE(l.unlock_by(o));
+          }
+        } else if (l.rlock_by(o)) {
+          readers++;
+          if (writers != 0) {
+            bad++;
+          }
+          readers--;
+          ASSERT_TRUE(l.unlock_by(o));
+        }
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(bad, 0);
+  ASSERT_GT(n_writes, 0);
+  ASSERT_FALSE(l.is_rlocked());
+  ASSERT_FALSE(l.is_wlocked());
+}
+
+// shared lock and unlock pairs per second, against the previous lock: an
+// unordered_set of owners behind the mutex the scheduler held.
+TEST(RWLockTest, rlock_cost) {
+  const int n_rows = 1000, n_rounds = 200;
+  vector<RWLock> locks(n_rows);
+  vector<unordered_set<lock_owner_t>> sets(n_rows);
+  recursive_mutex mtx;
+  for (int lockfree : {0, 1}) {
+    Timer t;
+    t.start();
+    for (int r = 0; r < n_rounds; r++) {
+      for (int i = 0; i < n_rows; i++) {
+        // two readers on a row, as a read-only txn overlapping another
+        for (lock_owner_t o : {2 * r, 2 * r + 1}) {
+          if (lockfree) {
+            verify(locks[i].rlock_by(o));
+          } else {
+            lock_guard<recursive_mutex> guard(mtx);
+            sets[i].insert(o);
+          }
+        }
+        for (lock_owner_t o : {2 * r, 2 * r + 1}) {
+          if (lockfree) {
+            verify(locks[i].unlock_by(o));
+          } else {
+            lock_guard<recursive_mutex> guard(mtx);
+            sets[i].erase(o);
+          }
+        }
+      }
+    }
+    t.stop();
+    Log_info("rwlock %s: %.0f rlock/unlock pairs/s",
+             lockfree ? "lock word" : "mutex + set",
+             2.0 * n_rounds * n_rows / t.elapsed());
+  }
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "rrr/rrr.hpp"
+
+using namespace std;
+using namespace rrr;
+
+static string read_all(Marshal& m) {
+  string s(m.content_size(), '\0');
+  verify(m.read(&s[0], s.size()) == s.size());
+  return s;
+}
+
+static string pattern(size_t n, char seed) {
+  string s(n, '\0');
+  for (size_t i = 0; i < n; i++) {
+    s[i] = seed + i % 23;
+  }
+  return s;
+}
+
+TEST(MarshalTest, write_external) {
+  auto sp_buf = make_shared<string>(pattern(100 * 1000, 'a'));
+  string head = pattern(100, 'A'), tail = pattern(20000, 'x');
+  Marshal m;
+  m.write(head.data(), head.size());
+  m.write_external(sp_buf->data(), sp_buf->size(), sp_buf);
+  m.write(tail.data(), tail.size());
+  ASSERT_EQ(sp_buf.use_count(), 2);
+  ASSERT_EQ(m.content_size(), head.size() + sp_buf->size() + tail.size());
+  ASSERT_EQ(read_all(m), head + *sp_buf + tail);
+  // the holder goes away with the bytes.
+  ASSERT_EQ(sp_buf.use_count(), 1);
+}
+
+TEST(MarshalTest, write_shared) {
+  Marshal src;
+  string s1 = pattern(20000, 'a'), s2 = pattern(300, 'b');
+  src.write(s1.data(), s1.size());
+  Marshal dst1, dst2;
+  dst1.write(s2.data(), s2.size());
+  dst1.write_shared(src);
+  dst2.write_shared(src);
+  // neither side writes into bytes the other one still refers to.
+  src.write(s2.data(), s2.size());
+  dst1.write(s2.data(), s2.size());
+  dst2 << (i32) 7;
+  ASSERT_EQ(read_all(dst1), s2 + s1 + s2);
+  string s;
+  s.resize(s1.size());
+  dst2.read(&s[0], s.size());
+  ASSERT_EQ(s, s1);
+  i32 v;
+  dst2 >> v;
+  ASSERT_EQ(v, 7);
+  ASSERT_TRUE(dst2.empty());
+  ASSERT_EQ(read_all(src), s1 + s2);
+}
+
+TEST(MarshalTest, write_shared_small) {
+  Marshal src, dst;
+  string s1 = pattern(100, 'a');
+  src.write(s1.data(), s1.size());
+  dst.write(s1.data(), 1);
+  dst.write_shared(src);
+  dst.write(s1.data(), 1);
+  ASSERT_EQ(read_all(dst), s1.substr(0, 1) + s1 + s1.substr(0, 1));
+  ASSERT_EQ(read_all(src), s1);
+}
+
+TEST(MarshalTest, read_from_marshal) {
+  string s1 = pattern(5000, 'a'), s2 = pattern(40, 'b'), s3 = pattern(10, 'c');
+  for (size_t n : {(size_t) 10, (size_t) 4000}) {
+    Marshal src, dst;
+    src.write(s1.data(), s1.size());
+    dst.write(s2.data(), s2.size());
+    dst.read_from_marshal(src, n);
+    src.write(s3.data(), s3.size());
+    dst.write(s3.data(), s3.size());
+    ASSERT_EQ(read_all(dst), s2 + s1.substr(0, n) + s3);
+    ASSERT_EQ(read_all(src), s1.substr(n) + s3);
+  }
+}
+
+TEST(MarshalTest, write_to_fd) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_GT(fcntl(fds[1], F_SETPIPE_SZ, 1024 * 1024), 0);
+  fcntl(fds[0], F_SETFL, O_NONBLOCK);
+  fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+  Marshal m;
+  string expected;
+  auto sp_buf = make_shared<string>(pattern(50 * 1000, 'k'));
+  for (int i = 0; i < 100; i++) {
+    string s = pattern(3000, 'a' + i % 7);
+    m.write(s.data(), s.size());
+    expected += s;
+    if (i % 10 == 0) {
+      m.write_external(sp_buf->data(), sp_buf->size(), sp_buf);
+      expected += *sp_buf;
+    }
+  }
+  ASSERT_EQ(m.content_size(), expected.size());
+  string received;
+  while (!m.empty()) {
+    m.write_to_fd(fds[1]);
+    Marshal in;
+    in.read_from_fd(fds[0]);
+    received += read_all(in);
+  }
+  ASSERT_EQ(received, expected);
+  ASSERT_EQ(sp_buf.use_count(), 1);
+  close(fds[0]);
+  close(fds[1]);
+}
+
+TEST(MarshalTest, sparse_int) {
+  vector<i64> vals = {0, 1, -1, 63, -64, 64, 8191, -8193, 1LL << 40,
+                      (1LL << 55) - 1, -(1LL << 55), 1LL << 55,
+                      (1LL << 32) * 12345 + 7, INT64_MAX, INT64_MIN};
+  Marshal m;
+  for (i64 v : vals) {
+    m << v64(v);
+  }
+  for (i64 v : vals) {
+    v64 got;
+    m >> got;
+    ASSERT_EQ(got.get(), v);
+  }
+  ASSERT_TRUE(m.empty());
+}
@@ -0,0 +1,479 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "memdb/row.h"
+#include "memdb/table.h"
+#include "memdb/txn_unsafe.h"
+
+using namespace mdb;
+
+TEST(TableIdTest, catalog) {
+  tblid_t a = table_id("test_table_a");
+  tblid_t b = table_id("test_table_b");
+  ASSERT_NE(a, b);
+  ASSERT_EQ(table_id("test_table_a"), a);
+
+  // the same name has the same id in every TxnMgr.
+  TxnMgrUnsafe mgr1, mgr2;
+  Schema schema;
+  schema.add_column("id", Value::I32, true);
+  auto tbl1 = new UnsortedTable("test_table_b", &schema);
+  auto tbl2 = new UnsortedTable("test_table_b", &schema);
+  mgr1.reg_table("test_table_b", tbl1);
+  mgr2.reg_table("test_table_b", tbl2);
+  ASSERT_EQ(mgr1.get_table(b), tbl1);
+  ASSERT_EQ(mgr2.get_table(b), tbl2);
+  ASSERT_EQ(mgr1.get_table(a), nullptr);
+  ASSERT_EQ(mgr1.get_table(table_id("test_table_unknown")), nullptr);
+  delete tbl1;
+  delete tbl2;
+}
+
+// (w_id, d_id, c_id) of the customer table.
+static void customer_schema(Schema& schema) {
+  schema.add_column("c_w_id", Value::I32, true);
+  schema.add_column("c_d_id", Value::I32, true);
+  schema.add_column("c_id", Value::I32, true);
+  schema.add_column("c_balance", Value::I32);
+}
+
+static MultiBlob customer_key(const std::vector<Value>& key) {
+  MultiBlob mb(key.size());
+  for (size_t i = 0; i < key.size(); i++) {
+    mb[i] = key[i].get_blob();
+  }
+  return mb;
+}
+
+TEST(UnsortedTableTest, basic) {
+  Schema schema;
+  customer_schema(schema);
+  UnsortedTable tbl("test_customer", &schema);
+  const int n = 1000;
+  for (int i = 0; i < n; i++) {
+    tbl.insert(Row::create(&schema, std::vector<Value>(
+        {Value(i % 3), Value(i % 10), Value(i), Value(i)})));
+  }
+  ASSERT_EQ(tbl.size(), n);
+  ASSERT_EQ(tbl.all().count(), n);
+  for (int i = 0; i < n; i++) {
+    std::vector<Value> key({Value(i % 3), Value(i % 10), Value(i)});
+    auto cursor = tbl.query(customer_key(key));
+    ASSERT_EQ(cursor.count(), 1);
+    ASSERT_EQ(cursor.next()->get_column(3).get_i32(), i);
+    ASSERT_FALSE(cursor.has_next());
+  }
+  std::vector<Value> missing({Value(1), Value(0), Value(0)});
+  ASSERT_FALSE(tbl.query(customer_key(missing)).has_next());
+
+  // a duplicate key sits in the same probe chain.
+  std::vector<Value> dup({Value(0), Value(0), Value(0)});
+  Row* row = Row::create(&schema, std::vector<Value>(
+      {Value(0), Value(0), Value(0), Value(-1)}));
+  tbl.insert(row);
+  ASSERT_EQ(tbl.query(customer_key(dup)).count(), 2);
+  tbl.remove(row);
+  ASSERT_EQ(tbl.query(customer_key(dup)).count(), 1);
+  ASSERT_EQ(tbl.query(customer_key(dup)).next()->get_column(3).get_i32(), 0);
+
+  // every other row out, the rest still found behind the shifted slots.
+  for (int i = 0; i < n; i += 2) {
+    std::vector<Value> key({Value(i % 3), Value(i % 10), Value(i)});
+    tbl.remove(customer_key(key));
+  }
+  ASSERT_EQ(tbl.size(), n / 2);
+  for (int i = 0; i < n; i++) {
+    std::vector<Value> key({Value(i % 3), Value(i % 10), Value(i)});
+    ASSERT_EQ(tbl.query(customer_key(key)).count(), i % 2);
+  }
+  tbl.clear();
+  ASSERT_EQ(tbl.size(), 0);
+  ASSERT_FALSE(tbl.all().has_next());
+}
+
+// the customer keys of tpcc: how many share a hash under the old xor of
+// the column hashes and under the chained one, the longest probe of the
+// table, and point lookups per second against the sorted table.
+TEST(UnsortedTableTest, tpcc_keys) {
+  const int n_w = 4, n_d = 10, n_c = 3000;
+  Schema schema;
+  customer_schema(schema);
+  std::vector<std::vector<Value>> keys;
+  for (int w = 1; w <= n_w; w++) {
+    for (int d = 1; d <= n_d; d++) {
+      for (int c = 1; c <= n_c; c++) {
+        keys.push_back({Value(w), Value(d), Value(c)});
+      }
+    }
+  }
+  auto largest_bucket = [&keys] (std::function<uint32_t(const MultiBlob&)> h) {
+    std::unordered_map<uint32_t, int> buckets;
+    int largest = 0;
+    for (auto& key : keys) {
+      largest = std::max(largest, ++buckets[h(customer_key(key))]);
+    }
+    return std::make_pair(buckets.size(), largest);
+  };
+  auto xored = largest_bucket([] (const MultiBlob& mb) {
+    uint32_t v = 0;
+    for (int i = 0; i < mb.count(); i++) {
+      v ^= stringhash32(mb[i].data, mb[i].len);
+    }
+    return v;
+  });
+  auto chained = largest_bucket([] (const MultiBlob& mb) {
+    return (uint32_t) MultiBlob::hash()(mb);
+  });
+  Log_info("%d tpcc customer keys, distinct hashes: xor %d (largest %d), "
+           "chained %d (largest %d)", (int) keys.size(),
+           (int) xored.first, xored.second,
+           (int) chained.first, chained.second);
+  ASSERT_GT(chained.first, keys.size() * 999 / 1000);
+  ASSERT_LE(chained.second, 2);
+
+  UnsortedTable unsorted("test_customer", &schema);
+  SortedTable sorted("test_customer", &schema);
+  for (auto& key : keys) {
+    std::vector<Value> values(key);
+    values.push_back(Value(0));
+    unsorted.insert(Row::create(&schema, values));
+    sorted.insert(Row::create(&schema, values));
+  }
+  Log_info("unsorted table: %d rows, longest probe %d slots",
+           (int) unsorted.size(), (int) unsorted.max_chain());
+
+  // scattered, as the lookups of concurrent txns are.
+  std::vector<MultiBlob> lookups;
+  for (size_t i = 0; i < keys.size(); i++) {
+    lookups.push_back(customer_key(keys[(i * 7919) % keys.size()]));
+  }
+  const int n_rounds = 2;
+  for (int is_sorted : {0, 1}) {
+    int found = 0;
+    rrr::Timer t;
+    t.start();
+    for (int r = 0; r < n_rounds; r++) {
+      for (auto& mb : lookups) {
+        if (is_sorted) {
+          found += sorted.query(mb).has_next();
+        } else {
+          found += unsorted.query(mb).has_next();
+        }
+      }
+    }
+    t.stop();
+    ASSERT_EQ(found, n_rounds * lookups.size());
+    Log_info("%s table: %.0f point lookups/s", is_sorted ? "sorted" : "unsorted",
+             found / t.elapsed());
+  }
+}
+
+// rows sorted by (a, b), or by (name, b) when by_name.
+static void pair_schema(Schema& schema, bool by_name) {
+  if (by_name) {
+    schema.add_column("name", Value::STR, true);
+  } else {
+    schema.add_column("a", Value::I32, true);
+  }
+  schema.add_column("b", Value::I64, true);
+  schema.add_column("v", Value::I32);
+}
+
+static std::vector<Value> pair_row(bool by_name, int a, int b, int v) {
+  Value first = by_name ? Value(std::string(a % 7, '\0') + std::to_string(a))
+                        : Value(a - 50);
+  return {first, Value((i64) b - 3), Value(v)};
+}
+
+static std::vector<int> values_of(SortedTable::Cursor cursor) {
+  std::vector<int> ret;
+  while (cursor.has_next()) {
+    ret.push_back(cursor.next()->get_column(2).get_i32());
+  }
+  return ret;
+}
+
+static std::vector<int> values_of(std::multimap<SortedMultiKey, Row*>::iterator first,
+                                  std::multimap<SortedMultiKey, Row*>::iterator last,
+                                  bool reverse) {
+  std::vector<int> ret;
+  for (auto it = first; it != last; ++it) {
+    ret.push_back(it->second->get_column(2).get_i32());
+  }
+  if (reverse) {
+    std::reverse(ret.begin(), ret.end());
+  }
+  return ret;
+}
+
+// the same inserts, queries and removes on a SortedTable and on the
+// std::multimap it used to be, with duplicates, negative numbers and
+// strings with 0 bytes in the keys.
+TEST(SortedTableTest, against_multimap) {
+  for (bool by_name : {false, true}) {
+    Schema schema;
+    pair_schema(schema, by_name);
+    SortedTable tbl("test_pairs", &schema);
+    std::multimap<SortedMultiKey, Row*> ref;
+    std::vector<Row*> rows;
+    const int n = 10000;
+    srand(7);
+    for (int i = 0; i < n; i++) {
+      Row* row = Row::create(&schema, pair_row(by_name, rand() % 100, rand() % 8, i));
+      tbl.insert(row);
+      ref.insert(std::make_pair(SortedMultiKey(row->get_key(), &schema), row));
+      rows.push_back(row);
+    }
+    ASSERT_EQ(tbl.size(), n);
+    ASSERT_EQ(values_of(tbl.all()), values_of(ref.begin(), ref.end(), false));
+    ASSERT_EQ(values_of(tbl.all(symbol_t::ORD_DESC)),
+              values_of(ref.begin(), ref.end(), true));
+
+    for (int round = 0; round < 100; round++) {
+      auto low_row = pair_row(by_name, rand() % 100, rand() % 8, 0);
+      auto high_row = pair_row(by_name, rand() % 100, rand() % 8, 0);
+      Row* low_tmp = Row::create(&schema, low_row);
+      Row* high_tmp = Row::create(&schema, high_row);
+      SortedMultiKey low(low_tmp->get_key(), &schema);
+      SortedMultiKey high(high_tmp->get_key(), &schema);
+      if (high < low) {
+        std::swap(low, high);
+      }
+      auto range = ref.equal_range(low);
+      ASSERT_EQ(values_of(tbl.query(low)), values_of(range.first, range.second, false));
+      for (symbol_t order : {symbol_t::ORD_ASC, symbol_t::ORD_DESC}) {
+        bool desc = order == symbol_t::ORD_DESC;
+        ASSERT_EQ(values_of(tbl.query_lt(high, order)),
+                  values_of(ref.begin(), ref.lower_bound(high), desc));
+        ASSERT_EQ(values_of(tbl.query_gt(low, order)),
+                  values_of(ref.upper_bound(low), ref.end(), desc));
+        if (low < high) {
+          ASSERT_EQ(values_of(tbl.query_in(low, high, order)),
+                    values_of(ref.upper_bound(low), ref.lower_bound(high), desc));
+        }
+      }
+      // take out a key, and a single row.
+      if (round % 3 == 0) {
+        auto gone = ref.equal_range(low);
+        for (auto it = gone.first; it != gone.second; ++it) {
+          rows.erase(std::find(rows.begin(), rows.end(), it->second));
+        }
+        // the keys of ref point into the rows, out before they are freed.
+        ref.erase(low);
+        tbl.remove(low);
+      }
+      Row* victim = rows[rand() % rows.size()];
+      if (victim->get_table() != nullptr) {
+        SortedMultiKey key(victim->get_key(), &schema);
+        auto vr = ref.equal_range(key);
+        for (auto it = vr.first; it != vr.second; ++it) {
+          if (it->second == victim) {
+            ref.erase(it);
+            break;
+          }
+        }
+        tbl.remove(victim, false);
+      }
+      low_tmp->release();
+      high_tmp->release();
+    }
+    ASSERT_EQ(tbl.size(), ref.size());
+    ASSERT_EQ(values_of(tbl.all()), values_of(ref.begin(), ref.end(), false));
+    ASSERT_EQ(values_of(tbl.all(symbol_t::ORD_DESC)),
+              values_of(ref.begin(), ref.end(), true));
+    // removed rows left the table, the rest are released with it.
+    for (auto row : rows) {
+      if (row->get_table() == nullptr) {
+        row->release();
+      }
+    }
+  }
+}
+
+// readers looking up rows while a writer fills and empties the tree
+// around them.
+TEST(SortedTableTest, concurrent_find) {
+  Schema schema;
+  pair_schema(schema, false);
+  BTree tree(&schema);
+  const int n_stable = 2000, n_churn = 20000, n_readers = 3;
+  std::vector<Row*> stable, churn;
+  for (int i = 0; i < n_stable; i++) {
+    stable.push_back(Row::create(&schema, pair_row(false, i * 2, 0, i)));
+    tree.insert(NormKey(stable.back()), stable.back());
+  }
+  for (int i = 0; i < n_churn; i++) {
+    churn.push_back(Row::create(&schema, pair_row(false, i % 4000 * 2 + 1, i, i)));
+  }
+  std::atomic<bool> done(false);
+  std::atomic<int> misses(0);
+  std::atomic<uint64_t> lookups(0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < n_readers; r++) {
+    readers.emplace_back([&, r] () {
+      uint64_t n = 0;
+      for (int i = r; !done || n < 100000; i = (i + 7) % n_stable, n++) {
+        Row* row = tree.find(NormKey(stable[i]));
+        if (row != stable[i]) {
+          misses++;
+        }
+      }
+      lookups += n;
+    });
+  }
+  rrr::Timer t;
+  t.start();
+  for (int round = 0; round < 3; round++) {
+    for (auto row : churn) {
+      tree.insert(NormKey(row), row);
+    }
+    for (auto row : churn) {
+      tree.erase(tree.find(NormKey(row), row));
+    }
+  }
+  done = true;
+  for (auto& th : readers) {
+    th.join();
+  }
+  t.stop();
+  ASSERT_EQ(misses, 0);
+  ASSERT_EQ(tree.size(), n_stable);
+  Log_info("btree: %d readers, %.0f lookups/s next to a writer",
+           n_readers, lookups / t.elapsed());
+  for (auto row : stable) {
+    row->release();
+  }
+  for (auto row : churn) {
+    row->release();
+  }
+}
+
+// order_line keys (o_d_id, o_w_id, o_id, ol_number): point lookups and the
+// range scans of stock-level, on the multimap and on the SortedTable.
+TEST(SortedTableTest, tpcc_scans) {
+  Schema schema;
+  schema.add_column("ol_d_id", Value::I32, true);
+  schema.add_column("ol_w_id", Value::I32, true);
+  schema.add_column("ol_o_id", Value::I32, true);
+  schema.add_column("ol_number", Value::I32, true);
+  schema.add_column("ol_i_id", Value::I32);
+  const int n_d = 10, n_o = 1000, n_ol = 10;
+  SortedTable tbl("test_order_line", &schema);
+  std::multimap<SortedMultiKey, Row*> ref;
+  std::vector<MultiBlob> keys;
+  for (int d = 1; d <= n_d; d++) {
+    for (int o = 1; o <= n_o; o++) {
+      for (int ol = 1; ol <= n_ol; ol++) {
+        Row* row = Row::create(&schema, std::vector<Value>(
+            {Value(d), Value(1), Value(o), Value(ol), Value(o + ol)}));
+        tbl.insert(row);
+        ref.insert(std::make_pair(SortedMultiKey(row->get_key(), &schema), row));
+        keys.push_back(row->get_key());
+      }
+    }
+  }
+  std::vector<MultiBlob> lookups;
+  for (size_t i = 0; i < keys.size(); i++) {
+    lookups.push_back(keys[(i * 7919) % keys.size()]);
+  }
+  for (int use_ref : {1, 0}) {
+    int found = 0;
+    rrr::Timer t;
+    t.start();
+    for (auto& mb : lookups) {
+      SortedMultiKey smk(mb, &schema);
+      if (use_ref) {
+        found += ref.find(smk) != ref.end();
+      } else {
+        found += tbl.query(smk).has_next();
+      }
+    }
+    t.stop();
+    ASSERT_EQ(found, lookups.size());
+    double lookup_rate = found / t.elapsed();
+
+    // the last 20 orders of every district.
+    uint64_t scanned = 0;
+    t.start();
+    for (int round = 0; round < 20; round++) {
+      for (int d = 1; d <= n_d; d++) {
+        Value lv[] = {Value(d), Value(1), Value(n_o - 20), Value(n_ol)};
+        Value hv[] = {Value(d), Value(1), Value(n_o + 1), Value(0)};
+        MultiBlob low(4), high(4);
+        for (int i = 0; i < 4; i++) {
+          low[i] = lv[i].get_blob();
+          high[i] = hv[i].get_blob();
+        }
+        SortedMultiKey lk(low, &schema), hk(high, &schema);
+        if (use_ref) {
+          auto end = ref.lower_bound(hk);
+          for (auto it = ref.upper_bound(lk); it != end; ++it) {
+            scanned += it->second->get_column(4).get_i32() > 0;
+          }
+        } else {
+          auto cursor = tbl.query_in(lk, hk);
+          while (cursor.has_next()) {
+            scanned += cursor.next()->get_column(4).get_i32() > 0;
+          }
+        }
+      }
+    }
+    t.stop();
+    ASSERT_EQ(scanned, 20 * n_d * 20 * n_ol);
+    Log_info("%s: %.0f point lookups/s, %.0f scanned rows/s",
+             use_ref ? "multimap" : "sorted table (btree)",
+             lookup_rate, scanned / t.elapsed());
+  }
+}
+
+TEST(VersionedRowTest, versions) {
+  Schema schema;
+  customer_schema(schema);
+  auto row = VersionedRow::create(&schema, std::vector<Value>(
+      {Value(1), Value(2), Value(3), Value(100)}));
+  for (colid_t c = 0; c < 4; c++) {
+    ASSERT_EQ(row->get_column_ver(c), 0);
+  }
+  row->set_column_ver(3, 7);
+  row->incr_column_ver(3);
+  ASSERT_EQ(row->get_column(3).ver_, 8);
+  ASSERT_EQ(row->get_column(3).get_i32(), 100);
+  auto copy = (VersionedRow*) row->copy();
+  ASSERT_EQ(copy->get_column_ver(3), 8);
+  ASSERT_EQ(copy->get_column_ver(2), 0);
+  ASSERT_EQ(copy->get_column(2).get_i32(), 3);
+
+  // prepares in flight, as tapir records them
+  ASSERT_FALSE(row->has_prepared());
+  row->insert_prepared_rver(3, 8);
+  row->insert_prepared_rver(3, 8);
+  row->insert_prepared_rver(3, 5);
+  row->insert_prepared_wver(3, 12);
+  row->insert_prepared_wver(3, 10);
+  row->insert_prepared_wver(2, 9);
+  ASSERT_TRUE(row->has_prepared());
+  ASSERT_FALSE(copy->has_prepared());
+  ASSERT_EQ(row->max_prepared_rver(3), 8);
+  ASSERT_EQ(row->min_prepared_wver(3), 10);
+  ASSERT_EQ(row->max_prepared_rver(2), 0);
+  ASSERT_EQ(row->min_prepared_wver(2), 9);
+  row->remove_prepared_rver(3, 8);
+  ASSERT_EQ(row->max_prepared_rver(3), 8);
+  row->remove_prepared_rver(3, 8);
+  ASSERT_EQ(row->max_prepared_rver(3), 5);
+  row->remove_prepared_wver(3, 10);
+  ASSERT_EQ(row->min_prepared_wver(3), 12);
+  row->remove_prepared_rver(3, 5);
+  row->remove_prepared_wver(3, 12);
+  row->remove_prepared_wver(2, 9);
+  ASSERT_FALSE(row->has_prepared());
+  ASSERT_EQ(row->min_prepared_wver(3), 0);
+  row->release();
+  copy->release();
+}
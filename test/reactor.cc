@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+#include <atomic>
+#include <unistd.h>
+#include "rrr/rrr.hpp"
+
+using namespace std;
+using namespace rrr;
+
+TEST(ReactorTest, ready_order) {
+  vector<shared_ptr<IntEvent>> events;
+  vector<int> resumed;
+  for (int i = 0; i < 3; i++) {
+    Coroutine::CreateRun([&events, &resumed, i] () {
+      auto sp_ev = Reactor::CreateSpEvent<IntEvent>();
+      events.push_back(sp_ev);
+      sp_ev->Wait();
+      resumed.push_back(i);
+    });
+  }
+  ASSERT_EQ(events.size(), 3);
+  ASSERT_EQ(resumed.size(), 0);
+  events[2]->Set(1);
+  events[0]->Set(1);
+  events[1]->Set(1);
+  Reactor::GetReactor()->Loop();
+  ASSERT_EQ(resumed, vector<int>({2, 0, 1}));
+  ASSERT_EQ(Reactor::GetReactor()->ready_coros_.size(), 0);
+}
+
+TEST(ReactorTest, release_fired) {
+  auto reactor = Reactor::GetReactor();
+  auto n_pending = reactor->events_.size();
+  auto& ev = Reactor::CreateEvent<IntEvent>();
+  ASSERT_EQ(reactor->events_.size(), n_pending + 1);
+  ev.Set(1);
+  ASSERT_EQ(ev.status_, Event::DONE);
+  ASSERT_EQ(reactor->events_.size(), n_pending);
+  reactor->Loop();
+  ASSERT_EQ(reactor->fired_events_.size(), 0);
+}
+
+// the cost of waking up one coroutine should not depend on how many other
+// events are still pending in the reactor.
+TEST(ReactorTest, loop_cost) {
+  auto reactor = Reactor::GetReactor();
+  const int n_round = 10000;
+  for (int n_pending : {10, 100, 1000, 10000, 100000}) {
+    vector<shared_ptr<IntEvent>> pending;
+    for (int i = 0; i < n_pending; i++) {
+      pending.push_back(Reactor::CreateSpEvent<IntEvent>());
+    }
+    IntEvent* p_ev = nullptr;
+    int n_resumed = 0;
+    Coroutine::CreateRun([&p_ev, &n_resumed, n_round] () {
+      for (int i = 0; i < n_round; i++) {
+        auto sp_ev = Reactor::CreateSpEvent<IntEvent>();
+        p_ev = sp_ev.get();
+        sp_ev->Wait();
+        n_resumed++;
+      }
+    });
+    Timer t;
+    t.start();
+    for (int i = 0; i < n_round; i++) {
+      p_ev->Set(1);
+      reactor->Loop();
+    }
+    t.stop();
+    ASSERT_EQ(n_resumed, n_round);
+    Log_info("reactor loop with %d pending events: %.1f ns per wakeup",
+             n_pending, t.elapsed() * 1e9 / n_round);
+    for (auto& sp_ev : pending) {
+      sp_ev->Set(1);
+    }
+    reactor->Loop();
+  }
+}
+
+TEST(TimerWheelTest, fire_in_order) {
+  TimerWheel wheel(1000);
+  uint64_t base = 123456789;
+  // deadlines in every level of the wheel, plus one out of range.
+  vector<uint64_t> delays = {0, 1, 999, 1000, 1001, 255000, 256000, 300000,
+                             16384000, 20000000, 1ull << 36};
+  vector<uint64_t> fired(delays.size(), 0);
+  size_t n_fired = 0;
+  uint64_t now = base;
+  for (size_t i = 0; i < delays.size(); i++) {
+    wheel.Add(now, base + delays[i], [&fired, &n_fired, &now, i] () {
+      fired[i] = now;
+      n_fired++;
+    });
+  }
+  auto sp_cancelled = wheel.Add(now, base + 5000, [] () { ASSERT_TRUE(0); });
+  sp_cancelled->Cancel();
+  ASSERT_EQ(wheel.size(), delays.size() + 1);
+  // jump by uneven steps, timers must never fire early nor miss a tick.
+  while (n_fired < delays.size()) {
+    auto next = wheel.NextTimeout(now);
+    ASSERT_GE(next, 0);
+    now += next > 0 ? next : 777;
+    wheel.Advance(now);
+  }
+  for (size_t i = 0; i < delays.size(); i++) {
+    ASSERT_GE(fired[i], base + delays[i]);
+    ASSERT_LT(fired[i], base + delays[i] + 2000);
+  }
+  ASSERT_EQ(wheel.size(), 0);
+}
+
+TEST(ReactorTest, timed_wait) {
+  shared_ptr<IntEvent> sp_ev1, sp_ev2;
+  bool ret1 = true, ret2 = false;
+  Coroutine::CreateRun([&] () {
+    sp_ev1 = Reactor::CreateSpEvent<IntEvent>();
+    ret1 = sp_ev1->Wait(10 * 1000);
+  });
+  Coroutine::CreateRun([&] () {
+    sp_ev2 = Reactor::CreateSpEvent<IntEvent>();
+    ret2 = sp_ev2->Wait(1000 * 1000);
+  });
+  auto reactor = Reactor::GetReactor();
+  Timer t;
+  t.start();
+  while (sp_ev1->status_ != Event::TIMEOUT) {
+    reactor->Loop();
+  }
+  t.stop();
+  reactor->Loop();
+  ASSERT_FALSE(ret1);
+  ASSERT_GE(t.elapsed(), 0.009);
+  // a late trigger is ignored.
+  sp_ev1->Set(1);
+  ASSERT_EQ(sp_ev1->status_, Event::TIMEOUT);
+  sp_ev2->Set(1);
+  reactor->Loop();
+  ASSERT_TRUE(ret2);
+  ASSERT_EQ(reactor->NextTimeoutMs(1), 1);
+}
+
+TEST(ReactorTest, timeout_event) {
+  bool woken = false;
+  Coroutine::CreateRun([&woken] () {
+    TimeoutEvent ev(5 * 1000);
+    ev.Wait();
+    woken = true;
+  });
+  auto reactor = Reactor::GetReactor();
+  ASSERT_FALSE(woken);
+  ASSERT_LE(reactor->NextTimeoutMs(100), 6);
+  while (!woken) {
+    reactor->Loop();
+  }
+}
+
+class ThreadRecordJob : public OneTimeJob {
+ public:
+  pthread_t th_{};
+  std::atomic<int>& n_done_;
+  ThreadRecordJob(std::atomic<int>& n_done)
+      : OneTimeJob([this] () {
+          th_ = pthread_self();
+          n_done_++;
+        }),
+        n_done_(n_done) {
+  }
+};
+
+static bool wait_until(const std::function<bool()>& cond, double sec = 5) {
+  Timer t;
+  t.start();
+  while (!cond()) {
+    t.stop();
+    if (t.elapsed() > sec) {
+      return false;
+    }
+    usleep(1000);
+  }
+  return true;
+}
+
+TEST(PollMgrTest, spread_jobs) {
+  const int n_threads = 4;
+  auto poll_mgr = new PollMgr(n_threads);
+  std::atomic<int> n_done{0};
+  vector<shared_ptr<ThreadRecordJob>> jobs;
+  for (int i = 0; i < 4 * n_threads; i++) {
+    jobs.push_back(std::make_shared<ThreadRecordJob>(n_done));
+    poll_mgr->add(jobs.back());
+  }
+  ASSERT_TRUE(wait_until([&] () { return n_done == jobs.size(); }));
+  std::set<pthread_t> threads;
+  for (auto& sp_job : jobs) {
+    threads.insert(sp_job->th_);
+  }
+  ASSERT_EQ(threads.size(), n_threads);
+
+  // pinned jobs stay on their thread.
+  n_done = 0;
+  jobs.clear();
+  for (int i = 0; i < 8; i++) {
+    jobs.push_back(std::make_shared<ThreadRecordJob>(n_done));
+    poll_mgr->add(jobs.back(), 2);
+  }
+  ASSERT_TRUE(wait_until([&] () { return n_done == jobs.size(); }));
+  for (auto& sp_job : jobs) {
+    ASSERT_EQ(sp_job->th_, jobs[0]->th_);
+  }
+  poll_mgr->release();
+}
+
+TEST(PollMgrTest, steal_jobs) {
+  auto poll_mgr = new PollMgr(2);
+  // keep thread 0 busy so that its queue backs up.
+  std::atomic<bool> blocked{true};
+  pthread_t th_busy{};
+  auto sp_busy = std::make_shared<OneTimeJob>([&] () {
+    th_busy = pthread_self();
+    while (blocked) {
+      usleep(1000);
+    }
+  });
+  poll_mgr->add(sp_busy, 0);
+  ASSERT_TRUE(wait_until([&] () { return th_busy != pthread_t{}; }));
+
+  const int n_jobs = 200;
+  std::atomic<int> n_done{0};
+  vector<shared_ptr<ThreadRecordJob>> jobs;
+  for (int i = 0; i < n_jobs; i++) {
+    jobs.push_back(std::make_shared<ThreadRecordJob>(n_done));
+    poll_mgr->add(jobs.back());
+  }
+  // all but a short queue left on the busy thread get stolen.
+  ASSERT_TRUE(wait_until([&] () {
+    return n_done >= n_jobs - PollMgr::JOB_STEAL_THRESHOLD;
+  }));
+  for (auto& sp_job : jobs) {
+    if (sp_job->Done()) {
+      ASSERT_NE(sp_job->th_, th_busy);
+    }
+  }
+  blocked = false;
+  ASSERT_TRUE(wait_until([&] () { return n_done == n_jobs; }));
+  poll_mgr->release();
+}
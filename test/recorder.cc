@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "rrr/rrr.hpp"
+
+using namespace std;
+using namespace rrr;
+
+static string log_path(const char* name) {
+  return string("/tmp/rrr_recorder_test_") + name + "_"
+      + to_string(getpid()) + ".log";
+}
+
+static void wait_callbacks(Recorder& recorder, const int& n_done, int n) {
+  while (n_done < n) {
+    recorder.Work();
+  }
+}
+
+TEST(RecorderTest, replay) {
+  for (int policy : {Recorder::FLUSH_NONE,
+                     Recorder::FLUSH_FDATASYNC,
+                     Recorder::FLUSH_DIRECT}) {
+    auto path = log_path("replay");
+    unlink(path.c_str());
+    vector<string> records;
+    for (int round = 0; round < 3; round++) {
+      // every round appends to what the earlier ones left.
+      Recorder recorder(path.c_str(), policy);
+      vector<string> replayed;
+      auto n = recorder.replay([&replayed] (Marshal& m) {
+        string s;
+        m >> s;
+        replayed.push_back(s);
+      });
+      ASSERT_EQ(n, records.size());
+      ASSERT_EQ(replayed, records);
+      int n_done = 0;
+      for (int i = 0; i < 1000; i++) {
+        string s(1 + (i * 37 + round) % 3000, 'a' + i % 26);
+        Marshal m;
+        m << s;
+        recorder.submit(m, [&n_done] () { n_done++; });
+        records.push_back(s);
+      }
+      wait_callbacks(recorder, n_done, 1000);
+    }
+    unlink(path.c_str());
+  }
+}
+
+TEST(RecorderTest, torn_record) {
+  auto path = log_path("torn");
+  unlink(path.c_str());
+  {
+    Recorder recorder(path.c_str(), Recorder::FLUSH_NONE);
+    int n_done = 0;
+    recorder.submit(string(100, 'x'), [&n_done] () { n_done++; });
+    recorder.submit(string(100, 'y'), [&n_done] () { n_done++; });
+    wait_callbacks(recorder, n_done, 2);
+  }
+  // cut the second record short, as a crash in the middle of a write.
+  ASSERT_EQ(truncate(path.c_str(), 150), 0);
+  Recorder recorder(path.c_str(), Recorder::FLUSH_NONE);
+  int n_done = 0;
+  recorder.submit(string(100, 'z'), [&n_done] () { n_done++; });
+  wait_callbacks(recorder, n_done, 1);
+  vector<char> firsts;
+  recorder.replay([&firsts] (Marshal& m) {
+    string s(m.content_size(), '\0');
+    m.read(&s[0], s.size());
+    firsts.push_back(s[0]);
+  });
+  ASSERT_EQ(firsts, vector<char>({'x', 'z'}));
+  unlink(path.c_str());
+}
+
+// throughput and latency of each flush policy, with a given number of
+// records waiting for their flush at a time.
+TEST(RecorderTest, flush_cost) {
+  const char* names[] = {"none", "fdatasync", "direct"};
+  for (int policy : {Recorder::FLUSH_NONE,
+                     Recorder::FLUSH_FDATASYNC,
+                     Recorder::FLUSH_DIRECT}) {
+    for (int n_outstanding : {1, 16, 256}) {
+      auto path = log_path("cost");
+      unlink(path.c_str());
+      Recorder recorder(path.c_str(), policy);
+      const int n_records = 4000;
+      string record(128, 'r');
+      int n_submitted = 0, n_done = 0;
+      double sum_latency = 0;
+      Timer t;
+      t.start();
+      while (n_done < n_records) {
+        while (n_submitted < n_records
+               && n_submitted - n_done < n_outstanding) {
+          auto start = Time::now();
+          recorder.submit(record, [&n_done, &sum_latency, start] () {
+            sum_latency += Time::now() - start;
+            n_done++;
+          });
+          n_submitted++;
+        }
+        recorder.Work();
+      }
+      t.stop();
+      Log_info("recorder %s, %d outstanding: %.0f records/s, "
+               "%.1f us latency, %lld records per flush",
+               names[policy], n_outstanding, n_records / t.elapsed(),
+               sum_latency / n_records,
+               (long long) recorder.stat_cnt_.avg_);
+      unlink(path.c_str());
+    }
+  }
+}
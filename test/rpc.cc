@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <atomic>
+#include <unistd.h>
+#include "rrr/rrr.hpp"
+
+using namespace std;
+using namespace rrr;
+
+static const i32 RPC_INC = 0x1001;
+// replied only once the test lets it go.
+static const i32 RPC_HOLD = 0x1002;
+
+class FutureTest : public ::testing::Test {
+ protected:
+  PollMgr* svr_poll_ = nullptr;
+  PollMgr* cl_poll_ = nullptr;
+  Server* server_ = nullptr;
+  Client* client_ = nullptr;
+  SpinLock held_l_;
+  vector<pair<Request*, ServerConnection*>> held_;
+
+  void SetUp() override {
+    svr_poll_ = new PollMgr(1);
+    cl_poll_ = new PollMgr(1);
+    server_ = new Server(svr_poll_);
+    server_->reg(RPC_INC, [] (Request* req, ServerConnection* sconn) {
+      i32 v;
+      req->m >> v;
+      sconn->begin_reply(req);
+      *sconn << v + 1;
+      sconn->end_reply();
+      delete req;
+      sconn->release();
+    });
+    server_->reg(RPC_HOLD, [this] (Request* req, ServerConnection* sconn) {
+      held_l_.lock();
+      held_.push_back(make_pair(req, sconn));
+      held_l_.unlock();
+    });
+    auto addr = "127.0.0.1:" + to_string(20000 + getpid() % 20000);
+    ASSERT_EQ(server_->start(addr.c_str()), 0);
+    client_ = new Client(cl_poll_);
+    ASSERT_EQ(client_->connect(addr.c_str()), 0);
+  }
+
+  void TearDown() override {
+    held_l_.lock();
+    for (auto& p : held_) {
+      p.second->begin_reply(p.first);
+      p.second->end_reply();
+      delete p.first;
+      p.second->release();
+    }
+    held_.clear();
+    held_l_.unlock();
+    client_->close_and_release();
+    delete server_;
+    cl_poll_->release();
+    svr_poll_->release();
+  }
+
+  Future* call(i32 rpc_id, i32 v) {
+    Future* fu = client_->begin_request(rpc_id);
+    *client_ << v;
+    client_->end_request();
+    return fu;
+  }
+};
+
+TEST_F(FutureTest, thread_wait) {
+  Future* fu = call(RPC_INC, 41);
+  ASSERT_EQ(fu->get_error_code(), 0);
+  i32 r;
+  fu->get_reply() >> r;
+  ASSERT_EQ(r, 42);
+  fu->release();
+
+  fu = call(RPC_HOLD, 0);
+  fu->timed_wait(0.01);
+  ASSERT_FALSE(fu->ready());
+  ASSERT_EQ(fu->get_error_code(), ETIMEDOUT);
+  fu->release();
+}
+
+// replies are read by the client's poll thread, the coroutines waiting for
+// them run here.
+TEST_F(FutureTest, coroutine_wait) {
+  const int n_coro = 1000;
+  int n_done = 0;
+  for (int i = 0; i < n_coro; i++) {
+    Coroutine::CreateRun([this, i, &n_done] () {
+      Future* fu = call(RPC_INC, i);
+      ASSERT_EQ(fu->get_error_code(), 0);
+      i32 r;
+      fu->get_reply() >> r;
+      ASSERT_EQ(r, i + 1);
+      fu->release();
+      n_done++;
+    });
+  }
+  auto reactor = Reactor::GetReactor();
+  while (n_done < n_coro) {
+    reactor->Loop();
+  }
+
+  bool timed_out = false;
+  Coroutine::CreateRun([this, &timed_out] () {
+    Future* fu = call(RPC_HOLD, 0);
+    fu->timed_wait(0.01);
+    timed_out = fu->get_error_code() == ETIMEDOUT;
+    fu->release();
+  });
+  while (!timed_out) {
+    reactor->Loop();
+  }
+}
+
+TEST_F(FutureTest, recycle) {
+  Future* fu = call(RPC_INC, 0);
+  fu->wait();
+  fu->release();
+  Future* fu2 = call(RPC_INC, 1);
+  ASSERT_EQ(fu2, fu);
+  i32 r;
+  fu2->get_reply() >> r;
+  ASSERT_EQ(r, 2);
+  fu2->release();
+}
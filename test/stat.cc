@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "rrr/rrr.hpp"
+
+using namespace std;
+using namespace rrr;
+
+TEST(HistogramTest, buckets) {
+  int last = -1;
+  for (int64_t v = 0; v < (1 << 20); v++) {
+    int i = Histogram::bucket(v);
+    ASSERT_TRUE(i == last || i == last + 1);
+    last = i;
+    // a bucket is at most 1/64 of its values wide.
+    ASSERT_LE(llabs(Histogram::value(i) - v), max<int64_t>(1, v / 64));
+  }
+  ASSERT_EQ(Histogram::bucket(INT64_MAX), Histogram::n_buckets - 1);
+}
+
+TEST(HistogramTest, percentile) {
+  Histogram h;
+  vector<int64_t> values;
+  for (int i = 0; i < 100000; i++) {
+    // a long tail, as latencies have.
+    int64_t v = 100 + (int64_t) i * i % 1000003;
+    values.push_back(v);
+    h.record(v);
+  }
+  sort(values.begin(), values.end());
+  vector<int64_t> counts(Histogram::n_buckets);
+  int64_t max = h.drain(&counts[0]);
+  ASSERT_EQ(max, values.back());
+  for (double p : {0.5, 0.9, 0.99, 0.999}) {
+    int64_t exact = values[(size_t) (p * values.size()) - 1];
+    int64_t v = Histogram::percentile(counts, max, p);
+    ASSERT_LE(llabs(v - exact), exact / 64 + 1);
+  }
+  ASSERT_EQ(Histogram::percentile(counts, max, 1), max);
+
+  // drained, the next drain only sees what comes after.
+  h.record(7);
+  vector<int64_t> counts2(Histogram::n_buckets);
+  ASSERT_EQ(h.drain(&counts2[0]), 7);
+  ASSERT_EQ(counts2[Histogram::bucket(7)], 1);
+}
+
+// nothing is lost when a reader drains while others record.
+TEST(HistogramTest, concurrent_drain) {
+  Histogram h;
+  const int n_threads = 4, n_records = 200000;
+  vector<thread> threads;
+  for (int t = 0; t < n_threads; t++) {
+    threads.emplace_back([&h, t] () {
+      for (int i = 0; i < n_records; i++) {
+        h.record(i % 5000 + t);
+      }
+    });
+  }
+  vector<int64_t> counts(Histogram::n_buckets);
+  for (int i = 0; i < 100; i++) {
+    h.drain(&counts[0]);
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  h.drain(&counts[0]);
+  int64_t n = 0;
+  for (auto c : counts) {
+    n += c;
+  }
+  ASSERT_EQ(n, (int64_t) n_threads * n_records);
+}
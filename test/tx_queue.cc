@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <list>
+#include <memory>
+#include <vector>
+#include "rrr/rrr.hpp"
+#include "deptran/februus/tx_queue.h"
+
+using namespace std;
+using namespace rrr;
+using namespace janus;
+
+struct QueuedTx {
+  uint64_t tid_;
+  uint64_t timestamp_;
+  bool committed_;
+};
+
+TEST(TxQueueTest, order) {
+  TxQueue<QueuedTx*> q;
+  QueuedTx a{3, 10, false}, b{1, 10, false}, c{2, 5, false};
+  q.Update(a.tid_, a.timestamp_, &a);
+  q.Update(b.tid_, b.timestamp_, &b);
+  q.Update(c.tid_, c.timestamp_, &c);
+  ASSERT_EQ(q.Size(), 3);
+  // equal timestamps go by txn id
+  vector<uint64_t> ids;
+  for (auto& pair : q) {
+    ids.push_back(pair.second->tid_);
+  }
+  ASSERT_EQ(ids, vector<uint64_t>({2, 1, 3}));
+  c.timestamp_ = 20;
+  q.Update(c.tid_, c.timestamp_, &c);
+  ASSERT_EQ(q.Size(), 3);
+  ASSERT_EQ(q.Front(), &b);
+  ASSERT_TRUE(q.Erase(1));
+  ASSERT_FALSE(q.Erase(1));
+  ASSERT_EQ(q.Front(), &a);
+  q.PopFront();
+  ASSERT_EQ(q.Front(), &c);
+  q.PopFront();
+  ASSERT_TRUE(q.Empty());
+  q.Update(c.tid_, c.timestamp_, &c);
+  ASSERT_EQ(q.Size(), 1);
+}
+
+// n_inflight txns go through pre-accept, accept and commit, each moving
+// them in the queue, against the list the scheduler used to walk.
+TEST(TxQueueTest, inflight_cost) {
+  const int n_inflight = 10000;
+  vector<QueuedTx> txs(n_inflight);
+  for (int indexed : {0, 1}) {
+    list<QueuedTx*> lst;
+    TxQueue<QueuedTx*> q;
+    auto update = [&] (QueuedTx& tx) {
+      if (indexed) {
+        q.Update(tx.tid_, tx.timestamp_, &tx);
+        while (!q.Empty() && q.Front()->committed_) {
+          q.PopFront();
+        }
+        return;
+      }
+      for (auto it = lst.begin(); it != lst.end(); it++) {
+        if ((*it)->tid_ == tx.tid_) {
+          lst.erase(it);
+          break;
+        }
+      }
+      auto it = lst.begin();
+      while (it != lst.end() && (*it)->timestamp_ <= tx.timestamp_) {
+        it++;
+      }
+      lst.insert(it, &tx);
+      while (!lst.empty() && lst.front()->committed_) {
+        lst.pop_front();
+      }
+    };
+    for (int i = 0; i < n_inflight; i++) {
+      txs[i] = QueuedTx{(uint64_t) i, (uint64_t) (i * 7919) % n_inflight, false};
+    }
+    Timer t;
+    t.start();
+    for (auto& tx : txs) {
+      update(tx);
+    }
+    for (auto& tx : txs) {
+      tx.timestamp_ += n_inflight;
+      update(tx);
+    }
+    for (auto& tx : txs) {
+      tx.committed_ = true;
+      update(tx);
+    }
+    t.stop();
+    ASSERT_TRUE(indexed ? q.Empty() : lst.empty());
+    Log_info("februus queue %s: %d in flight, %.0f updates/s",
+             indexed ? "indexed" : "list", n_inflight,
+             3.0 * n_inflight / t.elapsed());
+  }
+}
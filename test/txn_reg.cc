@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include "rrr/rrr.hpp"
+#include "deptran/txn_reg.h"
+
+using namespace std;
+using namespace rrr;
+using namespace janus;
+
+// shaped like tpcc: a few txn types, pieces numbered from different bases
+// with loops of per-item pieces far from the first ones.
+static void fill(TxnRegistry& reg, vector<pair<txntype_t, innid_t>>& ids) {
+  for (txntype_t t = 10; t <= 50; t += 10) {
+    innid_t base = t * 100;
+    for (innid_t p = base; p < base + 5; p++) {
+      ids.push_back(make_pair(t, p));
+    }
+    for (innid_t p = base + 5000; p < base + 5015; p++) {
+      ids.push_back(make_pair(t, p));
+    }
+  }
+  for (auto& id : ids) {
+    auto& def = reg.regs_[id.first][id.second];
+    def.input_vars_ = {3, 1, 2, 1};
+    def.output_vars_ = {(int32_t) id.second};
+  }
+}
+
+TEST(TxnRegistryTest, freeze) {
+  TxnRegistry reg;
+  vector<pair<txntype_t, innid_t>> ids;
+  fill(reg, ids);
+  vector<TxnPieceDef*> defs;
+  for (auto& id : ids) {
+    defs.push_back(&reg.get(id.first, id.second));
+  }
+  reg.Freeze();
+  ASSERT_TRUE(reg.frozen());
+  for (size_t i = 0; i < ids.size(); i++) {
+    auto& def = reg.get(ids[i].first, ids[i].second);
+    ASSERT_EQ(&def, defs[i]);
+    ASSERT_EQ(def.input_vars_, vector<int32_t>({1, 2, 3}));
+    ASSERT_EQ(def.output_vars_, vector<int32_t>({(int32_t) ids[i].second}));
+  }
+  // lookups never add pieces.
+  ASSERT_EQ(reg.regs_.size(), 5);
+}
+
+// dispatch lookups per second, through the nested maps and once frozen.
+TEST(TxnRegistryTest, lookup_cost) {
+  TxnRegistry reg;
+  vector<pair<txntype_t, innid_t>> ids;
+  fill(reg, ids);
+  // visit pieces in a scattered order, as interleaved txns dispatch them.
+  vector<pair<txntype_t, innid_t>> order;
+  for (size_t i = 0; i < ids.size(); i++) {
+    order.push_back(ids[(i * 37) % ids.size()]);
+  }
+  const int n_rounds = 20000;
+  for (int frozen : {0, 1}) {
+    if (frozen) {
+      reg.Freeze();
+    }
+    uint64_t sum = 0;
+    Timer t;
+    t.start();
+    for (int r = 0; r < n_rounds; r++) {
+      for (auto& id : order) {
+        sum += reg.get(id.first, id.second).output_vars_[0];
+      }
+    }
+    t.stop();
+    uint64_t n = (uint64_t) n_rounds * order.size();
+    ASSERT_GT(sum, 0);
+    Log_info("txn registry %s: %.0f lookups/s",
+             frozen ? "frozen" : "map", n / t.elapsed());
+  }
+}
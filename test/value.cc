@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include "rrr/rrr.hpp"
+#include "memdb/value.h"
+
+using namespace std;
+using namespace rrr;
+using mdb::Value;
+
+// every heap allocation of the test binary, so the churn below can tell
+// how many a workload costs.
+static std::atomic<uint64_t> n_allocs{0};
+
+void* operator new(size_t n) {
+  n_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* p = malloc(n == 0 ? 1 : n);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+TEST(ValueTest, copy_move) {
+  string long_str(100, 'x');
+  Value s(long_str), t("short");
+  Value s2(s);
+  ASSERT_EQ(s2.get_str(), long_str);
+  ASSERT_EQ(s, s2);
+  Value s3(std::move(s2));
+  ASSERT_EQ(s3.get_str(), long_str);
+  ASSERT_EQ(s2.get_kind(), Value::UNKNOWN);
+  s3 = t;
+  ASSERT_EQ(s3.get_str(), "short");
+  s3 = Value((mdb::i64) 7);
+  ASSERT_EQ(s3.get_i64(), 7);
+  s3 = std::move(s);
+  ASSERT_EQ(s3.get_str(), long_str);
+  ASSERT_LT(t, s3);
+
+  vector<Value> vs;
+  for (int i = 0; i < 100; i++) {
+    vs.push_back(Value(to_string(i) + long_str));
+    vs.push_back(Value(i));
+  }
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(vs[2 * i].get_str(), to_string(i) + long_str);
+    ASSERT_EQ(vs[2 * i + 1].get_i32(), i);
+  }
+}
+
+TEST(ValueTest, borrow) {
+  string buf = "borrowed bytes that are long enough for the heap";
+  mdb::blob b;
+  b.data = buf.data();
+  b.len = buf.size();
+  uint64_t before = n_allocs;
+  Value v = Value::borrow(b);
+  Value moved(std::move(v));
+  ASSERT_EQ(n_allocs, before);
+  ASSERT_TRUE(moved.is_borrowed());
+  ASSERT_EQ(moved.get_blob().data, buf.data());
+  ASSERT_EQ(moved, Value(buf));
+
+  // a copy owns its bytes.
+  Value copy(moved);
+  ASSERT_FALSE(copy.is_borrowed());
+  buf[0] = 'B';
+  ASSERT_EQ(copy.get_str()[0], 'b');
+  ASSERT_EQ(moved.get_blob().data[0], 'B');
+}
+
+// a new-order sized workspace passed through the hands of a piece: inputs
+// copied into the piece, outputs produced, moved back into the workspace.
+TEST(ValueTest, churn) {
+  const int n_items = 15, n_txns = 2000;
+  string i_name(24, 'n'), s_dist(24, 'd'), s_data(40, 's');
+  uint64_t allocs_before = n_allocs;
+  Timer t;
+  t.start();
+  for (int n = 0; n < n_txns; n++) {
+    map<int32_t, Value> ws;
+    ws[0] = Value((mdb::i32) n);
+    ws[1] = Value((mdb::i32) 1);
+    ws[2] = Value("BC");
+    ws[3] = Value("OUGHTPRICALLY");
+    for (int i = 0; i < n_items; i++) {
+      ws[100 + i] = Value((mdb::i32) i);
+      ws[200 + i] = Value((mdb::i32) 5);
+    }
+    for (int i = 0; i < n_items; i++) {
+      map<int32_t, Value> input(ws);
+      map<int32_t, Value> output;
+      output[300 + i] = Value(i_name);
+      output[400 + i] = Value(1.5);
+      output[500 + i] = Value(s_dist);
+      output[600 + i] = Value(s_data);
+      for (auto& pair : output) {
+        ws[pair.first] = std::move(pair.second);
+      }
+    }
+    ASSERT_EQ(ws.size(), 4 + 6 * n_items);
+  }
+  t.stop();
+  Log_info("value churn: %.0f txns/s, %.1f allocations per txn",
+           n_txns / t.elapsed(),
+           (double) (n_allocs - allocs_before) / n_txns);
+}
@@ -16,6 +16,7 @@ modes_ = [
     "occ",
     "tpl_ww_paxos",
     "occ_paxos",
+    "occ_paxos_pipeline",
     "tapir",
     "rococo",
     "janus",